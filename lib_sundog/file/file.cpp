@@ -789,6 +789,11 @@ sfs_file sfs_open( sundog_engine* sd, const char* filename, const char* filemode
 	if( fd->type == SFS_FILE_NORMAL )
 	{
 	    //Not the archive. Normal file:
+	    if( filemode[ 0 ] != 'r' || smem_strchr( filemode, '+' ) )
+	    {
+		//The file will be changed: the blocks mapped from it must not see it
+		smem_unshare_file( fd->filename );
+	    }
 #if defined(OS_UNIX)
 	    fd->f = (void*)fopen( fd->filename, filemode );
 #ifdef OS_UNIX
@@ -982,10 +987,11 @@ size_t sfs_read( void* ptr, size_t el_size, size_t elements, sfs_file f )
 	    if( g_sfs_fd[ f ]->virt_file_data )
 	    {
 		size_t size = el_size * elements;
-		if( g_sfs_fd[ f ]->virt_file_ptr + size > g_sfs_fd[ f ]->virt_file_size )
+		if( g_sfs_fd[ f ]->virt_file_ptr >= g_sfs_fd[ f ]->virt_file_size )
+		    size = 0;
+		else if( size > g_sfs_fd[ f ]->virt_file_size - g_sfs_fd[ f ]->virt_file_ptr )
 		    size = g_sfs_fd[ f ]->virt_file_size - g_sfs_fd[ f ]->virt_file_ptr;
-		if( (signed)size < 0 ) size = 0;
-		if( (signed)size > 0 )
+		if( size > 0 )
 		    smem_copy( ptr, g_sfs_fd[ f ]->virt_file_data + g_sfs_fd[ f ]->virt_file_ptr, size );
 		g_sfs_fd[ f ]->virt_file_ptr += size;
 		retval = size / el_size;
@@ -995,6 +1001,29 @@ size_t sfs_read( void* ptr, size_t el_size, size_t elements, sfs_file f )
     return retval;
 }
 
+void* sfs_map_block( size_t size, sfs_file f )
+{
+    void* rv = NULL;
+#ifdef SMEM_MAP_SUPPORTED
+    f--;
+    if( (unsigned)f < SFS_MAX_DESCRIPTORS && g_sfs_fd[ f ] )
+    {
+	if( g_sfs_fd[ f ]->f && g_sfs_fd[ f ]->type == SFS_FILE_NORMAL )
+	{
+	    //Standard file:
+	    FILE* sf = (FILE*)g_sfs_fd[ f ]->f;
+	    int64_t offset = ftello( sf );
+	    if( offset >= 0 )
+	    {
+		rv = SMEM_MAP_FILE( fileno( sf ), offset, size );
+		if( rv ) fseeko( sf, offset + size, SEEK_SET );
+	    }
+	}
+    }
+#endif
+    return rv;
+}
+
 size_t sfs_write( const void* ptr, size_t el_size, size_t elements, sfs_file f )
 {
     size_t retval = 0;
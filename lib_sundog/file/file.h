@@ -155,6 +155,7 @@ int sfs_eof( sfs_file f );
 int sfs_flush( sfs_file f );
 size_t sfs_read( void* ptr, size_t el_size, size_t elements, sfs_file f ); //Return value: total number of elements (NOT bytes!) successfully read
 size_t sfs_write( const void* ptr, size_t el_size, size_t elements, sfs_file f ); //Return value: total number of elements (NOT bytes!) successfully written
+void* sfs_map_block( size_t size, sfs_file f ); //Map the next "size" bytes of the normal file as the copy-on-write smem block (smem_map_file()) and skip them; NULL - not possible (use sfs_read())
 int sfs_write_varlen_uint32( uint32_t v, sfs_file f ); //Return value: positive length of the written number; in case of error: 0 or negative parial number of bytes written
 uint32_t sfs_read_varlen_uint32( int* len, sfs_file f ); //len (optional) - number of bytes successfully read or 0 in case of error
 int sfs_putc( int val, sfs_file f );
@@ -165,6 +165,70 @@ void sundog_denormal_numbers_check()
     if( g_denormal_numbers >= 0 ) sundog_denormal_numbers( g_denormal_numbers == 1 );
 }
 
+uint64_t sundog_denormal_numbers_push()
+{
+    uint64_t rv = 0;
+    if( g_denormal_numbers == 1 ) return rv;
+#ifdef __SSE__
+    uint32_t csr = _mm_getcsr();
+    rv = csr;
+    csr |= 0x8040; //FTZ + DAZ
+    if( csr != rv ) _mm_setcsr( csr );
+#endif
+#ifdef ARM_VFP
+    #ifdef ARCH_ARM64
+        uint64_t cr = 0;
+        asm volatile( "mrs %[dest], FPCR" : [dest] "=r" (cr) );
+    #else
+        uint32_t cr = 0;
+        #if __GNUC__ <= 4
+            asm volatile( "fmrx %[dest], FPSCR" : [dest] "=r" (cr) );
+        #else
+            asm volatile( "vmrs %[dest], FPSCR" : [dest] "=r" (cr) );
+        #endif
+    #endif
+    rv = cr;
+    if( ( cr & ( 1 << 24 ) ) == 0 )
+    {
+	cr |= ( 1 << 24 ); //enable flush-to-zero
+	#ifdef ARCH_ARM64
+	    asm volatile( "msr FPCR, %[src]" : : [src] "r" (cr) );
+	#else
+	    #if __GNUC__ <= 4
+		asm volatile( "fmxr FPSCR, %[src]" : : [src] "r" (cr) );
+	    #else
+		asm volatile( "vmsr FPSCR, %[src]" : : [src] "r" (cr) );
+	    #endif
+	#endif
+    }
+#endif
+    return rv;
+}
+
+void sundog_denormal_numbers_pop( uint64_t prev )
+{
+    if( g_denormal_numbers == 1 ) return;
+#ifdef __SSE__
+    if( _mm_getcsr() != (uint32_t)prev ) _mm_setcsr( (uint32_t)prev );
+#endif
+#ifdef ARM_VFP
+    if( ( prev & ( 1 << 24 ) ) == 0 )
+    {
+	#ifdef ARCH_ARM64
+	    uint64_t cr = prev;
+	    asm volatile( "msr FPCR, %[src]" : : [src] "r" (cr) );
+	#else
+	    uint32_t cr = (uint32_t)prev;
+	    #if __GNUC__ <= 4
+		asm volatile( "fmxr FPSCR, %[src]" : : [src] "r" (cr) );
+	    #else
+		asm volatile( "vmsr FPSCR, %[src]" : : [src] "r" (cr) );
+	    #endif
+	#endif
+    }
+#endif
+}
+
 #ifdef OS_WIN
 int g_timer_period = 0;
 #endif
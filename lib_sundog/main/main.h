@@ -79,6 +79,8 @@ extern volatile bool g_sdl_initialized;
 struct sundog_engine;
 
 void sundog_denormal_numbers_check();
+uint64_t sundog_denormal_numbers_push(); //FTZ/DAZ for the current thread (until pop); retval = previous FP control register
+void sundog_denormal_numbers_pop( uint64_t prev );
 int sundog_global_init();
 int sundog_global_deinit();
 int sundog_main( sundog_engine* sd, bool global_init );
@@ -14,6 +14,12 @@
 
 #include "sundog.h"
 
+#ifdef SMEM_MAP_SUPPORTED
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
 #ifdef VULKAN
     //for GPU memory usage:
     #include "vulkan/sd_vulkan.h"
@@ -26,6 +32,50 @@ size_t g_smem_max_size = 0;
 smutex g_smem_mutex;
 size_t g_smem_error = 0;
 
+#ifdef SMEM_MAP_SUPPORTED
+//Blocks created by smem_map_file():
+//[anonymous page (only if the header doesn't fit into the first file page)][file pages: ... smem_block, data ...]
+struct smem_map
+{
+    void*		ptr; //block data
+    int8_t*		map;
+    size_t		map_size;
+    dev_t		dev;
+    ino_t		ino; //0 - replaced by the anonymous copy (smem_unshare_file())
+};
+static smem_map* g_smem_maps = NULL; //malloc()
+static size_t g_smem_maps_num = 0;
+static size_t g_smem_maps_max = 0;
+
+//Remove the mapped block from the list (g_smem_mutex must be locked); retval: true if found
+static bool smem_map_remove( void* ptr, smem_map* rv )
+{
+    for( size_t i = 0; i < g_smem_maps_num; i++ )
+    {
+	if( g_smem_maps[ i ].ptr == ptr )
+	{
+	    *rv = g_smem_maps[ i ];
+	    g_smem_maps_num--;
+	    g_smem_maps[ i ] = g_smem_maps[ g_smem_maps_num ];
+	    return true;
+	}
+    }
+    return false;
+}
+
+static bool smem_is_mapped( void* ptr )
+{
+    bool rv = false;
+    smutex_lock( &g_smem_mutex );
+    for( size_t i = 0; i < g_smem_maps_num; i++ )
+    {
+	if( g_smem_maps[ i ].ptr == ptr ) { rv = true; break; }
+    }
+    smutex_unlock( &g_smem_mutex );
+    return rv;
+}
+#endif
+
 static void free_all()
 {
 #ifndef SMEM_FAST_MODE
@@ -99,6 +149,17 @@ int smem_global_deinit()
     smutex_destroy( &g_smem_mutex );
 #endif
     free_all();
+#ifdef SMEM_MAP_SUPPORTED
+    if( g_smem_maps_num )
+    {
+	slog( "Leaked file mappings: " PRINTF_SIZET "\n", PRINTF_SIZET_CONV g_smem_maps_num );
+	for( size_t i = 0; i < g_smem_maps_num; i++ ) munmap( g_smem_maps[ i ].map, g_smem_maps[ i ].map_size );
+    }
+    free( g_smem_maps );
+    g_smem_maps = NULL;
+    g_smem_maps_num = 0;
+    g_smem_maps_max = 0;
+#endif
     return 0;
 }
 
@@ -187,6 +248,16 @@ void smem_free( void* ptr )
     smutex_lock( &g_smem_mutex );
 #endif
 
+#ifdef SMEM_MAP_SUPPORTED
+    smem_map mm;
+    if( g_smem_maps_num && smem_map_remove( ptr, &mm ) )
+    {
+	smutex_unlock( &g_smem_mutex );
+	munmap( mm.map, mm.map_size );
+	return;
+    }
+#endif
+
     g_smem_size -= m->size + sizeof( smem_block );
 
 #ifndef SMEM_FAST_MODE
@@ -226,6 +297,22 @@ void* smem_get_stdc_ptr( void* ptr, size_t* data_offset )
 {
     if( !ptr ) return NULL;
 
+#ifdef SMEM_MAP_SUPPORTED
+    if( smem_is_mapped( ptr ) )
+    {
+	size_t size = smem_get_size( ptr );
+	smem_block* m2 = (smem_block*)malloc( size + sizeof( smem_block ) );
+	if( m2 )
+	{
+	    m2->size = size;
+	    smem_copy( (int8_t*)m2 + sizeof( smem_block ), ptr, size );
+	    if( data_offset ) *data_offset = sizeof( smem_block );
+	}
+	smem_free( ptr );
+	return m2;
+    }
+#endif
+
     smem_block* m = (smem_block*)( (int8_t*)ptr - sizeof( smem_block ) );
 
 #ifndef SMEM_FAST_MODE
@@ -275,6 +362,20 @@ void* smem_resize( void* ptr, size_t new_size  SMEM_NAME_PARS )
 
     void* new_ptr = NULL;
 
+#ifdef SMEM_MAP_SUPPORTED
+    if( smem_is_mapped( ptr ) )
+    {
+	//Mapped block: move it to the heap
+	new_ptr = smem_alloc( new_size  SMEM_NAME_ARGS );
+	if( new_ptr )
+	{
+	    smem_copy( new_ptr, ptr, old_size < new_size ? old_size : new_size );
+	    smem_free( ptr );
+	}
+	return new_ptr;
+    }
+#endif
+
     //realloc():
 #ifdef SMEM_FAST_MODE
     smem_block* m = (smem_block*)( (int8_t*)ptr - sizeof( smem_block ) );
@@ -318,6 +419,98 @@ void* smem_resize( void* ptr, size_t new_size  SMEM_NAME_PARS )
     return new_ptr;
 }
 
+void* smem_map_file( int fd, int64_t offset, size_t size  SMEM_NAME_PARS )
+{
+#ifdef SMEM_MAP_SUPPORTED
+    if( size == 0 || offset < 0 || ( offset & 7 ) ) return NULL;
+    struct stat st;
+    if( fstat( fd, &st ) != 0 || !S_ISREG( st.st_mode ) || offset + (int64_t)size > (int64_t)st.st_size ) return NULL;
+    size_t page = (size_t)sysconf( _SC_PAGESIZE );
+    size_t page_offset = (size_t)( offset % page );
+    size_t head = 0; //anonymous pages for the block header
+    if( page_offset < sizeof( smem_block ) ) head = page;
+    size_t file_size = ( page_offset + size + page - 1 ) / page * page;
+    int8_t* map = (int8_t*)mmap( NULL, head + file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if( map == (int8_t*)MAP_FAILED ) return NULL;
+    if( mmap( map + head, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, offset - page_offset ) == MAP_FAILED )
+    {
+	munmap( map, head + file_size );
+	return NULL;
+    }
+    int8_t* ptr = map + head + page_offset;
+    smem_block* m = (smem_block*)( ptr - sizeof( smem_block ) ); //private copy of one page is created here
+    m->size = size;
+#ifdef SMEM_USE_NAMES
+    m->name = name;
+    m->line = line;
+#endif
+    m->prev = NULL;
+    m->next = NULL;
+    smutex_lock( &g_smem_mutex );
+    if( g_smem_maps_num >= g_smem_maps_max )
+    {
+	size_t new_max = g_smem_maps_max + 64;
+	smem_map* new_maps = (smem_map*)realloc( g_smem_maps, new_max * sizeof( smem_map ) );
+	if( !new_maps )
+	{
+	    smutex_unlock( &g_smem_mutex );
+	    munmap( map, head + file_size );
+	    return NULL;
+	}
+	g_smem_maps = new_maps;
+	g_smem_maps_max = new_max;
+    }
+    smem_map* mm = &g_smem_maps[ g_smem_maps_num++ ];
+    mm->ptr = ptr;
+    mm->map = map;
+    mm->map_size = head + file_size;
+    mm->dev = st.st_dev;
+    mm->ino = st.st_ino;
+    smutex_unlock( &g_smem_mutex );
+    return ptr;
+#else
+    return NULL;
+#endif
+}
+
+void smem_unshare_file( const char* filename )
+{
+#ifdef SMEM_MAP_SUPPORTED
+    if( g_smem_maps_num == 0 || !filename ) return;
+    struct stat st;
+    if( stat( filename, &st ) != 0 ) return;
+    smutex_lock( &g_smem_mutex );
+    for( size_t i = 0; i < g_smem_maps_num; i++ )
+    {
+	smem_map* mm = &g_smem_maps[ i ];
+	if( mm->ino == 0 || mm->ino != st.st_ino || mm->dev != st.st_dev ) continue;
+	//Truncation of the file discards even the private (already written) pages of the mapping,
+	//so the whole mapping is replaced by the anonymous copy (at the same address):
+	int8_t* copy = (int8_t*)mmap( NULL, mm->map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+	if( copy == (int8_t*)MAP_FAILED ) continue;
+	memcpy( copy, mm->map, mm->map_size );
+#ifdef MREMAP_FIXED
+	//Atomic replacement: the block can be read by the audio thread at this moment
+	if( mremap( copy, mm->map_size, mm->map_size, MREMAP_MAYMOVE | MREMAP_FIXED, mm->map ) == MAP_FAILED )
+	{
+	    munmap( copy, mm->map_size );
+	    continue;
+	}
+#else
+	if( mmap( mm->map, mm->map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED | MAP_ANONYMOUS, -1, 0 ) == MAP_FAILED )
+	{
+	    munmap( copy, mm->map_size );
+	    continue;
+	}
+	memcpy( mm->map, copy, mm->map_size );
+	munmap( copy, mm->map_size );
+#endif
+	mm->ino = 0;
+    }
+    smutex_unlock( &g_smem_mutex );
+#endif
+}
+
 void* smem_zresize( void* ptr, size_t new_size  SMEM_NAME_PARS ) //With zero padding
 {
     if( !ptr ) return smem_zalloc( new_size  SMEM_NAME_ARGS );
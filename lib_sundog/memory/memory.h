@@ -9,6 +9,10 @@
 #if !defined(SIZE_MAX)
     #error SIZE_MAX is not defined!
 #endif
+#if defined(OS_UNIX) && !defined(OS_EMSCRIPTEN) && !defined(SMEM_FAST_MODE)
+    #define SMEM_MAP_SUPPORTED //smem_map_file() can create the copy-on-write file mappings
+#endif
+#define SMEM_MAP_MIN_SIZE	( 64 * 1024 ) //smaller blocks should be just read: the mapping costs more than the copy
 #ifdef SMEM_USE_NAMES
     #define SMEM_NAME_PARS	, const char* name, int line
     #define SMEM_NAME_ARGS 	, name, line
@@ -94,6 +98,12 @@ inline void* smem_zalloc( size_t size  SMEM_NAME_PARS ) //Create a block filled
 #define SMEM_ZALLOC2( ELEMENT_TYPE, NUM_ELEMENTS ) (ELEMENT_TYPE*)smem_zalloc( (NUM_ELEMENTS)*sizeof(ELEMENT_TYPE)  SMEM_CUR_FN_NAME )
 void smem_free( void* ptr );
 void* smem_get_stdc_ptr( void* ptr, size_t* data_offset ); //Remove ptr from the SunDog memory manager and convert it to stdc (malloc) pointer
+//Copy-on-write mapping of the file fragment (private; data offset must be a multiple of 8); retval = NULL if not possible (use the normal read):
+//the block references the file pages until the first write to them; smem_free() and smem_resize() work as usual;
+//the file must not be truncated while mapped (sfs_open() for writing calls smem_unshare_file() to copy the pages first);
+void* smem_map_file( int fd, int64_t offset, size_t size  SMEM_NAME_PARS );
+#define SMEM_MAP_FILE( FD, OFFSET, SIZE ) smem_map_file( FD, OFFSET, SIZE  SMEM_CUR_FN_NAME )
+void smem_unshare_file( const char* filename ); //Make private copies of all pages mapped from this file
 inline void smem_zero( void* ptr ) { if( !ptr ) return; memset( ptr, 0, smem_get_size( ptr ) ); }
 void* smem_resize( void* ptr, size_t size  SMEM_NAME_PARS );
 void* smem_zresize( void* ptr, size_t size  SMEM_NAME_PARS ); //With zero padding
@@ -138,17 +138,17 @@ int user_controlled_sound_callback(
     return sundog_sound_callback( ss, 0 );
 }
 
-int sundog_sound_callback( sundog_sound* ss, uint32_t flags )
+#ifndef NOSOUND
+
+//Slot mixer: render out_frames to out_buffer:
+static int sundog_sound_render( sundog_sound* ss, void* out_buffer, int out_frames, stime_ticks_t out_time, void* in_buffer, uint32_t flags )
 {
-#ifdef NOSOUND
-    return 0;
-#else
     bool not_filled = true;
     bool silence = true;
+    uint64_t fp_state = sundog_denormal_numbers_push();
 
     int frame_size = g_sample_size[ ss->out_type ] * ss->out_channels;
     int in_frame_size = 0;
-    void* in_buffer = NULL;
     uint32_t rendered_slots = 0;
 
     if( ( flags & SUNDOG_SOUND_CALLBACK_FLAG_DONT_LOCK ) == 0 )
@@ -156,11 +156,8 @@ int sundog_sound_callback( sundog_sound* ss, uint32_t flags )
 	if( smutex_lock( &ss->mutex ) ) goto mutex_end;
     }
 
-    if( ss->in_enabled && ss->in_buffer )
-    {
+    if( in_buffer )
 	in_frame_size = g_sample_size[ ss->in_type ] * ss->in_channels;
-	in_buffer = ss->in_buffer;
-    }
 
     for( int a = 0; a < 2; a++ )
     {
@@ -174,12 +171,12 @@ int sundog_sound_callback( sundog_sound* ss, uint32_t flags )
 	    {
 		if( ss->slot_sync == 0 ) continue;
 		slot->out_buf_ptr = ss->slot_sync - 1;
-		//printf( "SLOT %d SYNC %d / %d\n", slot_num, slot->out_buf_ptr, ss->out_frames );
-		if( slot->out_buf_ptr < 0 || slot->out_buf_ptr >= ss->out_frames ) continue;
+		//printf( "SLOT %d SYNC %d / %d\n", slot_num, slot->out_buf_ptr, out_frames );
+		if( slot->out_buf_ptr < 0 || slot->out_buf_ptr >= out_frames ) continue;
 		slot->wait_for_sync = 0;
 		if( not_filled )
 		{
-		    smem_clear( ss->out_buffer, ss->out_frames * frame_size );
+		    smem_clear( out_buffer, out_frames * frame_size );
 		    not_filled = false;
 		}
 	    }
@@ -187,9 +184,9 @@ int sundog_sound_callback( sundog_sound* ss, uint32_t flags )
 	    if( not_filled )
 	    {
 		slot->in_buffer = in_buffer;
-		slot->buffer = ss->out_buffer;
-		slot->frames = ss->out_frames;
-		slot->time = ss->out_time;
+		slot->buffer = out_buffer;
+		slot->frames = out_frames;
+		slot->time = out_time;
 		int r = callback( ss, slot_num );
 		// r == 0 : silence, buffer is not filled;
 		// r == 1 : buffer is filled;
@@ -202,13 +199,13 @@ int sundog_sound_callback( sundog_sound* ss, uint32_t flags )
 		slot->buffer = ss->slot_buffer;
 	        while( 1 )
 	        {
-	            int size = ss->out_frames - slot->out_buf_ptr;
+	            int size = out_frames - slot->out_buf_ptr;
 	            if( size > ss->slot_buffer_size )
 	    		size = ss->slot_buffer_size;
 	    	    if( in_buffer )
 			slot->in_buffer = (int8_t*)in_buffer + slot->out_buf_ptr * in_frame_size;
 		    slot->frames = size;
-	    	    slot->time = ss->out_time;
+	    	    slot->time = out_time;
 		    if( slot->out_buf_ptr )
 		        slot->time += (int64_t)slot->out_buf_ptr * stime_ticks_per_second() / ss->freq;
 	    	    int r = callback( ss, slot_num );
@@ -220,7 +217,7 @@ int sundog_sound_callback( sundog_sound* ss, uint32_t flags )
 	    		int dest_offset = slot->out_buf_ptr * ss->out_channels;
 		        if( ss->out_type == sound_buffer_int16 )
 	    		{
-	    	    	    int16_t* dest = (int16_t*)ss->out_buffer + dest_offset;
+	    	    	    int16_t* dest = (int16_t*)out_buffer + dest_offset;
 	    	    	    int16_t* src = (int16_t*)ss->slot_buffer;
 		            for( int i = 0; i < size2; i++ )
 			    {
@@ -231,7 +228,7 @@ int sundog_sound_callback( sundog_sound* ss, uint32_t flags )
 			}
 	    		if( ss->out_type == sound_buffer_float32 )
 			{
-	    		    float* dest = (float*)ss->out_buffer + dest_offset;
+	    		    float* dest = (float*)out_buffer + dest_offset;
 			    float* src = (float*)ss->slot_buffer;
 			    for( int i = 0; i < size2; i++ )
 	    	    	    {
@@ -240,14 +237,14 @@ int sundog_sound_callback( sundog_sound* ss, uint32_t flags )
     			}
 		    }
 	    	    slot->out_buf_ptr += size;
-    		    if( slot->out_buf_ptr >= ss->out_frames )
+    		    if( slot->out_buf_ptr >= out_frames )
 			break;
 		}
 	    }
 	    rendered_slots |= slot_bit;
 	}
 	if( ss->slot_sync == 0 ) break;
-        if( ss->slot_sync - 1 >= ss->out_frames ) break;
+        if( ss->slot_sync - 1 >= out_frames ) break;
 	for( int slot_num = 0; slot_num < SUNDOG_SOUND_SLOTS; slot_num++ )
 	{
 	    sundog_sound_slot* slot = &ss->slots[ slot_num ];
@@ -255,12 +252,12 @@ int sundog_sound_callback( sundog_sound* ss, uint32_t flags )
 		sundog_sound_play( ss, slot_num );
 	}
     }
-    ss->slot_sync -= ss->out_frames;
+    ss->slot_sync -= out_frames;
     if( ss->slot_sync < 0 ) ss->slot_sync = 0;
 
     if( ss->out_file )
     {
-	uint8_t* src = (uint8_t*)ss->out_buffer;
+	uint8_t* src = (uint8_t*)out_buffer;
 	bool from_input = false;
         if( in_buffer && ( ss->out_file_flags & SCAP_FLAG_INPUT ) != 0 )
         {
@@ -268,7 +265,7 @@ int sundog_sound_callback( sundog_sound* ss, uint32_t flags )
     	    from_input = true;
 	    frame_size = in_frame_size;
         }
-	size_t size = ss->out_frames * frame_size;
+	size_t size = out_frames * frame_size;
 	size_t buf_size = smem_get_size( ss->out_file_buf );
 	size_t src_ptr = 0;
 	while( size )
@@ -299,7 +296,7 @@ mutex_end:
 
     if( not_filled )
     {
-	smem_clear( ss->out_buffer, ss->out_frames * frame_size );
+	smem_clear( out_buffer, out_frames * frame_size );
     }
 
     if( silence )
@@ -313,9 +310,10 @@ mutex_end:
 #endif
 	    )
         {
-    	    ss->sd->ss_idle_frame_counter += ss->out_frames;
+    	    ss->sd->ss_idle_frame_counter += out_frames;
 	}
 #endif
+	sundog_denormal_numbers_pop( fp_state );
 	return 0;
     }
     else
@@ -324,8 +322,123 @@ mutex_end:
 	if( ss->sd && ss == ss->sd->ss )
 	    ss->sd->ss_idle_frame_counter = 0;
 #endif
+	sundog_denormal_numbers_pop( fp_state );
 	return 1;
     }
+}
+
+//Render-ahead mode: copy the frames (rendered by sundog_sound_ra_thread) to the device buffer:
+static int sundog_sound_ra_read( sundog_sound* ss )
+{
+    int frame_size = g_sample_size[ ss->out_type ] * ss->out_channels;
+    size_t size = ss->out_frames * frame_size;
+    size_t avail = sring_buf_avail( ss->ra_buf );
+    if( avail > size ) avail = size;
+    if( avail )
+    {
+	sring_buf_read( ss->ra_buf, ss->out_buffer, avail );
+	sring_buf_next( ss->ra_buf, avail );
+    }
+    if( avail < size )
+    {
+	//Underrun:
+	smem_clear( (uint8_t*)ss->out_buffer + avail, size - avail );
+	ss->ra_underruns++;
+    }
+    ssemaphore_release( &ss->ra_sem );
+    return avail ? 1 : 0;
+}
+
+static void* sundog_sound_ra_thread( void* data )
+{
+    sundog_denormal_numbers_check();
+    sundog_sound* ss = (sundog_sound*)data;
+    int frame_size = g_sample_size[ ss->out_type ] * ss->out_channels;
+    int chunk = ss->ra_chunk;
+    size_t chunk_size = chunk * frame_size;
+    size_t max_size = ss->ra_frames * frame_size;
+    void* buf = SMEM_ALLOC( chunk_size );
+    while( ss->ra_exit_request == 0 && buf )
+    {
+	size_t avail = sring_buf_avail( ss->ra_buf );
+	if( avail + chunk_size > max_size || ss->in_enabled )
+	{
+	    //Full, or the input is enabled (the device callback renders the sound itself):
+	    ssemaphore_wait( &ss->ra_sem, 100 );
+	    continue;
+	}
+	//Output time of the new chunk = now + frames in the ring buffer + device latency:
+	uint64_t ahead = avail / frame_size + ss->out_latency2;
+	stime_ticks_t t = stime_ticks() + (stime_ticks_t)( ( ahead * stime_ticks_per_second() ) / ss->freq );
+	sundog_sound_render( ss, buf, chunk, t, NULL, 0 );
+	sring_buf_write( ss->ra_buf, buf, chunk_size );
+    }
+    smem_free( buf );
+    ss->ra_exit_request = 0;
+    return 0;
+}
+
+//Start the render-ahead thread (if enabled in the config):
+static void sundog_sound_ra_init( sundog_sound* ss )
+{
+    if( ss->ra_buf ) return;
+    if( ss->flags & ( SUNDOG_SOUND_FLAG_USER_CONTROLLED | SUNDOG_SOUND_FLAG_ONE_THREAD ) ) return;
+    int ms = sconfig_get_int_value( APP_CFG_SND_RENDER_AHEAD, 0, 0 );
+    if( ms <= 0 ) return;
+    LIMIT_NUM( ms, 10, 2000 );
+    int frames = (int)( (int64_t)ss->freq * ms / 1000 );
+    int chunk = ss->out_latency;
+    LIMIT_NUM( chunk, 64, 2048 );
+    if( chunk > frames / 2 ) chunk = frames / 2;
+    int frame_size = g_sample_size[ ss->out_type ] * ss->out_channels;
+    sring_buf* b = sring_buf_new( frames * frame_size + 1, SRING_BUF_FLAG_SINGLE_RTHREAD | SRING_BUF_FLAG_SINGLE_WTHREAD );
+    if( !b ) return;
+    ssemaphore_create( &ss->ra_sem, NULL, 0, 0 );
+    ss->ra_frames = frames;
+    ss->ra_chunk = chunk;
+    ss->ra_underruns = 0;
+    ss->ra_exit_request = 0;
+    ss->out_latency += frames; //live events (with the timestamps) will be delayed by the render-ahead depth
+    COMPILER_MEMORY_BARRIER();
+    ss->ra_buf = b;
+    sthread_create( &ss->ra_thread, ss->sd, sundog_sound_ra_thread, ss, 0 );
+    slog( "SOUND: render-ahead %d ms (%d frames; chunk %d)\n", ms, frames, chunk );
+}
+
+//Stop the render-ahead thread; the ring buffer will be removed later (after the device deinit):
+static void sundog_sound_ra_stop( sundog_sound* ss )
+{
+    if( !ss->ra_buf ) return;
+    ss->ra_exit_request = 1;
+    ssemaphore_release( &ss->ra_sem );
+    sthread_destroy( &ss->ra_thread, 5000 );
+    if( ss->ra_underruns ) slog( "SOUND: render-ahead underruns: %d\n", ss->ra_underruns );
+}
+
+static void sundog_sound_ra_deinit( sundog_sound* ss )
+{
+    if( !ss->ra_buf ) return;
+    sring_buf_delete( ss->ra_buf );
+    ss->ra_buf = NULL;
+    ssemaphore_destroy( &ss->ra_sem );
+}
+
+#endif
+
+int sundog_sound_callback( sundog_sound* ss, uint32_t flags )
+{
+#ifdef NOSOUND
+    return 0;
+#else
+    void* in_buffer = NULL;
+    if( ss->in_enabled && ss->in_buffer ) in_buffer = ss->in_buffer;
+    if( ss->ra_buf )
+    {
+	if( !in_buffer ) return sundog_sound_ra_read( ss );
+	//The input is enabled - render the sound in sync with it; drop the frames rendered in advance:
+	sring_buf_next( ss->ra_buf, sring_buf_avail( ss->ra_buf ) );
+    }
+    return sundog_sound_render( ss, ss->out_buffer, ss->out_frames, ss->out_time, in_buffer, flags );
 #endif
 }
 
@@ -450,6 +563,8 @@ int sundog_sound_init( sundog_sound* ss, sundog_engine* sd, sound_buffer_type ty
 	COMPILER_MEMORY_BARRIER();
 	ss->initialized = true;
 
+	if( ss->device_initialized ) sundog_sound_ra_init( ss );
+
 	break;
     }
 
@@ -481,6 +596,7 @@ int sundog_sound_init_deferred( sundog_sound* ss )
 	rv = device_sound_init( ss );
 	if( rv ) break;
 	ss->device_initialized = true;
+	sundog_sound_ra_init( ss );
 
 	break;
     }
@@ -504,6 +620,7 @@ int sundog_sound_deinit( sundog_sound* ss )
     smutex_lock( &g_sundog_sound_mutex );
     
     sundog_sound_capture_stop( ss );
+    sundog_sound_ra_stop( ss );
 
     if( ss->flags & SUNDOG_SOUND_FLAG_USER_CONTROLLED )
     {
@@ -517,6 +634,8 @@ int sundog_sound_deinit( sundog_sound* ss )
 	}
     }
 
+    sundog_sound_ra_deinit( ss );
+
     if( ss->slot_buffer )
 	smem_free( ss->slot_buffer );
 
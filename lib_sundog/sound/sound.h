@@ -12,6 +12,7 @@
 #define APP_CFG_JACK_NO_DEF_IN		"jack_nodefin" //don't set default JACK input connections: default = auto; any value = don't set;
 #define APP_CFG_JACK_NO_DEF_OUT		"jack_nodefout" //don't set default JACK output connections: default = auto; any value = don't set;
 #define APP_CFG_JACK_DONT_RESTORE_MIDIIN "jack_drmin" //don't restore JACK MIDI IN connections: default = auto; any value = don't restore;
+#define APP_CFG_SND_RENDER_AHEAD	"render_ahead" //render the sound in a separate thread N ms ahead of the device (the device callback only copies it); default = 0 (off);
 
 #define SUNDOG_SOUND_SLOTS			16
 #define SUNDOG_SOUND_DEFAULT_TIMEOUT_MS		400
@@ -168,6 +169,14 @@ struct sundog_sound
     sthread		out_file_thread;
     volatile int	out_file_exit_request;
 
+    sring_buf*		ra_buf; //render-ahead mode (APP_CFG_SND_RENDER_AHEAD): frames rendered in advance by ra_thread; NULL - off;
+    int			ra_frames; //max number of frames in ra_buf
+    int			ra_chunk; //frames per ra_thread render step
+    volatile int	ra_underruns;
+    sthread		ra_thread;
+    ssemaphore		ra_sem; //released by the device callback (when some frames are consumed)
+    volatile int	ra_exit_request;
+
     smutex		mutex;
 };
 
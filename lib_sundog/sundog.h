@@ -449,7 +449,11 @@ typedef unsigned int uint;
     //       ARM Cortex-A7 (new RPi): fast hardware support for denormalised numbers.
     //#define DISABLE_DENORMAL_NUMBERS
 #endif
-#if !defined(DISABLE_DENORMAL_NUMBERS) && ( defined(ARCH_X86) || defined(ARCH_X86_64) )
+#if defined(__SSE__) || defined(ARM_VFP)
+    //The render functions switch to FTZ/DAZ mode (FZ bit on ARM) - see sundog_denormal_numbers_push():
+    #define DENORMAL_NUMBERS_FLUSHED
+#endif
+#if !defined(DENORMAL_NUMBERS_FLUSHED) && ( defined(ARCH_X86) || defined(ARCH_X86_64) )
     /*
     Denormal numbers (subnormal numbers) fill the underflow gap around zero in floating-point arithmetic.
     Some systems handle denormal values in hardware, in the same way as normal values.
@@ -458,6 +462,9 @@ typedef unsigned int uint;
     We can avoid denormals by adding an extremely quiet noise in some places (where very small numbers can appear).
     */
     #define DENORMAL_NUMBERS
+#endif
+#if defined(DENORMAL_NUMBERS)
+    //(no noise in the DENORMAL_NUMBERS_FLUSHED builds)
     extern uint32_t g_denorm_rand_state;
     #define denorm_add_white_noise( val ) \
     { \
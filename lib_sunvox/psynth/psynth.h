@@ -298,6 +298,9 @@ struct psynth_midi_evt
 #define PSYNTH_CTL_FLAG_EXP2	1 //exponential fn approximation: y = x^2
 #define PSYNTH_CTL_FLAG_EXP3	2 //... y = x^3
 #define PSYNTH_CTL_FLAG_INVEXP3	3 //... (convex upwards) y = 1-x^3
+#define PSYNTH_CTL_FLAG_CURVE_MASK	15
+//other bits:
+#define PSYNTH_CTL_FLAG_NO_COALESCING	( 1 << 4 ) //deliver every value (triggers like "Set phase"); by default only the last value per sample offset is retained for the continuous ctls (type 0; see psynth_add_event())
 
 #define PSYNTH_CTL_MIDI_PARS1( type, ch, mode ) \
     ( ( ( type & 255 ) << 0 ) | ( ( ch & 255 ) << 8 ) | ( ( mode & 255 ) << 16 ) )
@@ -332,6 +335,10 @@ struct psynth_ctl
     uint32_t	midi_pars2; //MIDI IN
     uint8_t	midi_val; //only for psynth_midi_toggle handling
 };
+inline bool psynth_ctl_coalescing( psynth_ctl* ctl ) //Only the last value per sample offset is required (see psynth_add_event())
+{
+    return ctl->type == 0 && !( ctl->flags & PSYNTH_CTL_FLAG_NO_COALESCING );
+}
 
 //3 bits - smp type:
 #define PS_CHUNK_SMP_INT8	    	1
@@ -381,6 +388,10 @@ struct psynth_net;
     #define PSYNTH_DEF_FFT_SIZE		2048
 #endif
 
+//Render quantum (max number of frames rendered by psynth_render_all() at once):
+#define PSYNTH_MIN_BUF_SIZE		16
+#define PSYNTH_MAX_BUF_SIZE		( PSYNTH_SCOPE_SIZE / 4 ) //4096 or 1024
+
 enum
 {
     psynth_level_mode_off = 0,
@@ -718,6 +729,9 @@ struct psynth_net
     psynth_module*	mods;
     uint		mods_num; //mods capacity (may be larger than number of modules in project)
     smutex		mods_mutex; //May be used by synths for access to some global data
+    ssymtab*		mods_names; //Name -> first module with this name (see psynth_get_module_by_name()); rebuilt on demand
+    uint32_t		mods_names_changes; //add/remove/rename
+    uint32_t		mods_names_index_changes;
     psynth_event*	events_heap;
 #ifdef PSYNTH_MULTITHREADED
     std::atomic_int	events_num;
@@ -744,7 +758,11 @@ struct psynth_net
     //Some info:
 
     int			sampling_freq;
-    int			max_buf_size; //in frames
+    int			max_buf_size; //in frames: size of the module channel buffers; set in psynth_init() only
+    int			quantum; //in frames: current render quantum (PSYNTH_MIN_BUF_SIZE...max_buf_size); see psynth_set_quantum()
+    int			rand_seed; //>=0: fixed seed for the module random generators (reproducible output); -1: time based; see psynth_rand_seed()
+    uint32_t		rand_state; //for psynth_rand() in the fixed seed mode
+    int			sinc_taps; //0 - default interpolation; 8, 16, 32 - windowed-sinc for the stream resamplers and Sampler spline/sinc (config option "sinc_taps"; for the offline rendering)
     int			global_volume;	//1.0 = 256
     int			all_modules_muted;
     int			buf_size;
@@ -862,6 +880,10 @@ inline psynth_ctl* psynth_get_ctl( psynth_module* mod, uint ctl_num, psynth_net*
 //Temp buffers:
 PS_STYPE* psynth_get_temp_buf( uint mod_num, psynth_net* pnet, uint buf_num );
 
+//Windowed-sinc kernel tables (global; shared by all modules):
+int psynth_sinc_tables_init( int taps ); //create the tables (all bands) for the specified number of taps (8, 16, 32); not for the audio thread!
+const float* psynth_get_sinc_table( int taps, int band ); //NULL if the tables have not been created yet
+
 //Stream resampler:
 #if defined(PS_STYPE_FLOATINGPOINT) && CPUMARK >= 10
     #define PSYNTH_RESAMP_INTERP_SPLINE
@@ -872,6 +894,7 @@ PS_STYPE* psynth_get_temp_buf( uint mod_num, psynth_net* pnet, uint buf_num );
     #define PSYNTH_RESAMP_INTERP_BEFORE 0 //Number of additional frames (before the current frame) required for interpolation
 #endif
 #define PSYNTH_RESAMP_BUF_TAIL ( PSYNTH_RESAMP_INTERP_AFTER + PSYNTH_RESAMP_INTERP_BEFORE + 1 ) //Additional frames in the begin/end of the resampler buffer
+#define PSYNTH_RESAMP_MAX_BUF_TAIL 32 //windowed-sinc (PSYNTH_SINC_MAX_TAPS): 15 frames before + 16 after + 1
 #define PSYNTH_RESAMP_FLAG_MODE0	0 //input len = auto;   output len = manual;
 #define PSYNTH_RESAMP_FLAG_MODE1	1 //input len = manual; output len = manual;
 #define PSYNTH_RESAMP_FLAG_MODE2	2 //input len = manual; output len = auto;
@@ -887,12 +910,17 @@ struct psynth_resampler
     uint			ratio_fp; //low freq -> high freq: 0...65536
 				          //high freq -> low freq: 65536...+
 				          //ratio = input buffer step length
+    int				sinc_taps; //0 - default interpolation (linear/spline); pnet->sinc_taps
+    const float*		sinc_table;
+    int				interp_before; //PSYNTH_RESAMP_INTERP_BEFORE or sinc_taps / 2 - 1
+    int				interp_after; //PSYNTH_RESAMP_INTERP_AFTER or sinc_taps / 2
+    int				buf_tail; //PSYNTH_RESAMP_BUF_TAIL or sinc_taps
 
     int				input_buf_size; //resamp_buf capacity (in frames)
     uint                    	input_frames; //required
     uint	                input_frames_fp; //fp = fixed point 16.16; for uint32_t: input_frames MUST BE <= 65353!
     uint	                input_ptr_fp;
-    PS_STYPE			input_buf_tail[ PSYNTH_RESAMP_BUF_TAIL * PSYNTH_MAX_CHANNELS ]; //last filled frames from the input buffer
+    PS_STYPE			input_buf_tail[ PSYNTH_RESAMP_MAX_BUF_TAIL * PSYNTH_MAX_CHANNELS ]; //last filled frames from the input buffer
     uint			input_empty_frames;
     uint			input_empty_frames_max;
 
@@ -913,7 +941,7 @@ struct psynth_resampler
 psynth_resampler* psynth_resampler_new( psynth_net* pnet, uint mod_num, int in_smprate, int out_smprate, int ratio_fp, uint32_t flags );
 int psynth_resampler_change( psynth_resampler* r, int in_smprate, int out_smprate, int ratio_fp, uint32_t flags );
 PS_STYPE* psynth_resampler_input_buf( psynth_resampler* r, uint buf_num );
-inline int psynth_resampler_input_buf_offset( psynth_resampler* r ) { return PSYNTH_RESAMP_BUF_TAIL + r->input_delay; } //call this before writing data to the input buffer
+inline int psynth_resampler_input_buf_offset( psynth_resampler* r ) { return r->buf_tail + r->input_delay; } //call this before writing data to the input buffer
 void psynth_resampler_remove( psynth_resampler* r );
 void psynth_resampler_reset( psynth_resampler* r );
 int psynth_resampler_begin( //Return value: number of the input frames, that user must put to the resamp_buf + psynth_resampler_input_buf_offset()
@@ -993,6 +1021,8 @@ enum
 };
 #define PSYNTH_UNKNOWN_NOTE		(-999999)
 int psynth_str2note( const char* note_str ); //return note number or PSYNTH_UNKNOWN_NOTE
+uint32_t psynth_rand_seed( uint mod_num, psynth_net* pnet ); //initial seed for the random generator of the module
+uint32_t psynth_rand( psynth_net* pnet ); //OUT: 0...32767; same as pseudo_random(), but reproducible in the fixed seed mode
 int8_t* psynth_get_noise_table(); //int8_t * PSYNTH_NOISE_TABLE_SIZE
 void* psynth_get_sine_table( int bytes_per_sample, bool sign, int length_bits, int amp );
 PS_STYPE* psynth_get_base_wavetable();
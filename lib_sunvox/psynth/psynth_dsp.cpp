@@ -506,6 +506,47 @@ biquad_filter_float biquad_filter_freq_response( biquad_filter* f, biquad_filter
 	for( int i = 1; i < get_biquad_filter_stages( f->type ); i++ ) rv *= t;
     return rv;
 }
+static double psynth_bessel_i0( double x )
+{
+    double sum = 1;
+    double t = 1;
+    for( int k = 1; k < 32; k++ )
+    {
+	t *= ( x / ( 2 * k ) ) * ( x / ( 2 * k ) );
+	sum += t;
+	if( t < sum * 1e-12 ) break;
+    }
+    return sum;
+}
+float* psynth_sinc_table_new( int taps, int band )
+{
+    if( taps != 8 && taps != 16 && taps != 32 ) return NULL;
+    float* table = SMEM_ALLOC2( float, ( PSYNTH_SINC_PHASES + 1 ) * taps );
+    if( !table ) return NULL;
+    double fc = 0.9 * pow( 2, -(double)band / 2 ); //cutoff: 1 = input Nyquist
+    double beta = taps == 8 ? 6 : ( taps == 16 ? 10 : 13 ); //Kaiser window: stopband attenuation vs transition band width
+    double half = taps / 2;
+    double i0_beta = psynth_bessel_i0( beta );
+    for( int ph = 0; ph <= PSYNTH_SINC_PHASES; ph++ )
+    {
+	float* k = table + ph * taps;
+	double frac = (double)ph / PSYNTH_SINC_PHASES;
+	double sum = 0;
+	double v[ PSYNTH_SINC_MAX_TAPS ];
+	for( int t = 0; t < taps; t++ )
+	{
+	    double x = ( t - ( half - 1 ) ) - frac; //distance from the read position (in input frames)
+	    double w = x / half;
+	    w = 1 - w * w;
+	    w = w > 0 ? psynth_bessel_i0( beta * sqrt( w ) ) / i0_beta : 0;
+	    double s = fabs( x ) < 1e-9 ? fc : sin( M_PI * fc * x ) / ( M_PI * x );
+	    v[ t ] = s * w;
+	    sum += v[ t ];
+	}
+	for( int t = 0; t < taps; t++ ) k[ t ] = (float)( v[ t ] / sum ); //unity gain at DC
+    }
+    return table;
+}
 #ifndef PSYNTH_OVERSAMPLER_DISABLED
 const float g_psynth_oversampler_sinc_2x[ PSYNTH_OVERSAMPLER_DOWNSMP_VALS ] = { 1.75465e-09, -2.00738e-09, 0.222552, 0.554896, 0.222552, -2.00738e-09, 1.75465e-09 };
 const float g_psynth_oversampler_sinc_4x[ PSYNTH_OVERSAMPLER_DOWNSMP_VALS ] = { -1.94438e-09, 0.0359841, 0.246617, 0.434798, 0.246617, 0.0359841, -1.94438e-09 };
@@ -1,5 +1,9 @@
 #pragma once
 
+#ifdef __SSE2__
+    #include <emmintrin.h>
+#endif
+
 //
 // Biquad Filter
 //
@@ -153,6 +157,90 @@ void psynth_oversampler_init( psynth_oversampler* os, int scale, PS_STYPE* src,
 PS_STYPE* psynth_oversampler_begin( psynth_oversampler* os, int ch );
 int psynth_oversampler_end( psynth_oversampler* os, int ch );
 
+//
+// Polyphase windowed-sinc interpolator (Sampler, stream resampler)
+//
+
+#define PSYNTH_SINC_PHASE_BITS		8
+#define PSYNTH_SINC_PHASES		( 1 << PSYNTH_SINC_PHASE_BITS ) //kernel phases per input frame (+ linear interpolation between the phases)
+#define PSYNTH_SINC_BANDS		8 //band b: cutoff = 0.9 * 2^(-b/2) of the input Nyquist (anti-aliasing for the downsampling / pitch up)
+#define PSYNTH_SINC_MAX_TAPS		32 //8, 16 or 32
+
+//Kernel table: ( PSYNTH_SINC_PHASES + 1 ) * taps coefficients (Kaiser window);
+//tap t is applied to the input frame p - ( taps / 2 - 1 ) + t, where p = integer part of the read position:
+float* psynth_sinc_table_new( int taps, int band );
+
+inline int psynth_sinc_band( uint delta ) //delta (input frames per output frame): 16.16 fixed point
+{
+    static const uint band_lim[ PSYNTH_SINC_BANDS - 1 ] = { 65536, 92682, 131072, 185364, 262144, 370728, 524288 }; //2^(b/2)
+    int b = 0;
+    while( b < PSYNTH_SINC_BANDS - 1 && delta > band_lim[ b ] ) b++;
+    return b;
+}
+
+//Kernel for the fractional position frac (0...65535):
+inline void psynth_sinc_kernel( float* RESTRICT coefs, const float* RESTRICT table, uint frac, int taps )
+{
+    const float* RESTRICT k0 = table + ( frac >> ( 16 - PSYNTH_SINC_PHASE_BITS ) ) * taps;
+    const float* RESTRICT k1 = k0 + taps;
+    float t = (float)( frac & ( ( 1 << ( 16 - PSYNTH_SINC_PHASE_BITS ) ) - 1 ) ) * ( 1.0F / (float)( 1 << ( 16 - PSYNTH_SINC_PHASE_BITS ) ) );
+#ifdef __SSE2__
+    __m128 vt = _mm_set1_ps( t );
+    for( int i = 0; i < taps; i += 4 )
+    {
+	__m128 a = _mm_loadu_ps( k0 + i );
+	__m128 b = _mm_loadu_ps( k1 + i );
+	_mm_storeu_ps( coefs + i, _mm_add_ps( a, _mm_mul_ps( _mm_sub_ps( b, a ), vt ) ) );
+    }
+#else
+    for( int i = 0; i < taps; i++ ) coefs[ i ] = k0[ i ] + ( k1[ i ] - k0[ i ] ) * t;
+#endif
+}
+
+//Inner product: mono (src[ taps ]):
+inline float psynth_sinc_dot( const float* RESTRICT src, const float* RESTRICT coefs, int taps )
+{
+#ifdef __SSE2__
+    __m128 acc = _mm_setzero_ps();
+    for( int i = 0; i < taps; i += 4 )
+	acc = _mm_add_ps( acc, _mm_mul_ps( _mm_loadu_ps( src + i ), _mm_loadu_ps( coefs + i ) ) );
+    acc = _mm_add_ps( acc, _mm_movehl_ps( acc, acc ) );
+    acc = _mm_add_ss( acc, _mm_shuffle_ps( acc, acc, 1 ) );
+    return _mm_cvtss_f32( acc );
+#else
+    float acc = 0;
+    for( int i = 0; i < taps; i++ ) acc += src[ i ] * coefs[ i ];
+    return acc;
+#endif
+}
+
+//Inner product: interleaved stereo (src[ taps * 2 ]):
+inline void psynth_sinc_dot2( const float* RESTRICT src, const float* RESTRICT coefs, int taps, float* l, float* r )
+{
+#ifdef __SSE2__
+    __m128 acc = _mm_setzero_ps();
+    for( int i = 0; i < taps; i += 4 )
+    {
+	__m128 c = _mm_loadu_ps( coefs + i );
+	acc = _mm_add_ps( acc, _mm_mul_ps( _mm_loadu_ps( src + i * 2 ), _mm_unpacklo_ps( c, c ) ) );
+	acc = _mm_add_ps( acc, _mm_mul_ps( _mm_loadu_ps( src + i * 2 + 4 ), _mm_unpackhi_ps( c, c ) ) );
+    }
+    acc = _mm_add_ps( acc, _mm_movehl_ps( acc, acc ) ); //L R
+    *l = _mm_cvtss_f32( acc );
+    *r = _mm_cvtss_f32( _mm_shuffle_ps( acc, acc, 1 ) );
+#else
+    float acc_l = 0;
+    float acc_r = 0;
+    for( int i = 0; i < taps; i++ )
+    {
+	acc_l += src[ i * 2 ] * coefs[ i ];
+	acc_r += src[ i * 2 + 1 ] * coefs[ i ];
+    }
+    *l = acc_l;
+    *r = acc_r;
+#endif
+}
+
 //
 // Smooth parameter changes
 //
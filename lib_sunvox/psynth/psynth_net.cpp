@@ -30,6 +30,9 @@ IN THE SOFTWARE.
 #include "sunvox_engine.h"
 #define DEFAULT_MODULE_EVENTS_NUM 128
 #define DEFAULT_HEAP_EVENTS_NUM 256
+#define HEAP_EVENTS_PER_MODULE 32 //event heap reserve per module (see psynth_reserve_events_heap())
+#define MODULE_EVENTS_PER_CTL 8 //module event list reserve per controller (see psynth_reserve_module_events())
+#define EVT_COALESCING_DEPTH 32 //max number of the module events to check in psynth_add_event()
 #if defined(OS_LINUX) && (CPUMARK >= 10) && defined(SMEM_USE_NAMES) && defined(SUNVOX_GUI)
     #define EVT_HEAP_DEBUG_MESSAGES
 #endif
@@ -129,6 +132,7 @@ atomic_vptr g_noise_table;
 #define MAX_SINE_TABLES 16
 atomic_vptr g_sine_tables[ MAX_SINE_TABLES ];
 atomic_vptr g_base_wavetable;
+atomic_vptr g_sinc_tables[ 3 * PSYNTH_SINC_BANDS ]; //taps 8, 16, 32 * PSYNTH_SINC_BANDS
 int psynth_global_init()
 {
     atomic_init( &g_noise_table, (void*)NULL );
@@ -137,6 +141,10 @@ int psynth_global_init()
 	atomic_init( &g_sine_tables[ i ], (void*)NULL );
     }
     atomic_init( &g_base_wavetable, (void*)NULL );
+    for( int i = 0; i < 3 * PSYNTH_SINC_BANDS; i++ )
+    {
+	atomic_init( &g_sinc_tables[ i ], (void*)NULL );
+    }
     return 0;
 }
 int psynth_global_deinit()
@@ -147,6 +155,10 @@ int psynth_global_deinit()
 	p = atomic_exchange( &g_sine_tables[ i ], (void*)NULL ); smem_free( p );
     }
     p = atomic_exchange( &g_base_wavetable, (void*)NULL ); smem_free( p );
+    for( int i = 0; i < 3 * PSYNTH_SINC_BANDS; i++ )
+    {
+	p = atomic_exchange( &g_sinc_tables[ i ], (void*)NULL ); smem_free( p );
+    }
     return 0;
 }
 #ifdef PSYNTH_MULTITHREADED
@@ -204,7 +216,20 @@ void psynth_init( uint flags, int freq, int bpm, int tpl, void* host, uint base_
     smutex_init( &pnet->mods_mutex, 0 );
     pnet->mods = SMEM_ZALLOC2( psynth_module, 4 );
     pnet->mods_num = 4;
-    int heap_size = DEFAULT_HEAP_EVENTS_NUM;
+    pnet->sampling_freq = freq;
+    int quantum = sconfig_get_int_value( "quantum", 0, 0 ); //frames; 0 = auto (20ms)
+    if( quantum <= 0 ) quantum = (int)( (float)freq * 0.02F );
+    if( quantum < PSYNTH_MIN_BUF_SIZE ) quantum = PSYNTH_MIN_BUF_SIZE;
+    if( quantum > PSYNTH_MAX_BUF_SIZE ) quantum = PSYNTH_MAX_BUF_SIZE;
+    pnet->max_buf_size = quantum;
+    pnet->quantum = quantum;
+    pnet->rand_seed = sconfig_get_int_value( "seed", -1, 0 ); //>=0: fixed random seed (for the regression tests)
+    if( pnet->rand_seed < 0 ) pnet->rand_seed = -1;
+    pnet->rand_state = pnet->rand_seed;
+    pnet->sinc_taps = sconfig_get_int_value( "sinc_taps", 0, 0 ); //8, 16, 32: windowed-sinc interpolation (high quality offline rendering)
+    if( pnet->sinc_taps != 8 && pnet->sinc_taps != 16 && pnet->sinc_taps != 32 ) pnet->sinc_taps = 0;
+    if( pnet->sinc_taps && psynth_sinc_tables_init( pnet->sinc_taps ) ) pnet->sinc_taps = 0;
+    int heap_size = DEFAULT_HEAP_EVENTS_NUM * ( 1 + quantum / 1024 );
 #ifdef PSYNTH_MULTITHREADED
     heap_size *= 4;
     atomic_init( &pnet->events_num, 0 );
@@ -236,8 +261,6 @@ void psynth_init( uint flags, int freq, int bpm, int tpl, void* host, uint base_
 	pnet->fft = SMEM_ALLOC2( PS_STYPE, pnet->fft_size );
     }
     pnet->fft_mod = -1;
-    pnet->sampling_freq = freq;
-    pnet->max_buf_size = (int)( (float)freq * 0.02F ); 
     pnet->global_volume = 80;
     pnet->host = host;
     pnet->base_host_version = base_host_version;
@@ -247,6 +270,13 @@ void psynth_init( uint flags, int freq, int bpm, int tpl, void* host, uint base_
     {
     }
 }
+int psynth_set_quantum( int frames, psynth_net* pnet )
+{
+    if( frames < PSYNTH_MIN_BUF_SIZE ) frames = PSYNTH_MIN_BUF_SIZE;
+    if( frames > pnet->max_buf_size ) frames = pnet->max_buf_size;
+    pnet->quantum = frames;
+    return frames;
+}
 void psynth_close( psynth_net* pnet )
 {
     if( pnet->mods )
@@ -276,6 +306,7 @@ void psynth_close( psynth_net* pnet )
     smem_free( pnet->midi_in_mods );
     pnet->midi_in_mods_num = 0;
     smem_free( pnet->fft );
+    ssymtab_delete( pnet->mods_names );
     smutex_destroy( &pnet->mods_mutex );
     smem_free( pnet->events_heap );
     pnet->th_exit_request = true;
@@ -307,6 +338,7 @@ int psynth_add_module(
     if( handler == NULL ) handler = psynth_empty;
     pnet->change_counter++;
     pnet->change_counter2++;
+    pnet->mods_names_changes++;
     if( n < 0 )
     {
 	for( n = 0; (unsigned)n < pnet->mods_num; n++ )
@@ -341,6 +373,7 @@ int psynth_add_module(
     s->events_num = 0;
     s->events = SMEM_ALLOC2( int, DEFAULT_MODULE_EVENTS_NUM );
     if( !s->events ) return -1;
+    psynth_reserve_events_heap( pnet );
     s->id = g_psynth_module_id_cnt++;
     if( name )
     {
@@ -499,6 +532,7 @@ void psynth_remove_module( uint mod_num, psynth_net* pnet )
     if( !( pnet->mods[ mod_num ].flags & PSYNTH_FLAG_EXISTS ) ) return;
     pnet->change_counter++;
     pnet->change_counter2++;
+    pnet->mods_names_changes++;
     psynth_module* mod = &pnet->mods[ mod_num ];
     psynth_event evt;
     evt.command = PS_CMD_CLOSE;
@@ -643,10 +677,55 @@ smutex* psynth_get_mutex( uint mod_num, psynth_net* pnet )
     }
     return 0;
 }
+static void psynth_build_names_index( psynth_net* pnet )
+{
+    int size_level = 0;
+    while( size_level < SSYMTAB_TABSIZE_NUM - 1 && (uint)g_ssymtab_tabsize[ size_level ] < pnet->mods_num ) size_level++;
+    ssymtab* st = pnet->mods_names;
+    if( st && st->size != g_ssymtab_tabsize[ size_level ] ) { ssymtab_delete( st ); st = NULL; }
+    if( st )
+	ssymtab_deinit( st );
+    else
+	st = SMEM_ZALLOC2( ssymtab, 1 );
+    pnet->mods_names = st;
+    if( !st ) return;
+    if( ssymtab_init( st, size_level ) ) { smem_free( st ); pnet->mods_names = NULL; return; }
+    for( uint i = 0; i < pnet->mods_num; i++ )
+    {
+	psynth_module* mod = &pnet->mods[ i ];
+	if( !( mod->flags & PSYNTH_FLAG_EXISTS ) ) continue;
+	SSYMTAB_VAL v;
+	v.i = i;
+	bool created = false;
+	ssymtab_item* sym = ssymtab_lookup( mod->name, -1, true, 0, v, &created, st );
+	if( sym && created ) sym->val.i = i; //first module with this name
+    }
+    pnet->mods_names_index_changes = pnet->mods_names_changes;
+}
 int psynth_get_module_by_name( const char* name, psynth_net* pnet )
 {
     int retval = -1;
-    for( uint i = 0; i < pnet->mods_num; i++ )
+    if( !name ) return retval;
+    int i = -2; //no index
+    smutex_lock( &pnet->mods_mutex );
+    if( !pnet->mods_names || pnet->mods_names_index_changes != pnet->mods_names_changes )
+	psynth_build_names_index( pnet );
+    if( pnet->mods_names )
+    {
+	i = ssymtab_iget( name, -1, pnet->mods_names );
+	if( i >= 0 )
+	{
+	    psynth_module* mod = &pnet->mods[ i ];
+	    if( (unsigned)i >= pnet->mods_num || !( mod->flags & PSYNTH_FLAG_EXISTS ) || smem_strcmp( mod->name, name ) )
+	    {
+		pnet->mods_names_changes++; //the index is out of date
+		i = -2;
+	    }
+	}
+    }
+    smutex_unlock( &pnet->mods_mutex );
+    if( i != -2 ) return i;
+    for( i = 0; (unsigned)i < pnet->mods_num; i++ )
     {
 	psynth_module* mod = &pnet->mods[ i ];
 	if( !( mod->flags & PSYNTH_FLAG_EXISTS ) ) continue;
@@ -661,6 +740,7 @@ void psynth_rename( uint mod_num, const char* name, psynth_net* pnet )
     pnet->change_counter++;
     psynth_module* mod = &pnet->mods[ mod_num ];
     if( !( mod->flags & PSYNTH_FLAG_EXISTS ) ) return;
+    pnet->mods_names_changes++;
     for( size_t i = 0; i < smem_strlen( name ) + 1 && i < sizeof( mod->name ) - 1; i++ )
     {
 	mod->name[ i ] = name[ i ];
@@ -922,6 +1002,29 @@ void psynth_all_midi_notes_off( uint mod_num, stime_ticks_t t, psynth_net* pnet
     }
 #endif
 }
+//Pre-size the event heap from the number of modules, so the dense modulation doesn't resize it in the audio thread:
+void psynth_reserve_events_heap( psynth_net* pnet )
+{
+    int heap_size = ( DEFAULT_HEAP_EVENTS_NUM + pnet->mods_num * HEAP_EVENTS_PER_MODULE ) * ( 1 + pnet->max_buf_size / 1024 );
+#ifdef PSYNTH_MULTITHREADED
+    heap_size *= 4;
+#endif
+    if( heap_size <= (int)( smem_get_size( pnet->events_heap ) / sizeof( psynth_event ) ) ) return;
+#ifdef EVT_HEAP_DEBUG_MESSAGES
+    printf( "EVT HEAP RESERVE: %d -> %d\n", (int)( smem_get_size( pnet->events_heap ) / sizeof( psynth_event ) ), heap_size );
+#endif
+    pnet->events_heap = SMEM_RESIZE2( pnet->events_heap, psynth_event, heap_size );
+}
+//Pre-size the module event list from the number of controllers (PS_CMD_SETUP_FINISHED), so the controller floods don't resize it in the audio thread:
+static void psynth_reserve_module_events( psynth_module* mod, psynth_net* pnet )
+{
+    int size = ( DEFAULT_MODULE_EVENTS_NUM + mod->ctls_num * MODULE_EVENTS_PER_CTL ) * ( 1 + pnet->max_buf_size / 1024 );
+    if( size <= (int)( smem_get_size( mod->events ) / sizeof( int ) ) ) return;
+#ifdef EVT_HEAP_DEBUG_MESSAGES
+    printf( "EVT HEAP (%s) RESERVE: %d -> %d\n", mod->name, (int)( smem_get_size( mod->events ) / sizeof( int ) ), size );
+#endif
+    mod->events = SMEM_RESIZE2( mod->events, int, size );
+}
 void psynth_reset_events( psynth_net* pnet )
 {
 #ifdef PSYNTH_MULTITHREADED
@@ -944,6 +1047,31 @@ void psynth_add_event( uint mod_num, psynth_event* evt, psynth_net* pnet )
     if( mod_num >= pnet->mods_num ) return;
     psynth_module* mod = &pnet->mods[ mod_num ];
     if( ( mod->flags & PSYNTH_FLAG_EXISTS ) == 0 ) return;
+    if( evt->command == PS_CMD_SET_GLOBAL_CONTROLLER && !( mod->realtime_flags & PSYNTH_RT_FLAG_LOCKED ) )
+    {
+	//Coalescing (continuous ctls without PSYNTH_CTL_FLAG_NO_COALESCING): only the last value per controller per sample offset is retained.
+	//Look back through the tail of the same offset controller events;
+	//the old event is moved to the end of the list (the order of the writes to different controllers is preserved):
+	uint ctl_num = evt->controller.ctl_num;
+	if( ctl_num < mod->ctls_num && psynth_ctl_coalescing( &mod->ctls[ ctl_num ] ) )
+	{
+	    int i_end = (int)mod->events_num - EVT_COALESCING_DEPTH;
+	    if( i_end < 0 ) i_end = 0;
+	    for( int i = (int)mod->events_num - 1; i >= i_end; i-- )
+	    {
+		int evt_num = mod->events[ i ];
+		psynth_event* prev = &pnet->events_heap[ evt_num ];
+		if( prev->offset != evt->offset || prev->command != PS_CMD_SET_GLOBAL_CONTROLLER ) break;
+		if( prev->controller.ctl_num == ctl_num )
+		{
+		    for( int i2 = i + 1; i2 < (int)mod->events_num; i2++ ) mod->events[ i2 - 1 ] = mod->events[ i2 ];
+		    mod->events[ mod->events_num - 1 ] = evt_num;
+		    *prev = *evt;
+		    return;
+		}
+	    }
+	}
+    }
 #ifdef PSYNTH_MULTITHREADED
     int events_num = atomic_fetch_add( &pnet->events_num, 1 );
 #else
@@ -2084,6 +2212,9 @@ PS_RETTYPE psynth_handle_event( uint mod_num, psynth_event* evt, psynth_net* pne
 	    case PS_CMD_WRITE_CURVE:
 		pnet->change_counter++;
 		break;
+	    case PS_CMD_SETUP_FINISHED:
+		psynth_reserve_module_events( mod, pnet );
+		break;
 	    default: break;
 	}
         if( evt->command == PS_CMD_RENDER_REPLACE )
@@ -2425,6 +2556,26 @@ PS_STYPE* psynth_get_temp_buf( uint mod_num, psynth_net* pnet, uint buf_num )
     }
     return buf;
 }
+int psynth_sinc_tables_init( int taps )
+{
+    if( taps != 8 && taps != 16 && taps != 32 ) return -1;
+    int n = ( taps == 8 ? 0 : ( taps == 16 ? 1 : 2 ) ) * PSYNTH_SINC_BANDS;
+    for( int band = 0; band < PSYNTH_SINC_BANDS; band++ )
+    {
+	void* p = atomic_load( &g_sinc_tables[ n + band ] );
+	if( p ) continue;
+	float* t = psynth_sinc_table_new( taps, band );
+	if( !t ) return -1;
+	if( !atomic_compare_exchange_strong( &g_sinc_tables[ n + band ], &p, (void*)t ) )
+	    smem_free( t ); //created by another thread
+    }
+    return 0;
+}
+const float* psynth_get_sinc_table( int taps, int band )
+{
+    int n = ( taps == 8 ? 0 : ( taps == 16 ? 1 : 2 ) ) * PSYNTH_SINC_BANDS + band;
+    return (const float*)atomic_load_explicit( &g_sinc_tables[ n ], std::memory_order_acquire );
+}
 int psynth_resampler_change( psynth_resampler* r, int in_smprate, int out_smprate, int ratio_fp, uint32_t flags )
 {
     if( !r ) return -1;
@@ -2439,11 +2590,26 @@ int psynth_resampler_change( psynth_resampler* r, int in_smprate, int out_smprat
     {
 	r->ratio_fp = (int64_t)in_smprate * 65536 / out_smprate;
     }
+    r->sinc_taps = r->pnet->sinc_taps;
+    r->sinc_table = NULL;
+    if( r->sinc_taps ) r->sinc_table = psynth_get_sinc_table( r->sinc_taps, psynth_sinc_band( r->ratio_fp ) );
+    if( r->sinc_table )
+    {
+	r->interp_before = r->sinc_taps / 2 - 1;
+	r->interp_after = r->sinc_taps / 2;
+    }
+    else
+    {
+	r->sinc_taps = 0;
+	r->interp_before = PSYNTH_RESAMP_INTERP_BEFORE;
+	r->interp_after = PSYNTH_RESAMP_INTERP_AFTER;
+    }
+    r->buf_tail = r->interp_before + r->interp_after + 1;
     r->input_buf_size = 0;
-    r->input_empty_frames_max = PSYNTH_RESAMP_BUF_TAIL;
+    r->input_empty_frames_max = r->buf_tail;
     if( ( flags & PSYNTH_RESAMP_FLAG_MODE ) == PSYNTH_RESAMP_FLAG_MODE1 )
     {
-	r->input_delay = ( (int64_t)( PSYNTH_RESAMP_INTERP_AFTER + 1 ) * r->ratio_fp ) / 65536 + PSYNTH_RESAMP_INTERP_AFTER + 1; 
+	r->input_delay = ( (int64_t)( r->interp_after + 1 ) * r->ratio_fp ) / 65536 + r->interp_after + 1; 
 	r->input_empty_frames_max += r->input_delay;
 	int prev_size = smem_get_size( r->input_delay_bufs[ 0 ] ) / sizeof( PS_STYPE );
 	int new_size = r->input_delay * sizeof( PS_STYPE );
@@ -2489,7 +2655,7 @@ PS_STYPE* psynth_resampler_input_buf( psynth_resampler* r, uint buf_num )
     {
 	int size = ( ( (int64_t)r->pnet->max_buf_size * r->ratio_fp * r->out_smprate ) / r->pnet->sampling_freq / 65536 ) + 4; 
 	if( mode1 ) size += r->input_delay;
-	size += PSYNTH_RESAMP_BUF_TAIL * 2;
+	size += r->buf_tail * 2;
 	r->input_buf_size = size;
 	if( buf )
 	{
@@ -2520,10 +2686,10 @@ void psynth_resampler_reset( psynth_resampler* r )
 {
     if( !r ) return;
     r->state = 0;
-    r->input_ptr_fp = PSYNTH_RESAMP_BUF_TAIL << 16;
+    r->input_ptr_fp = r->buf_tail << 16;
     if( ( r->flags & PSYNTH_RESAMP_FLAG_MODE ) == PSYNTH_RESAMP_FLAG_MODE2 )
     {
-	r->input_ptr_fp = ( PSYNTH_RESAMP_INTERP_BEFORE + 1 ) << 16;
+	r->input_ptr_fp = ( r->interp_before + 1 ) << 16;
     }
     SMEM_CLEAR_STRUCT( r->input_buf_tail );
     r->input_empty_frames = 0;
@@ -2545,14 +2711,14 @@ int psynth_resampler_begin( psynth_resampler* r, int input_frames, int output_fr
     {
 	r->output_frames = output_frames;
 	r->input_frames_fp = output_frames * r->ratio_fp;
-	uint input_last_required_frame = ( ( r->input_ptr_fp + r->input_frames_fp - r->ratio_fp ) >> 16 ) + PSYNTH_RESAMP_INTERP_AFTER;
-	r->input_frames = ( ( input_last_required_frame + 1 ) - PSYNTH_RESAMP_BUF_TAIL ) & 0xFFFF;
+	uint input_last_required_frame = ( ( r->input_ptr_fp + r->input_frames_fp - r->ratio_fp ) >> 16 ) + r->interp_after;
+	r->input_frames = ( ( input_last_required_frame + 1 ) - r->buf_tail ) & 0xFFFF;
     }
     else
     {
 	r->input_frames = input_frames;
 	r->output_frames = 0;
-	uint l = ( PSYNTH_RESAMP_BUF_TAIL + input_frames - PSYNTH_RESAMP_INTERP_AFTER ) * 65536 - 1;
+	uint l = ( r->buf_tail + input_frames - r->interp_after ) * 65536 - 1;
 	if( r->input_ptr_fp <= l )
 	    r->output_frames = ( l - r->input_ptr_fp ) / r->ratio_fp + 1;
 	r->input_frames_fp = r->output_frames * r->ratio_fp;
@@ -2584,8 +2750,8 @@ int psynth_resampler_end(
     		{
         	    PS_STYPE* RESTRICT buf = inputs[ ch ];
         	    PS_STYPE* RESTRICT delay_buf = r->input_delay_bufs[ ch ];
-    		    smem_copy( buf + PSYNTH_RESAMP_BUF_TAIL, delay_buf, r->input_delay * sizeof( PS_STYPE ) );
-    		    smem_copy( delay_buf, buf + PSYNTH_RESAMP_BUF_TAIL + r->input_frames_avail, r->input_delay * sizeof( PS_STYPE ) ); 
+    		    smem_copy( buf + r->buf_tail, delay_buf, r->input_delay * sizeof( PS_STYPE ) );
+    		    smem_copy( delay_buf, buf + r->buf_tail + r->input_frames_avail, r->input_delay * sizeof( PS_STYPE ) ); 
     		}
     	    }
             if( r->input_offset < 0 ) {   r->input_offset = 0; }
@@ -2595,46 +2761,72 @@ int psynth_resampler_end(
 	}
         if( !skip_processing )
         {
+    	    int buf_tail = r->buf_tail;
     	    for( int ch = 0; ch < output_count; ch++ )
 	    {
         	PS_STYPE* RESTRICT out = outputs[ ch ] + output_offset;
         	PS_STYPE* RESTRICT buf = inputs[ ch ] + input_offset;
-        	PS_STYPE* RESTRICT input_buf_tail = &r->input_buf_tail[ PSYNTH_RESAMP_BUF_TAIL * ch ];
+        	PS_STYPE* RESTRICT input_buf_tail = &r->input_buf_tail[ buf_tail * ch ];
         	if( input_filled == 0 )
         	{
-            	    for( uint i = PSYNTH_RESAMP_BUF_TAIL; i < r->input_frames + PSYNTH_RESAMP_BUF_TAIL; i++ )
+            	    for( uint i = buf_tail; i < r->input_frames + buf_tail; i++ )
                 	buf[ i ] = 0;
         	}
-    		for( uint i = 0; i < PSYNTH_RESAMP_BUF_TAIL; i++ )
+    		for( int i = 0; i < buf_tail; i++ )
     		{
     	    	    buf[ i ] = input_buf_tail[ i ];
     		}
         	uint input_ptr_fp = r->input_ptr_fp;
-        	for( uint i = 0; i < r->output_frames; i++ )
+        	if( r->sinc_taps )
         	{
-            	    uint c = input_ptr_fp & 0xFFFF;
-            	    uint p = input_ptr_fp >> 16;
+        	    //Windowed-sinc:
+        	    int taps = r->sinc_taps;
+        	    const float* sinc_table = r->sinc_table;
+        	    float coefs[ PSYNTH_SINC_MAX_TAPS ];
+#ifndef PS_STYPE_FLOATINGPOINT
+        	    float win[ PSYNTH_SINC_MAX_TAPS ];
+#endif
+        	    for( uint i = 0; i < r->output_frames; i++ )
+        	    {
+            		psynth_sinc_kernel( coefs, sinc_table, input_ptr_fp & 0xFFFF, taps );
+            		PS_STYPE* src = buf + ( input_ptr_fp >> 16 ) - r->interp_before;
+#ifdef PS_STYPE_FLOATINGPOINT
+            		out[ i ] = psynth_sinc_dot( src, coefs, taps );
+#else
+            		for( int t = 0; t < taps; t++ ) win[ t ] = src[ t ];
+            		out[ i ] = (PS_STYPE)psynth_sinc_dot( win, coefs, taps );
+#endif
+            		input_ptr_fp += r->ratio_fp;
+        	    }
+        	}
+        	else
+        	{
+        	    for( uint i = 0; i < r->output_frames; i++ )
+        	    {
+            	        uint c = input_ptr_fp & 0xFFFF;
+            	        uint p = input_ptr_fp >> 16;
 #ifdef PSYNTH_RESAMP_INTERP_SPLINE
-            	    PS_STYPE2 v0 = buf[ p - 1 ];
-            	    PS_STYPE2 v1 = buf[ p ];
-            	    PS_STYPE2 v2 = buf[ p + 1 ];
-            	    PS_STYPE2 v3 = buf[ p + 2 ];
-            	    PS_STYPE2 mu = (PS_STYPE2)c / (PS_STYPE2)0x10000;
-            	    PS_STYPE2 a = ( 3 * ( v1 - v2 ) - v0 + v3 ) / 2;
-            	    PS_STYPE2 b = 2 * v2 + v0 - ( 5 * v1 + v3 ) / 2;
-            	    PS_STYPE2 c2 = ( v2 - v0 ) / 2;
-            	    out[ i ] = ( ( ( a * mu ) + b ) * mu + c2 ) * mu + v1;
+            	        PS_STYPE2 v0 = buf[ p - 1 ];
+            	        PS_STYPE2 v1 = buf[ p ];
+            	        PS_STYPE2 v2 = buf[ p + 1 ];
+            	        PS_STYPE2 v3 = buf[ p + 2 ];
+            	        PS_STYPE2 mu = (PS_STYPE2)c / (PS_STYPE2)0x10000;
+            	        PS_STYPE2 a = ( 3 * ( v1 - v2 ) - v0 + v3 ) / 2;
+            	        PS_STYPE2 b = 2 * v2 + v0 - ( 5 * v1 + v3 ) / 2;
+            	        PS_STYPE2 c2 = ( v2 - v0 ) / 2;
+            	        out[ i ] = ( ( ( a * mu ) + b ) * mu + c2 ) * mu + v1;
 #else
-            	    PS_STYPE2 v1 = buf[ p ];
-            	    PS_STYPE2 v2 = buf[ p + 1 ];
-            	    out[ i ] = ( v2 * c + v1 * ( 0xFFFF - c ) ) / 0x10000;
+            	        PS_STYPE2 v1 = buf[ p ];
+            	        PS_STYPE2 v2 = buf[ p + 1 ];
+            	        out[ i ] = ( v2 * c + v1 * ( 0xFFFF - c ) ) / 0x10000;
 #endif
-            	    input_ptr_fp += r->ratio_fp;
+            	        input_ptr_fp += r->ratio_fp;
+        	    }
         	}
         	uint last_data_ptr = r->input_frames;
         	if( last_data_ptr )
         	{
-        	    for( uint i = 0; i < PSYNTH_RESAMP_BUF_TAIL; i++ )
+        	    for( int i = 0; i < buf_tail; i++ )
         	    {
         		input_buf_tail[ i ] = buf[ last_data_ptr + i ];
         	    }
@@ -2975,6 +3167,16 @@ int psynth_str2note( const char* note_str )
     }
     return PSYNTH_UNKNOWN_NOTE;
 }
+uint32_t psynth_rand_seed( uint mod_num, psynth_net* pnet )
+{
+    if( pnet->rand_seed >= 0 ) return (uint32_t)pnet->rand_seed + mod_num * 3079;
+    return (uint32_t)stime_ns() + pseudo_random() + pnet->mods[ mod_num ].id * 3079;
+}
+uint32_t psynth_rand( psynth_net* pnet )
+{
+    if( pnet->rand_seed >= 0 ) return pseudo_random( &pnet->rand_state );
+    return pseudo_random();
+}
 int8_t* psynth_get_noise_table()
 {
     void* p = atomic_load( &g_noise_table );
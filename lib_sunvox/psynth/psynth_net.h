@@ -12,6 +12,7 @@
 //   add events via psynth_add_event();
 //   psynth_render_setup() - set rendering parameters;
 //   psynth_render_all() - full net rendering (buffer size = user defined; not more then max_buf_size);
+//   (the host splits its buffer into pieces of pnet->quantum frames; see psynth_set_quantum())
 //3) psynth_render_end().
 
 PS_RETTYPE psynth_empty( PSYNTH_MODULE_HANDLER_PARAMETERS );
@@ -21,6 +22,7 @@ int psynth_global_init();
 int psynth_global_deinit();
 void psynth_init( uint flags, int freq, int bpm, int tpl, void* host, uint base_host_version, psynth_net* pnet );
 void psynth_close( psynth_net* pnet );
+int psynth_set_quantum( int frames, psynth_net* pnet ); //set render quantum (PSYNTH_MIN_BUF_SIZE...max_buf_size); retval = actual value
 void psynth_clear( psynth_net* pnet );
 int psynth_add_module(  
     int i,
@@ -55,6 +57,7 @@ int psynth_check_link( int out, int in, psynth_net* pnet ); //Check connection b
 int psynth_open_midi_out( uint mod_num, char* dev_name, int channel, psynth_net* pnet );
 int psynth_set_midi_prog( uint mod_num, int bank, int prog, psynth_net* pnet );
 void psynth_all_midi_notes_off( uint mod_num, stime_ticks_t t, psynth_net* pnet );
+void psynth_reserve_events_heap( psynth_net* pnet ); //Called when the modules are added (not in the audio thread)
 void psynth_reset_events( psynth_net* pnet );
 void psynth_add_event( uint mod_num, psynth_event* evt, psynth_net* pnet ); //Can change events_heap and break your links to the events! (RISK OF EVENT DAMAGE)
 void psynth_multisend( psynth_module* mod, psynth_event* evt, psynth_net* pnet );
@@ -64,7 +64,7 @@ const char* ps_get_string( ps_string str_id )
     		case STR_PS_MODULATION_TYPES: str = "амплитудная (умножение);фазовая;фазовая (абсолютн.);сложение;вычитание;min;max;побитовое И (AND);побитовое искл.ИЛИ (XOR);min abs;max abs"; break;
     		case STR_PS_MODULATION_TYPES2: str = "фазовая;частотная;амплитудная (умножение);сложение;вычитание;min;max;побитовое И (AND);побитовое искл.ИЛИ (XOR);фазовая+;min abs;max abs"; break;
     		case STR_PS_INTERP_TYPES: 
-    		case STR_PS_SAMPLE_INTERP_TYPES: str = "выкл;линейная;сплайн"; break;
+    		case STR_PS_SAMPLE_INTERP_TYPES: str = "выкл;линейная;сплайн;sinc8;sinc16;sinc32"; break;
     		case STR_PS_ENVELOPE_INTERP_TYPES: str = "выкл;линейная"; break;
     		case STR_PS_HARMONIC_TYPES: str = "hsin;прямоугольн.;org1;org2;org3;org4;sin;случайная;треугольн.1;треугольн.2;обертоны1;обертоны2;обертоны3;обертоны4;обертоны1+;обертоны2+;обертоны3+;обертоны4+;металл"; break;
         	case STR_PS_VOWEL_TYPES: str = "а;е;и;о;у"; break;
@@ -76,7 +76,7 @@ const char* ps_get_string( ps_string str_id )
     		case STR_PS_PITCH2CTL_NOTEOFF_ACTION: str = "ничего не делать;тон вниз;тон вверх"; break;
     		case STR_PS_VELOCITY2CTL_NOTEOFF_ACTION: str = "ничего не делать;динамика вниз;динамика вверх"; break;
     		case STR_PS_METAMODULE_PLAY_PAT_MODES: str = "выкл;вкл (с повтором);вкл (один раз);вкл (повтор без выкл);вкл (один раз без выкл)"; break;
-    		case STR_PS_COMPRESSOR_MODES: str = "пиковый;RMS;пиковый без задержки"; break;
+    		case STR_PS_COMPRESSOR_MODES: str = "пиковый;RMS;пиковый без задержки;лимитер;лимитер (true peak)"; break;
     		case STR_PS_DISTORTION_TYPES: str = "обрезание;foldback;foldback2;foldback3;переполнение;переполнение2;насыщение+foldback;насыщение+foldback(sin);насыщение3;насыщение4;насыщение5"; break;
     		case STR_PS_STOP_START: str = "стоп;старт"; break;
     		case STR_PS_ADSR_CURVE_TYPES: str = "линейная;exp1;exp2;-exp1;-exp2;sin;прямоугольная;прямоугольная+сглаживание;2bit;3bit;4bit;5bit"; break;
@@ -87,7 +87,7 @@ const char* ps_get_string( ps_string str_id )
     		case STR_PS_ADSR_OFF_ON_REPEAT: str = "выкл;вкл;повтор"; break;
     		case STR_PS_NOTEON_MODES: str = "-;при смене высоты тона"; break;
     		case STR_PS_NOTEOFF_MODES: str = "-;на мин.высоте тона;на макс.высоте тона"; break;
-    		case STR_PS_PD_ALGS: str = "быстрый (пересечение нуля);автокорреляция;кепстр;пик спектра"; break;
+    		case STR_PS_PD_ALGS: str = "быстрый (пересечение нуля);автокорреляция;кепстр;пик спектра;McLeod (NSDF)"; break;
     		case STR_PS_PITCHSHIFTER_PLAYORIG_MODES: str = "выкл;плавн.переход;быстр.переход"; break;
     		case STR_PS_CAPTURE_MODES: str = "выкл;однократно;постоянно"; break;
     	        case STR_PS_FM2_WAVE_TYPES: str = "пользовательская;треугольная;треугольная^3;пила;пила^3;прямоугольная;sin;hsin;asin;sin^3"; break;
@@ -488,10 +488,10 @@ const char* ps_get_string( ps_string str_id )
     		case STR_PS_DETECTOR_FINETUNE: str = "Подстройка детектора"; break;
     		case STR_PS_LP_FILTER_FREQ: str = "Частота НЧ фильтра (0 - выкл)"; break;
 		case STR_PS_LP_FILTER_ROLLOFF: str = "Крутизна НЧ фильтра"; break;
-		case STR_PS_PD_ALG1_SAMPLE_RATE: str = "Алг1-2 Частота дискретизации (Гц)"; break;
-		case STR_PS_PD_ALG1_BUF_SIZE: str = "Алг1-2 Буфер (мс)"; break;
-		case STR_PS_PD_ALG1_BUF_OVERLAP: str = "Алг1-2 Перекрытие буферов"; break;
-		case STR_PS_PD_ALG1_ABS_THRESHOLD: str = "Алг1 Чувствительность"; break;
+		case STR_PS_PD_ALG1_SAMPLE_RATE: str = "Алг1-4 Частота дискретизации (Гц)"; break;
+		case STR_PS_PD_ALG1_BUF_SIZE: str = "Алг1-4 Буфер (мс)"; break;
+		case STR_PS_PD_ALG1_BUF_OVERLAP: str = "Алг1-4 Перекрытие буферов"; break;
+		case STR_PS_PD_ALG1_ABS_THRESHOLD: str = "Алг1,4 Чувствительность"; break;
 		case STR_PS_ENV_SCALING: str = "Зависим. длины огиб. от ноты"; break;
 		case STR_PS_VOL_SCALING: str = "Зависим. громк. от ноты"; break;
 		case STR_PS_VEL_SENS: str = "Влияние динамики"; break;
@@ -532,6 +532,9 @@ const char* ps_get_string( ps_string str_id )
 		case STR_PS_JMP_TO_RL_PAT_AFTER_LAST_NOTEOFF: str = "Перейти на паттерн RL после последней Note OFF"; break;
 		case STR_PS_ADJUST_TO_LENGTH: str = "Подстроить под длину (без ресэмплинга)"; break;
 		case STR_PS_REVERSE: str = "Реверс"; break;
+		case STR_PS_LOOKAHEAD: str = "Упреждение"; break;
+		case STR_PS_PD_ALG1_CONFIDENCE: str = "Алг1,4 Достоверность"; break;
+		case STR_PS_PD_ALG1_CONFIDENCE_OUT_CTL: str = "Алг1,4 Достоверность: вых.контроллер"; break;
         	default: break;
             }
             if( str ) break;
@@ -564,7 +567,7 @@ const char* ps_get_string( ps_string str_id )
     	    case STR_PS_MODULATION_TYPES: str = "amplitude (mul);phase;phase (absolute);add;sub;min;max;bitwise AND;bitwise XOR;min abs;max abs"; break;
     	    case STR_PS_MODULATION_TYPES2: str = "phase;frequency;amplitude (mul);add;sub;min;max;bitwise AND;bitwise XOR;phase+;min abs;max abs"; break;
 	    case STR_PS_INTERP_TYPES:
-    	    case STR_PS_SAMPLE_INTERP_TYPES: str = "off;linear;spline"; break;
+    	    case STR_PS_SAMPLE_INTERP_TYPES: str = "off;linear;spline;sinc8;sinc16;sinc32"; break;
     	    case STR_PS_ENVELOPE_INTERP_TYPES: str = "off;linear"; break;
     	    case STR_PS_HARMONIC_TYPES: str = "hsin;rect;org1;org2;org3;org4;sin;random;triangle1;triangle2;overtones1;overtones2;overtones3;overtones4;overtones1+;overtones2+;overtones3+;overtones4+;metal"; break;
     	    case STR_PS_VOWEL_TYPES: str = "a;e;i;o;u"; break;
@@ -576,7 +579,7 @@ const char* ps_get_string( ps_string str_id )
     	    case STR_PS_PITCH2CTL_NOTEOFF_ACTION: str = "do nothing;pitch down;pitch up"; break;
     	    case STR_PS_VELOCITY2CTL_NOTEOFF_ACTION: str = "do nothing;vel.down;vel.up"; break;
     	    case STR_PS_METAMODULE_PLAY_PAT_MODES: str = "off;on (repeat);on (no repeat);on (repeat, endless);on (no repeat, endless)"; break;
-    	    case STR_PS_COMPRESSOR_MODES: str = "peak;RMS;peak zero latency"; break;
+    	    case STR_PS_COMPRESSOR_MODES: str = "peak;RMS;peak zero latency;limiter;limiter (true peak)"; break;
     	    case STR_PS_DISTORTION_TYPES: str = "clipping;foldback;foldback2;foldback3;overflow;overflow2;saturation+foldback;saturation+foldback(sin);saturation3;saturation4;saturation5"; break;
     	    case STR_PS_STOP_START: str = "stop;start"; break;
     	    case STR_PS_ADSR_CURVE_TYPES: str = "linear;exp1;exp2;-exp1;-exp2;sin;rect;smooth rect;2bit;3bit;4bit;5bit"; break;
@@ -587,7 +590,7 @@ const char* ps_get_string( ps_string str_id )
     	    case STR_PS_ADSR_OFF_ON_REPEAT: str = "off;on;repeat"; break;
     	    case STR_PS_NOTEON_MODES: str = "-;on pitch change"; break;
     	    case STR_PS_NOTEOFF_MODES: str = "-;on min pitch;on max pitch"; break;
-    	    case STR_PS_PD_ALGS: str = "fast (zero crossing);autocorrelation;cepstrum;spectral peak"; break;
+    	    case STR_PS_PD_ALGS: str = "fast (zero crossing);autocorrelation;cepstrum;spectral peak;McLeod (NSDF)"; break;
     	    case STR_PS_PITCHSHIFTER_PLAYORIG_MODES: str = "off;slow transition;fast transition"; break;
     	    case STR_PS_CAPTURE_MODES: str = "off;single cycle;continuous"; break;
     	    case STR_PS_FM2_WAVE_TYPES: str = "custom;triangle;triangle^3;saw;saw^3;square;sin;hsin;asin;sin^3"; break;
@@ -988,10 +991,10 @@ const char* ps_get_string( ps_string str_id )
     	    case STR_PS_DETECTOR_FINETUNE: str = "Detector finetune"; break;
     	    case STR_PS_LP_FILTER_FREQ: str = "LP filter freq (0 - OFF)"; break;
 	    case STR_PS_LP_FILTER_ROLLOFF: str = "LP filter roll-off"; break;
-	    case STR_PS_PD_ALG1_SAMPLE_RATE: str = "Alg1-2 Sample rate (Hz)"; break;
-	    case STR_PS_PD_ALG1_BUF_SIZE: str = "Alg1-2 Buffer (ms)"; break;
-	    case STR_PS_PD_ALG1_BUF_OVERLAP: str = "Alg1-2 Buf overlap"; break;
-	    case STR_PS_PD_ALG1_ABS_THRESHOLD: str = "Alg1 Sensitivity (absolute threshold)"; break;
+	    case STR_PS_PD_ALG1_SAMPLE_RATE: str = "Alg1-4 Sample rate (Hz)"; break;
+	    case STR_PS_PD_ALG1_BUF_SIZE: str = "Alg1-4 Buffer (ms)"; break;
+	    case STR_PS_PD_ALG1_BUF_OVERLAP: str = "Alg1-4 Buf overlap"; break;
+	    case STR_PS_PD_ALG1_ABS_THRESHOLD: str = "Alg1,4 Sensitivity (absolute threshold)"; break;
 	    case STR_PS_ENV_SCALING: str = "Envelope scaling per key"; break;
 	    case STR_PS_VOL_SCALING: str = "Volume scaling per key"; break;
 	    case STR_PS_VEL_SENS: str = "Velocity sensitivity"; break;
@@ -1033,6 +1036,9 @@ const char* ps_get_string( ps_string str_id )
 	    case STR_PS_JMP_TO_RL_PAT_AFTER_LAST_NOTEOFF: str = "Jump to RL pattern after last Note OFF"; break;
 	    case STR_PS_ADJUST_TO_LENGTH: str = "Adjust to specified length (without resampling)"; break;
     	    case STR_PS_REVERSE: str = "Reverse"; break;
+    	    case STR_PS_LOOKAHEAD: str = "Look-ahead"; break;
+    	    case STR_PS_PD_ALG1_CONFIDENCE: str = "Alg1,4 Confidence"; break;
+    	    case STR_PS_PD_ALG1_CONFIDENCE_OUT_CTL: str = "Alg1,4 Confidence OUT ctl"; break;
     	    default: break;
         }
         break;
@@ -502,6 +502,9 @@ enum ps_string
     STR_PS_JMP_TO_RL_PAT_AFTER_LAST_NOTEOFF,
     STR_PS_ADJUST_TO_LENGTH,
     STR_PS_REVERSE,
+    STR_PS_LOOKAHEAD,
+    STR_PS_PD_ALG1_CONFIDENCE,
+    STR_PS_PD_ALG1_CONFIDENCE_OUT_CTL,
 };
 
 const char* ps_get_string( ps_string str_id );
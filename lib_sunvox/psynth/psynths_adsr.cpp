@@ -226,6 +226,20 @@ psynth_buf_state adsr_env_run( adsr_env* a, PS_STYPE* RESTRICT out, int frames,
 	}
     }
     int i = 0;
+    if( ( a->state_flags & ( STATE_FLAG_D | STATE_FLAG_R ) ) == STATE_FLAG_D && a->v == 0 && a->ctl_sustain == 1 )
+    {
+	//Sustain: the level is constant until the note is released:
+	int v = get_curve_val( 0, a->ctl_dcurve );
+	int v2 = get_curve_val( a->v2 >> 15, a->ctl_rcurve );
+	v = ( ( v * ( 32768 - a->ctl_s ) ) >> 15 ) + a->ctl_s;
+	PS_STYPE sv;
+#ifdef PS_STYPE_FLOATINGPOINT
+	sv = (PS_STYPE)( v * v2 ) / (PS_STYPE)( 1 << 30 );
+#else
+	sv = ( v * v2 ) >> ( 30 - PS_STYPE_BITS );
+#endif
+	for( ; i < frames; i++ ) out[ i ] = sv;
+    }
     for( ; i < frames; i++ )
     {
 	if( a->state_flags & STATE_FLAG_R )
@@ -34,11 +34,18 @@ IN THE SOFTWARE.
 #define MODULE_OUTPUTS	2
 #define COMPRESSOR_BUF_SIZE 512 
 #define COMPRESSOR_SCOPE_SIZE 2048
+#ifdef PS_STYPE_FLOATINGPOINT
+    #define LIMITER_SUM_TYPE double
+#else
+    #define LIMITER_SUM_TYPE int64_t
+#endif
 enum
 {
     compressor_mode_peak = 0,
     compressor_mode_rms,
     compressor_mode_peak_zero_latency,
+    compressor_mode_limiter,
+    compressor_mode_limiter_true_peak,
     compressor_modes
 };
 struct MODULE_DATA
@@ -50,6 +57,7 @@ struct MODULE_DATA
     PS_CTYPE	ctl_release;
     PS_CTYPE	ctl_peakmode;
     PS_CTYPE	ctl_sidechain;
+    PS_CTYPE	ctl_lookahead;
     int		alg_version; 
     int		tick_counter;
     int		tick_size; 
@@ -78,10 +86,209 @@ struct MODULE_DATA
     PS_STYPE2 	slope;
     PS_STYPE2 	attack_coef; 
     PS_STYPE2 	release_coef; 
+    //Look-ahead limiter:
+    int		lim_len; //look-ahead (frames)
+    int		lim_ext; //additional delay of the true peak detector
+    bool	lim_active;
+    uint	lim_mask; //size of the buffers - 1
+    PS_STYPE*	lim_buf[ MODULE_OUTPUTS ]; //delay line
+    PS_STYPE2*	lim_gain; //gain history (for the moving average)
+    PS_STYPE2*	lim_q_val; //monotonic deque of peaks (sliding window maximum)
+    uint*	lim_q_pos; //positions of the deque items
+    uint	lim_q_head;
+    uint	lim_q_tail;
+    uint	lim_pos;
+    LIMITER_SUM_TYPE lim_gain_sum;
+    PS_STYPE2	lim_env; //fixed point: PS_STYPE_ONE * PS_STYPE_ONE = 1.0
+    PS_STYPE2	lim_tp[ MODULE_OUTPUTS * 3 ]; //previous samples for the true peak detector
 #ifdef SUNVOX_GUI
     window_manager* wm;
 #endif
 };
+static void compressor_limiter_reset( MODULE_DATA* data )
+{
+    if( !data->lim_gain ) return;
+    uint size = data->lim_mask + 1;
+    for( int ch = 0; ch < MODULE_OUTPUTS; ch++ ) smem_clear( data->lim_buf[ ch ], size * sizeof( PS_STYPE ) );
+    for( uint i = 0; i < size; i++ ) data->lim_gain[ i ] = PS_STYPE_ONE;
+    data->lim_q_head = 0;
+    data->lim_q_tail = 0;
+    data->lim_pos = 0;
+    data->lim_gain_sum = (LIMITER_SUM_TYPE)PS_STYPE_ONE * ( data->lim_len + 1 );
+    data->lim_env = PS_STYPE_ONE * PS_STYPE_ONE;
+    for( int i = 0; i < MODULE_OUTPUTS * 3; i++ ) data->lim_tp[ i ] = 0;
+}
+#define LIMITER_MAX_LOOKAHEAD 100 //ms (max value of the Look-ahead ctl)
+//Called outside of the audio callback: the buffers are allocated once for the max look-ahead:
+static void compressor_limiter_alloc( MODULE_DATA* data, psynth_net* pnet )
+{
+    uint size = 1;
+    while( size < (uint)( LIMITER_MAX_LOOKAHEAD * pnet->sampling_freq / 1000 + 2 + 4 ) ) size <<= 1;
+    if( data->lim_gain && size == data->lim_mask + 1 ) return;
+    for( int ch = 0; ch < MODULE_OUTPUTS; ch++ ) data->lim_buf[ ch ] = SMEM_ZRESIZE2( data->lim_buf[ ch ], PS_STYPE, size );
+    data->lim_gain = SMEM_ZRESIZE2( data->lim_gain, PS_STYPE2, size );
+    data->lim_q_val = SMEM_ZRESIZE2( data->lim_q_val, PS_STYPE2, size );
+    data->lim_q_pos = SMEM_ZRESIZE2( data->lim_q_pos, uint, size );
+    if( !data->lim_buf[ 0 ] || !data->lim_buf[ 1 ] || !data->lim_gain || !data->lim_q_val || !data->lim_q_pos )
+    {
+	//Not enough memory: the limiter modes will work as "peak (zero latency)":
+	for( int ch = 0; ch < MODULE_OUTPUTS; ch++ ) { smem_free( data->lim_buf[ ch ] ); data->lim_buf[ ch ] = NULL; }
+	smem_free( data->lim_gain ); data->lim_gain = NULL;
+	smem_free( data->lim_q_val ); data->lim_q_val = NULL;
+	smem_free( data->lim_q_pos ); data->lim_q_pos = NULL;
+	data->lim_mask = 0;
+	data->lim_active = false;
+	return;
+    }
+    data->lim_mask = size - 1;
+    data->lim_active = false;
+    data->ctls_changed = true;
+}
+//Called from the audio callback: no memory allocation here:
+static void compressor_limiter_init( MODULE_DATA* data, psynth_net* pnet )
+{
+    int len = data->ctl_lookahead * pnet->sampling_freq / 1000;
+    int ext = 0;
+    if( data->ctl_peakmode == compressor_mode_limiter_true_peak ) ext = 2; //the interpolator needs two more samples
+    if( !data->lim_gain || (uint)( len + ext + 4 ) > data->lim_mask + 1 )
+    {
+	data->lim_active = false;
+	return;
+    }
+    if( data->lim_active && len == data->lim_len && ext == data->lim_ext ) return;
+    data->lim_active = true;
+    data->lim_len = len;
+    data->lim_ext = ext;
+    compressor_limiter_reset( data );
+}
+//Peak of the 4x upsampled signal (same interpolator as in psynth_oversampler) between the two previous samples + current sample:
+static inline PS_STYPE2 compressor_true_peak( PS_STYPE2* prev, PS_STYPE2 y3 )
+{
+    PS_STYPE2 y0 = prev[ 0 ];
+    PS_STYPE2 y1 = prev[ 1 ];
+    PS_STYPE2 y2 = prev[ 2 ];
+    prev[ 0 ] = y1;
+    prev[ 1 ] = y2;
+    prev[ 2 ] = y3;
+    PS_STYPE2 a = ( 3 * ( y1 - y2 ) - y0 + y3 ) / 2;
+    PS_STYPE2 b = 2 * y2 + y0 - ( 5 * y1 + y3 ) / 2;
+    PS_STYPE2 c = ( y2 - y0 ) / 2;
+#ifdef PS_STYPE_FLOATINGPOINT
+    PS_STYPE2 v1 = ( ( ( a * 0.25 ) + b ) * 0.25 + c ) * 0.25 + y1;
+    PS_STYPE2 v2 = ( ( ( a * 0.5 ) + b ) * 0.5 + c ) * 0.5 + y1;
+    PS_STYPE2 v3 = ( ( ( a * 0.75 ) + b ) * 0.75 + c ) * 0.75 + y1;
+#else
+    PS_STYPE2 v1 = ( ( ( a / 4 ) + b ) / 4 + c ) / 4 + y1;
+    PS_STYPE2 v2 = ( ( ( a / 2 ) + b ) / 2 + c ) / 2 + y1;
+    PS_STYPE2 v3 = ( ( ( ( ( ( a * 3 ) / 4 ) + b ) * 3 ) / 4 + c ) * 3 ) / 4 + y1;
+#endif
+    PS_STYPE2 peak = PS_STYPE_ABS( y3 );
+    PS_STYPE2 v;
+    v = PS_STYPE_ABS( v1 ); if( v > peak ) peak = v;
+    v = PS_STYPE_ABS( v2 ); if( v > peak ) peak = v;
+    v = PS_STYPE_ABS( v3 ); if( v > peak ) peak = v;
+    return peak;
+}
+//Look-ahead limiter:
+//gain = f( max peak in the window [ pos - len - ext; pos ] ) -> instant attack + release -> moving average (len + 1 frames);
+//the signal is delayed by len + ext frames, so the gain reaches its target before the peak comes out.
+//Sliding window maximum: monotonic deque (O(1) per frame, independent of the window size).
+static void compressor_limiter_run( 
+    MODULE_DATA* data, 
+    PS_STYPE* in0, PS_STYPE* in1, PS_STYPE* sc_in0, PS_STYPE* sc_in1, 
+    PS_STYPE* out0, PS_STYPE* out1, 
+    int frames, 
+    PS_STYPE2* max_peak, PS_STYPE2* min_gain )
+{
+    uint mask = data->lim_mask;
+    uint len = data->lim_len;
+    uint window = len + 1 + data->lim_ext;
+    uint delay = len + data->lim_ext;
+    PS_STYPE* buf0 = data->lim_buf[ 0 ];
+    PS_STYPE* buf1 = data->lim_buf[ 1 ];
+    PS_STYPE2* gain_hist = data->lim_gain;
+    PS_STYPE2* q_val = data->lim_q_val;
+    uint* q_pos = data->lim_q_pos;
+    uint q_head = data->lim_q_head;
+    uint q_tail = data->lim_q_tail;
+    uint pos = data->lim_pos;
+    LIMITER_SUM_TYPE gain_sum = data->lim_gain_sum;
+    PS_STYPE2 env = data->lim_env;
+    PS_STYPE2 threshold = data->threshold;
+    PS_STYPE2 release_coef = data->release_coef;
+    bool true_peak = data->lim_ext > 0;
+#ifdef PS_STYPE_FLOATINGPOINT
+    LIMITER_SUM_TYPE gain_sum_mul = 1.0 / ( len + 1 );
+#endif
+    for( int i = 0; i < frames; i++ )
+    {
+	PS_STYPE2 peak;
+	if( true_peak )
+	{
+	    peak = compressor_true_peak( &data->lim_tp[ 0 ], sc_in0[ i ] );
+	    PS_STYPE2 v = compressor_true_peak( &data->lim_tp[ 3 ], sc_in1[ i ] ); if( v > peak ) peak = v;
+	}
+	else
+	{
+	    peak = PS_STYPE_ABS( sc_in0[ i ] );
+	    PS_STYPE2 v = PS_STYPE_ABS( sc_in1[ i ] ); if( v > peak ) peak = v;
+	}
+#ifdef SUNVOX_GUI
+	if( peak > *max_peak ) *max_peak = peak;
+#endif
+	while( q_tail != q_head && q_val[ ( q_tail - 1 ) & mask ] <= peak ) q_tail--;
+	q_val[ q_tail & mask ] = peak;
+	q_pos[ q_tail & mask ] = pos;
+	q_tail++;
+	if( pos - q_pos[ q_head & mask ] >= window ) q_head++;
+	peak = q_val[ q_head & mask ];
+	PS_STYPE2 gain = PS_STYPE_ONE;
+	if( peak > threshold )
+	{
+	    if( data->zero_threshold )
+	        gain = 0;
+	    else
+#ifdef PS_STYPE_FLOATINGPOINT
+	        gain = threshold / ( threshold + ( peak - threshold ) * data->slope );
+#else
+	        gain = ( threshold << PS_STYPE_BITS ) / ( threshold + ( ( ( peak - threshold ) * data->slope ) >> PS_STYPE_BITS ) );
+#endif
+	}
+#ifdef PS_STYPE_FLOATINGPOINT
+	if( gain < env )
+	    env = gain;
+	else
+	    env = ( 1.0 - release_coef ) * gain + release_coef * env;
+	gain_sum += env - gain_hist[ ( pos - len - 1 ) & mask ];
+	gain_hist[ pos & mask ] = env;
+	gain = gain_sum * gain_sum_mul;
+#else
+	if( ( gain << PS_STYPE_BITS ) < env )
+	    env = gain << PS_STYPE_BITS;
+	else
+	    env = ( (int64_t)( PS_STYPE_ONE * PS_STYPE_ONE - release_coef ) * ( gain << PS_STYPE_BITS ) + (int64_t)release_coef * env ) >> ( PS_STYPE_BITS * 2 );
+	gain = env >> PS_STYPE_BITS;
+	gain_sum += gain - gain_hist[ ( pos - len - 1 ) & mask ];
+	gain_hist[ pos & mask ] = gain;
+	gain = gain_sum / ( len + 1 );
+#endif
+#ifdef SUNVOX_GUI
+	if( gain < *min_gain ) *min_gain = gain;
+#endif
+	uint p = pos & mask;
+	uint p2 = ( pos - delay ) & mask;
+	buf0[ p ] = in0[ i ];
+	buf1[ p ] = in1[ i ];
+	out0[ i ] = PS_NORM_STYPE_MUL( buf0[ p2 ], gain, PS_STYPE_ONE );
+	out1[ i ] = PS_NORM_STYPE_MUL( buf1[ p2 ], gain, PS_STYPE_ONE );
+	pos++;
+    }
+    data->lim_q_head = q_head;
+    data->lim_q_tail = q_tail;
+    data->lim_pos = pos;
+    data->lim_gain_sum = gain_sum;
+    data->lim_env = env;
+}
 #ifdef SUNVOX_GUI
 struct compressor_visual_data
 {
@@ -257,7 +464,7 @@ PS_RETTYPE MODULE_HANDLER(
 	case PS_CMD_GET_OUTPUTS_NUM: retval = MODULE_OUTPUTS; break;
 	case PS_CMD_GET_FLAGS: retval = PSYNTH_FLAG_EFFECT | PSYNTH_FLAG_DONT_FILL_INPUT; break;
 	case PS_CMD_INIT:
-	    psynth_resize_ctls_storage( mod_num, 7, pnet );
+	    psynth_resize_ctls_storage( mod_num, 8, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_VOLUME ), "", 0, 512, 256, 0, &data->ctl_volume, 256, 0, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_THRESHOLD ), "", 0, 512, 256, 0, &data->ctl_threshold, 256, 1, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_SLOPE ), "%", 0, 200, 100, 0, &data->ctl_slope, 100, 1, pnet );
@@ -265,6 +472,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_RELEASE ), ps_get_string( STR_PS_MS ), 1, 1000, 300, 0, &data->ctl_release, -1, 1, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_MODE ), ps_get_string( STR_PS_COMPRESSOR_MODES ), 0, compressor_modes - 1, 0, 1, &data->ctl_peakmode, -1, 2, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_SIDE_CHAIN_INPUT ), "", 0, 32, 0, 1, &data->ctl_sidechain, -1, 2, pnet );
+	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_LOOKAHEAD ), ps_get_string( STR_PS_MS ), 0, 100, 5, 0, &data->ctl_lookahead, -1, 2, pnet );
 	    data->alg_version = 0;
 	    if( pnet->base_host_version >= 0x01070303 )
 	    {
@@ -328,6 +536,11 @@ PS_RETTYPE MODULE_HANDLER(
 	    data->gain = 0;
 	    data->gain_delta = 0;
 	    data->empty = 1;
+	    compressor_limiter_reset( data );
+	    retval = 1;
+	    break;
+	case PS_CMD_SETUP_FINISHED:
+	    compressor_limiter_alloc( data, pnet );
 	    retval = 1;
 	    break;
 	case PS_CMD_RENDER_REPLACE:
@@ -365,6 +578,10 @@ PS_RETTYPE MODULE_HANDLER(
 		    data->release_coef = 0;
 		    if( data->ctl_attack > 0 ) data->attack_coef = expf( -1.0F / ( srate * ( (float)data->ctl_attack / 1000.0F ) ) ) * PS_STYPE_ONE * PS_STYPE_ONE;
 		    if( data->ctl_release > 0 ) data->release_coef = expf( -1.0F / ( srate * ( (float)data->ctl_release / 1000.0F ) ) ) * PS_STYPE_ONE * PS_STYPE_ONE;
+		    if( data->ctl_peakmode >= compressor_mode_limiter )
+			compressor_limiter_init( data, pnet );
+		    else
+			data->lim_active = false;
 		}
 		for( int i = 0; i < mod->input_links_num; i++ )
 		{
@@ -451,7 +668,15 @@ PS_RETTYPE MODULE_HANDLER(
 			for( int i = 0; i < frames; i++ ) in0[ i ] = 0;
 			for( int i = 0; i < frames; i++ ) in1[ i ] = 0;
 		    }
-		    for( int i = 0; i < frames; i++ )
+		    if( data->lim_active )
+		    {
+#ifdef SUNVOX_GUI
+			compressor_limiter_run( data, in0, in1, sc_in0, sc_in1, out0, out1, frames, &max_peak, &min_gain );
+#else
+			compressor_limiter_run( data, in0, in1, sc_in0, sc_in1, out0, out1, frames, NULL, NULL );
+#endif
+		    }
+		    else for( int i = 0; i < frames; i++ )
 		    {
 			PS_STYPE2 v;
 			PS_STYPE2 peak = 0;
@@ -750,7 +975,11 @@ PS_RETTYPE MODULE_HANDLER(
 	    for( int ch = 0; ch < MODULE_OUTPUTS; ch++ )
 	    {
 		smem_free( data->buf[ ch ] );
+		smem_free( data->lim_buf[ ch ] );
 	    }
+	    smem_free( data->lim_gain );
+	    smem_free( data->lim_q_val );
+	    smem_free( data->lim_q_pos );
 #ifdef SUNVOX_GUI
 	    if( mod->visual && data->wm )
 	    {
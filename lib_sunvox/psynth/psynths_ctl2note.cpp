@@ -276,6 +276,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    {
         	psynth_resize_ctls_storage( mod_num, 10, pnet );
 		psynth_register_ctl( mod_num, ps_get_string( STR_PS_PITCH ), "", 0, 32768, 0, 0, &data->ctl_pitch, -1, 0, pnet );
+		psynth_set_ctl_flags( mod_num, 0, PSYNTH_CTL_FLAG_NO_COALESCING, pnet ); //trigger
 		psynth_register_ctl( mod_num, ps_get_string( STR_PS_FIRST_NOTE ), "", 0, 120, 0, 1, &data->ctl_note, -1, 0, pnet );
 		psynth_register_ctl( mod_num, ps_get_string( STR_PS_RANGE_SEMITONES ), "", 0, 120, 120, 1, &data->ctl_notes, -1, 0, pnet );
 		psynth_register_ctl( mod_num, ps_get_string( STR_PS_TRANSPOSE ), "", 0, 256, 128, 1, &data->ctl_transpose, 128, 1, pnet );
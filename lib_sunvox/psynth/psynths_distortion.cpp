@@ -128,7 +128,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_INTERPOLATION ), ps_get_string( STR_PS_INTERP_TYPES ), 0, 2, 0, 1, &data->ctl_interp, -1, 2, pnet );
 #endif
 	    data->cnt = 0;
-	    data->noise_seed = (uint32_t)stime_ns() + mod_num * 49157 + mod->id * 3079;
+	    data->noise_seed = psynth_rand_seed( mod_num, pnet ) + mod_num * 49157;
 	    SMEM_CLEAR_STRUCT( data->smp );
 	    data->smp_clean = true;
 	    data->smp_ptr = 0;
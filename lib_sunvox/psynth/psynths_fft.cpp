@@ -258,7 +258,7 @@ PS_RETTYPE MODULE_HANDLER(
 	}
 	case PS_CMD_SETUP_FINISHED:
             fft_handle_changes( mod, mod_num );
-            data->noise_seed = (uint32_t)stime_ns() + pseudo_random() + mod_num * 371 + mod->id * 3079;
+            data->noise_seed = psynth_rand_seed( mod_num, pnet ) + mod_num * 371;
             retval = 1;
             break;
 	case PS_CMD_CLEAN:
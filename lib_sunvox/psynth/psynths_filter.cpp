@@ -159,6 +159,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_LFO_FREQ ), "", 0, 1024, 8, 0, &data->ctl_lfo_freq, -1, 2, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_LFO_AMP ), "", 0, 256, 0, 0, &data->ctl_lfo_amp, -1, 2, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_SET_LFO_PHASE ), "", 0, 256, 0, 0, &data->ctl_set_lfo_phase, -1, 2, pnet );
+	    psynth_set_ctl_flags( mod_num, 10, PSYNTH_CTL_FLAG_NO_COALESCING, pnet ); //trigger
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_EXP_FREQ ), ps_get_string( STR_PS_OFF_ON ), 0, 1, 0, 1, &data->ctl_exp, -1, 0, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_ROLLOFF ), ps_get_string( STR_PS_FILTER_ROLLOFF_VALS ), 0, 3, 0, 1, &data->ctl_rolloff, -1, 0, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_LFO_FREQ_UNIT ), ps_get_string( STR_PS_FILTER_LFO_FREQ_UNITS ), 0, 6, 0, 1, &data->ctl_lfo_freq_units, -1, 2, pnet );
@@ -695,7 +696,7 @@ no_input_signal:
 		                        if( data->lfo_rand_prev != lfo_phase / 256 )
                 			{
                     			    data->lfo_rand_prev = lfo_phase / 256;
-		                            data->lfo_rand = pseudo_random() & 511;
+		                            data->lfo_rand = psynth_rand( pnet ) & 511;
 		                        }
                 			lfo_value = data->lfo_rand - 255;
 		                    }
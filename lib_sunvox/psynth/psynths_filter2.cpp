@@ -179,7 +179,7 @@ static float filter2_get_freq( MODULE_DATA* data )
     }
     return f * data->ctl_freq_scale / 100.0F;
 }
-static float filter2_get_freq_with_lfo( MODULE_DATA* data )
+static float filter2_get_freq_with_lfo( MODULE_DATA* data, psynth_net* pnet )
 {
     float freq = filter2_get_freq( data );
     if( data->ctl_lfo_amp )
@@ -232,7 +232,7 @@ static float filter2_get_freq_with_lfo( MODULE_DATA* data )
 		    if( data->lfo_rand_prev != lfo_phase / 256 )
 		    {
 			data->lfo_rand_prev = lfo_phase / 256;
-			data->lfo_rand = pseudo_random() & 511;
+			data->lfo_rand = psynth_rand( pnet ) & 511;
 		    }
 		    v = data->lfo_rand - 255;
 		}
@@ -250,20 +250,20 @@ static float filter2_get_freq_with_lfo( MODULE_DATA* data )
     }
     return freq;
 }
-static void filter2_set_floating_values( MODULE_DATA* data )
+static void filter2_set_floating_values( MODULE_DATA* data, psynth_net* pnet )
 {
-    data->floating_freq = filter2_get_freq_with_lfo( data );
+    data->floating_freq = filter2_get_freq_with_lfo( data, pnet );
     data->floating_q = data->ctl_q;
     data->floating_gain = data->ctl_gain;
     data->floating_vol = data->ctl_volume;
     data->floating_mix = data->ctl_mix;
 }
-static void filter2_floating_step( MODULE_DATA* data )
+static void filter2_floating_step( MODULE_DATA* data, psynth_net* pnet )
 {
     int r = data->ctl_response;
     if( r < 1 ) r = 1;
     float response = (float)r / (float)MAX_RESPONSE;
-    data->floating_freq = ( 1 - response ) * data->floating_freq + response * filter2_get_freq_with_lfo( data );
+    data->floating_freq = ( 1 - response ) * data->floating_freq + response * filter2_get_freq_with_lfo( data, pnet );
     data->floating_q = ( 1 - response ) * data->floating_q + response * (float)data->ctl_q;
     data->floating_gain = ( 1 - response ) * data->floating_gain + response * (float)data->ctl_gain;
     data->floating_vol = ( 1 - response ) * data->floating_vol + response * (float)data->ctl_volume;
@@ -346,6 +346,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_LFO_AMP ), "", 0, MAX_VOLUME, 0, 0, &data->ctl_lfo_amp, -1, 2, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_LFO_WAVEFORM ), ps_get_string( STR_PS_FILTER_LFO_WAVEFORM_TYPES ), 0, 4, 0, 1, &data->ctl_lfo_type, -1, 2, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_SET_LFO_PHASE ), "", 0, 256, 0, 0, &data->ctl_set_lfo_phase, -1, 2, pnet );
+	    psynth_set_ctl_flags( mod_num, 15, PSYNTH_CTL_FLAG_NO_COALESCING, pnet ); //trigger
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_LFO_FREQ_UNIT ), ps_get_string( STR_PS_FILTER_LFO_FREQ_UNITS ), 0, 6, 0, 1, &data->ctl_lfo_freq_units, -1, 2, pnet );
 	    data->ctl_oversampling = 0;
 	    {
@@ -356,7 +357,7 @@ PS_RETTYPE MODULE_HANDLER(
 		}
 		data->f = biquad_filter_new( fflags );
 	    }
-	    filter2_set_floating_values( data );
+	    filter2_set_floating_values( data, pnet );
 	    data->tick_counter = 0;
 	    data->lfo_phase = 0;
 	    data->lfo_rand = 0;
@@ -385,7 +386,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    break;
 	case PS_CMD_SETUP_FINISHED:
 	    SET_PHASE( 1 );
-	    filter2_set_floating_values( data );
+	    filter2_set_floating_values( data, pnet );
 	    retval = 1;
 	    break;
 	case PS_CMD_CLEAN:
@@ -465,7 +466,7 @@ PS_RETTYPE MODULE_HANDLER(
 		    tick_size = ( pnet->sampling_freq * 256 ) / 200; 
 		if( data->ctl_response == MAX_RESPONSE )
 		{
-		    filter2_floating_step( data );
+		    filter2_floating_step( data, pnet );
 		}
 		int ptr = 0;
 		while( 1 )
@@ -566,7 +567,7 @@ PS_RETTYPE MODULE_HANDLER(
 		    data->tick_counter += size * 256;
 		    if( data->tick_counter >= tick_size ) 
 		    {
-			filter2_floating_step( data );
+			filter2_floating_step( data, pnet );
 			data->tick_counter %= tick_size;
 			switch( data->ctl_lfo_freq_units )
 			{
@@ -675,7 +676,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    }
 	    break;
 	case PS_CMD_APPLY_CONTROLLERS:
-	    filter2_set_floating_values( data );
+	    filter2_set_floating_values( data, pnet );
 	    data->first_reinit_without_interp = true;
 	    retval = 1;
 	    break;
@@ -126,6 +126,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_LFO_AMP ), "", 0, 256, 32, 0, &data->ctl_vibrato_amp, -1, 2, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_LFO_WAVEFORM ), "hsin;sin", 0, 1, 0, 1, &data->ctl_vibrato_type, -1, 2, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_SET_LFO_PHASE ), "", 0, 256, 0, 0, &data->ctl_set_vibrato_phase, -1, 2, pnet );
+	    psynth_set_ctl_flags( mod_num, 8, PSYNTH_CTL_FLAG_NO_COALESCING, pnet ); //trigger
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_LFO_FREQ_UNIT ), ps_get_string( STR_PS_FLANGER_LFO_FREQ_UNITS ), 0, 6, 0, 1, &data->ctl_vibrato_speed_units, -1, 2, pnet );
 	    data->buf_size = pnet->sampling_freq / 64;
 	    for( int i = 0; i < MODULE_OUTPUTS; i++ )
@@ -29,6 +29,9 @@ IN THE SOFTWARE.
 #include "psynth_net.h"
 #include "sunvox_engine.h"
 #include "psynths_adsr.h"
+#if defined(PS_STYPE_FLOATINGPOINT) && defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
 #define MODULE_DATA	psynth_fm2_data
 #define MODULE_HANDLER	psynth_fm2
 #define MODULE_VDATA	fm2_visual_data
@@ -722,6 +725,24 @@ inline PS_STYPE get_wave_sample( PS_STYPE* wave, uint32_t ptr )
     return ( (PS_STYPE2)wave[ ptr_h & WAVETABLE_MASK ] * ( 32768 - ptr_l ) + (PS_STYPE2)wave[ ( ptr_h + 1 ) & WAVETABLE_MASK ] * ptr_l ) / 32768;
 #endif
 }
+#if defined(PS_STYPE_FLOATINGPOINT) && defined(__SSE2__)
+#define FM2_SIMD
+//get_wave_sample() for 4 phases:
+inline __m128 get_wave_sample_x4( PS_STYPE* wave, __m128i ptr )
+{
+    __m128i h = _mm_srli_epi32( ptr, PHASE_BITS - WAVETABLE_BITS );
+    __m128i h2 = _mm_and_si128( _mm_add_epi32( h, _mm_set1_epi32( 1 ) ), _mm_set1_epi32( WAVETABLE_MASK ) );
+    h = _mm_and_si128( h, _mm_set1_epi32( WAVETABLE_MASK ) );
+    __m128 l = _mm_cvtepi32_ps( _mm_and_si128( _mm_slli_epi32( ptr, 16 - ( PHASE_BITS - WAVETABLE_BITS ) ), _mm_set1_epi32( 65535 ) ) );
+    l = _mm_mul_ps( l, _mm_set1_ps( 1.0F / 65536.0F ) );
+    alignas( 16 ) int hh[ 8 ];
+    _mm_store_si128( (__m128i*)hh, h );
+    _mm_store_si128( (__m128i*)( hh + 4 ), h2 );
+    __m128 y1 = _mm_setr_ps( wave[ hh[ 0 ] ], wave[ hh[ 1 ] ], wave[ hh[ 2 ] ], wave[ hh[ 3 ] ] );
+    __m128 y2 = _mm_setr_ps( wave[ hh[ 4 ] ], wave[ hh[ 5 ] ], wave[ hh[ 6 ] ], wave[ hh[ 7 ] ] );
+    return _mm_add_ps( _mm_mul_ps( y1, _mm_sub_ps( _mm_set1_ps( 1.0F ), l ) ), _mm_mul_ps( y2, l ) );
+}
+#endif
 inline PS_STYPE get_wave_sample2( PS_STYPE* wave, uint32_t ptr, PS_STYPE2 selfmod ) 
 {
     PS_STYPE2 v = get_wave_sample( wave, ptr );
@@ -805,11 +826,24 @@ inline void fm2_op_gen( MODULE_DATA* data, gen_channel* chan, int opn, int frame
 		    ptr += delta;
 		}
 	    else
-		for( int i = 0; i < frames; i++ )
+	    {
+		int i = 0;
+#ifdef FM2_SIMD
+		__m128i ptr4 = _mm_add_epi32( _mm_set1_epi32( ptr ), _mm_setr_epi32( 0, (uint32_t)delta, (uint32_t)delta * 2, (uint32_t)delta * 3 ) );
+		__m128i delta4 = _mm_set1_epi32( (uint32_t)delta * 4 );
+		for( ; i + 4 <= frames; i += 4 )
+		{
+		    _mm_storeu_ps( &buf[ i ], get_wave_sample_x4( wave, ptr4 ) );
+		    ptr4 = _mm_add_epi32( ptr4, delta4 );
+		}
+		ptr += (uint32_t)delta * i;
+#endif
+		for( ; i < frames; i++ )
 		{
 		    buf[ i ] = get_wave_sample( wave, ptr );
 		    ptr += delta;
 		}
+	    }
 	    switch( mod_type )
 	    {
 		case mod_type_sub:
@@ -937,7 +971,27 @@ inline void fm2_op_gen( MODULE_DATA* data, gen_channel* chan, int opn, int frame
 			ptr += delta;
 		    }
 		else
-		    for( int i = 0; i < frames; i++ )
+		{
+		    int i = 0;
+#ifdef FM2_SIMD
+		    if( target_feedback == 0 && frames >= 4 )
+		    {
+			//No feedback: the frames are independent
+			__m128i ptr4 = _mm_add_epi32( _mm_set1_epi32( ptr ), _mm_setr_epi32( 0, (uint32_t)delta, (uint32_t)delta * 2, (uint32_t)delta * 3 ) );
+			__m128i delta4 = _mm_set1_epi32( (uint32_t)delta * 4 );
+			for( ; i + 4 <= frames; i += 4 )
+			{
+			    __m128i ptr2 = _mm_add_epi32( ptr4, _mm_cvttps_epi32( _mm_mul_ps( _mm_loadu_ps( &buf[ i ] ), _mm_set1_ps( 1 << PHASE_BITS ) ) ) );
+			    _mm_storeu_ps( &buf[ i ], get_wave_sample_x4( wave, ptr2 ) );
+			    ptr4 = _mm_add_epi32( ptr4, delta4 );
+			}
+			ptr += (uint32_t)delta * i;
+			PS_STYPE2 v = buf[ i - 1 ];
+			if( feedback_env ) v = v * env_buf[ i - 1 ] / PS_STYPE_ONE;
+			op->feedback_val = v;
+		    }
+#endif
+		    for( ; i < frames; i++ )
 		    {
 			PS_STYPE2 v = buf[ i ];
 			v += PS_NORM_STYPE_MUL( op->feedback_val, target_feedback, 32768 );
@@ -952,6 +1006,7 @@ inline void fm2_op_gen( MODULE_DATA* data, gen_channel* chan, int opn, int frame
 			op->feedback_val = v;
 			ptr += delta;
 		    }
+		}
 		break;
 	    case mod_type_freq:
 		if( target_selfmod )
@@ -1329,7 +1384,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    {
 		gen_channel* chan = &data->channels[ c ];
 		gen_channel_reset( chan );
-		chan->noise_seed = (uint32_t)stime_ns() + pseudo_random() + mod_num * 3 + c * 7 + mod->id * 3079;
+		chan->noise_seed = psynth_rand_seed( mod_num, pnet ) + mod_num * 3 + c * 7;
 		for( int opn = 0; opn < NUM_OPS; opn++ )
 		{
 		    fm2_operator* op = &chan->ops[ opn ];
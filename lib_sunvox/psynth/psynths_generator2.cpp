@@ -824,6 +824,29 @@ static uint64_t gen2_render_sin( MODULE_DATA* data, PS_STYPE2 vol, PS_STYPE* RES
     }
     return ptr;
 }
+//PolyBLEP residual for the step +1 at phase 0 (LQ saw/square);
+//t = phase; dt = phase increment per frame (0...65535 = 0...1); retval = -65536...65536 (-1...1):
+static inline int gen2_polyblep( int t, int dt )
+{
+    if( t < dt )
+    {
+	int64_t x = ( (int64_t)t << 16 ) / dt;
+	return (int)( 2 * x - ( ( x * x ) >> 16 ) - 65536 );
+    }
+    if( t > 65536 - dt )
+    {
+	int64_t x = ( (int64_t)( t - 65536 ) << 16 ) / dt;
+	return (int)( ( ( x * x ) >> 16 ) + 2 * x + 65536 );
+    }
+    return 0;
+}
+static inline int gen2_polyblep_dt( uint64_t delta, int shift )
+{
+    uint64_t dt = delta >> shift;
+    if( dt < 1 ) dt = 1;
+    if( dt > 32768 ) dt = 32768; //max 0.5 (no overlap)
+    return (int)dt;
+}
 static void gen2_render_waveform( MODULE_DATA* data, gen2_channel* chan, int subchan, bool no_wave, bool add, PS_STYPE* RESTRICT render_buf, int frames )
 {
     gen2_subchannel* sc = &chan->sc[ subchan ];
@@ -906,11 +929,13 @@ static void gen2_render_waveform( MODULE_DATA* data, gen2_channel* chan, int sub
 	case gen_type_saw: 
 	    if( data->ctl_mode > MODE_HQ_MONO )
 	    {
+		int dt = gen2_polyblep_dt( delta, 4 );
 	        for( int i = 0; i < frames; i++ )
 	        {
 	    	    PS_STYPE2 v;
 		    int ptr = wave_ptr >> 4;
 		    int acc = 32767 - ( ptr & 0xFFFF );
+		    acc += ( gen2_polyblep( ptr & 0xFFFF, dt ) * 32767 ) >> 16;
 		    PS_INT16_TO_STYPE( v, acc );
 		    if( add ) render_buf[ i ] += v; else render_buf[ i ] = v;
 		    wave_ptr += delta;
@@ -957,14 +982,24 @@ static void gen2_render_waveform( MODULE_DATA* data, gen2_channel* chan, int sub
 	        PS_STYPE2 dc = -( ( duty_cycle - MAX_DUTY_CYCLE / 2 ) * PS_STYPE_ONE ) / ( MAX_DUTY_CYCLE / 2 );
 	        if( data->ctl_mode > MODE_HQ_MONO )
 	        {
+		    int dt = gen2_polyblep_dt( delta, 5 );
+		    bool edges = duty_cycle > 0 && duty_cycle < MAX_DUTY_CYCLE;
 		    for( int i = 0; i < frames; i++ )
 		    {
 			PS_STYPE2 v;
 			int ptr = wave_ptr >> 5;
-			if( ( ptr & 0xFFFF ) / 64 < duty_cycle )
-			    v = PS_STYPE_ONE;
+			int phase = ptr & 0xFFFF;
+			int acc;
+			if( phase / 64 < duty_cycle )
+			    acc = 32768;
 			else
-			    v = -PS_STYPE_ONE;
+			    acc = -32768;
+			if( edges )
+			{
+			    acc += gen2_polyblep( phase, dt ) >> 1;
+			    acc -= gen2_polyblep( ( phase - duty_cycle * 64 ) & 0xFFFF, dt ) >> 1;
+			}
+			PS_INT16_TO_STYPE( v, acc );
 			v += dc;
 			if( add ) render_buf[ i ] += v; else render_buf[ i ] = v;
 			wave_ptr += delta;
@@ -1995,7 +2030,7 @@ PS_RETTYPE MODULE_HANDLER(
 		for( int i = 0; i < MAX_SUBCHANNELS; i++ )
 		{
 		    gen2_subchannel* sc = &data->channels[ c ].sc[ i ];
-		    sc->noise_seed = (uint32_t)stime_ns() + pseudo_random() + mod_num * 3 + i * 7 + mod->id * 3079;
+		    sc->noise_seed = psynth_rand_seed( mod_num, pnet ) + mod_num * 3 + i * 7;
 		}
 	    }
 	    data->no_active_channels = 1;
@@ -2003,8 +2038,8 @@ PS_RETTYPE MODULE_HANDLER(
 	    memmove( data->drawn_wave, g_gen_drawn_waveform, 32 );
 	    data->linear_freq_tab = g_linear_freq_tab;
 	    data->vibrato_tab = g_hsin_tab;
-	    data->noise_seed = (uint32_t)stime_ns() + pseudo_random() + 11 + mod->id * 3079;
-	    data->random_seed = (uint32_t)stime_ns() + pseudo_random() + 22 + mod->id * 3079;
+	    data->noise_seed = psynth_rand_seed( mod_num, pnet ) + 11;
+	    data->random_seed = psynth_rand_seed( mod_num, pnet ) + 22;
 	    psmoother_init( &data->smoother_coefs, 100, pnet->sampling_freq );
 	    psynth_get_temp_buf( mod_num, pnet, 0 ); 
 #ifndef ONLY44100
@@ -171,6 +171,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_FREQ ), "", 1, 2048, 256, 0, &data->ctl_freq, -1, 1, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_WAVEFORM_TYPE ), ps_get_string( STR_PS_LFO_WAVEFORM_TYPES ), 0, 7, 2, 1, &data->ctl_shape, -1, 1, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_SET_PHASE ), "", 0, 256, 0, 0, &data->ctl_set_phase, -1, 1, pnet );
+	    psynth_set_ctl_flags( mod_num, 5, PSYNTH_CTL_FLAG_NO_COALESCING, pnet ); //trigger
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_CHANNELS ), ps_get_string( STR_PS_STEREO_MONO ), 0, 1, 0, 1, &data->ctl_mono, -1, 0, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_FREQ_UNIT ), ps_get_string( STR_PS_LFO_FREQ_UNITS ), 0, FREQ_UNIT_MAX, 0, 1, &data->ctl_freq_units, -1, 1, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_DUTY_CYCLE ), "", 0, MAX_DUTY_CYCLE, MAX_DUTY_CYCLE / 2, 0, &data->ctl_duty_cycle, MAX_DUTY_CYCLE / 2, 1, pnet );
@@ -186,7 +187,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    data->rand = 0;
 	    data->rand_prev = 0;
             data->rand_prev_phase = 0;
-            data->rand_seed = (uint32_t)stime_ns() + pseudo_random() + mod_num * 49157 + mod->id * 3079;
+            data->rand_seed = psynth_rand_seed( mod_num, pnet ) + mod_num * 49157;
 	    data->sin_tab = (uint16_t*)psynth_get_sine_table( 2, false, 9, 65535 );
 	    data->recalc_delta = true;
 	    retval = 1;
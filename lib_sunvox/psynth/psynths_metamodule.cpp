@@ -223,6 +223,7 @@ static void metamodule_unpack_user_ctls( int mod_num, psynth_net* pnet )
     			ctl->normal_value = ctl2->normal_value;
     			ctl->show_offset = ctl2->show_offset;
     			ctl->type = ctl2->type;
+    			ctl->flags = ( ctl->flags & ~PSYNTH_CTL_FLAG_NO_COALESCING ) | ( ctl2->flags & PSYNTH_CTL_FLAG_NO_COALESCING ); //trigger
     		    }
     		}
 	    } 
@@ -272,6 +273,8 @@ static void metamodule_check_auto_bpm_tpl( psynth_module* mod, psynth_net* pnet,
     		s->bpm = bpm;
     		s->speed = tpl;
     	    }
+    	    s->proj_bpm = s->bpm;
+    	    s->proj_speed = s->speed;
     	    data->ctl_bpm = s->bpm;
     	    data->ctl_tpl = s->speed;
     	    mod->draw_request++;
@@ -77,6 +77,7 @@ static int multictl_curve_val( int mod_num, psynth_net* pnet, int pos, int val,
 static void multictl_curve_set_vals( int mod_num, psynth_net* pnet, int pos, int val, int vals );
 static int multictl_get_curve_val( int input, uint16_t* curve );
 static int multictl_get_val( int val, uint16_t* val_curve, multictl_output_slot* slot, MODULE_DATA* data );
+static void multictl_update_coalescing( int mod_num, psynth_net* pnet );
 #define FOR_EACH_SLOT \
     for( int slot_n = 0, link_n = 0; slot_n < MULTICTL_SLOTS; slot_n++ ) \
     { \
@@ -197,6 +198,7 @@ static int multictl_slot_ctl_handler( void* user_data, WINDOWPTR win, window_man
 	{
 	    int val = scrollbar_get_value( win, wm );
 	    slots[ slot ].ctl = val;
+	    multictl_update_coalescing( data->mod_num, data->pnet );
 	    draw_window( data->win, wm );
 	    data->pnet->change_counter++;
 	}
@@ -924,6 +926,26 @@ static void multictl_send( int mod_num, psynth_net* pnet, int val, int offset )
 	}
     }
 }
+//Value is a relay: it must deliver every write, if there is a trigger among the output ctls (see psynth_add_event())
+static void multictl_update_coalescing( int mod_num, psynth_net* pnet )
+{
+    psynth_module* mod = &pnet->mods[ mod_num ];
+    MODULE_DATA* data = (MODULE_DATA*)mod->data_ptr;
+    if( !data || !mod->ctls || mod->ctls_num == 0 ) return; //removed module
+    multictl_output_slot* slots = data->slots;
+    if( !slots ) return;
+    bool coalescing = true;
+    FOR_EACH_SLOT
+	if( slot->ctl != 0 && m->ctls && (unsigned)( slot->ctl - 1 ) < m->ctls_num )
+	{
+	    if( !psynth_ctl_coalescing( &m->ctls[ slot->ctl - 1 ] ) ) coalescing = false;
+	}
+    }
+    if( coalescing )
+	mod->ctls[ 0 ].flags &= ~PSYNTH_CTL_FLAG_NO_COALESCING;
+    else
+	mod->ctls[ 0 ].flags |= PSYNTH_CTL_FLAG_NO_COALESCING;
+}
 #define VAL_FORMULA_DESC "out=quant(curve(in))+offset"
 PS_RETTYPE MODULE_HANDLER( 
     PSYNTH_MODULE_HANDLER_PARAMETERS
@@ -1026,12 +1048,14 @@ PS_RETTYPE MODULE_HANDLER(
 		multictl_create_curve( mod_num, pnet );
 		data->floating_val = data->ctl_val;
 		multictl_calc_pars( data, pnet );
+		multictl_update_coalescing( mod_num, pnet );
 	    }
 	    retval = 1;
 	    break;
 	case PS_CMD_CLEAN:
 	    data->floating_val = data->ctl_val;
 	    data->tick_counter = 0;
+	    multictl_update_coalescing( mod_num, pnet );
 #ifdef SUNVOX_GUI
 	    {
         	psynth_ctl* ctl = &mod->ctls[ 0 ];
@@ -1044,8 +1068,9 @@ PS_RETTYPE MODULE_HANDLER(
 #endif
 	    retval = 1;
 	    break;
-#ifdef SUNVOX_GUI
 	case PS_CMD_OUTPUT_LINKS_CHANGED:
+	    multictl_update_coalescing( mod_num, pnet );
+#ifdef SUNVOX_GUI
 	    {
 		if( mod->visual )
 		{
@@ -1054,9 +1079,9 @@ PS_RETTYPE MODULE_HANDLER(
         	}
 		mod->full_redraw_request++;
 	    }
+#endif
 	    retval = 1;
 	    break;
-#endif
 	case PS_CMD_SET_LOCAL_CONTROLLER:
 	case PS_CMD_SET_GLOBAL_CONTROLLER:
 	    if( mod->realtime_flags & PSYNTH_RT_FLAG_MUTE ) break;
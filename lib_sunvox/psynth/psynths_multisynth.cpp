@@ -976,7 +976,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_RANDOM_VELOCITY ), "", 0, 0x8000, 0, 0, &data->ctl_random_velocity, -1, 1, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_PHASE ), "", 0, 0x8000, 0, 0, &data->ctl_phase, -1, 0, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_CURVE2_INFLUENCE ), "", 0, 256, 256, 0, &data->ctl_curve2_mix, -1, 0, pnet );
-	    data->rand1 = stime_ms() + mod_num * 33;
+	    data->rand1 = psynth_rand_seed( mod_num, pnet ) + mod_num * 33;
 	    data->rand2 = data->rand1 + mod_num * 39;
 	    for( int i = 0; i < MAX_CHANNELS + 1; i++ ) 
 	    {
@@ -36,6 +36,8 @@ static int g_rates[ 3 ] = { 12000, 24000, 44100 };
 #define HIST_SIZE 	16
 #define FILTERS 	4
 #define FILTER_STATE_VARS 2
+#define MAX_BUF_SIZE	( 256 << 4 )
+#define MPM_MIN_CLARITY	0.5F //McLeod: minimum NSDF peak value
 struct estimate
 {
     float T;
@@ -56,6 +58,10 @@ struct MODULE_DATA
     PS_CTYPE		ctl_buf_overlap;
     PS_CTYPE		ctl_abs_threshold;
     PS_CTYPE		ctl_rec;
+    PS_CTYPE		ctl_confidence; //read-only: written by the detector (Alg1,4)
+    PS_CTYPE		ctl_confidence_out; //0 - off; 1...255 - controller of the connected modules
+    int			prev_confidence; //last value sent to ctl_confidence_out
+    psynth_event	ctl_evt;
     PS_STYPE		prev_smp;
     float		period_add;
     int 		period; 
@@ -70,9 +76,7 @@ struct MODULE_DATA
     int			buf_ptr;
     float*		energy_terms;
     float*		fft_i1;
-    float*		fft_i2;
     float*		fft_r1; 
-    float*		fft_r2;
     float*		fft_win;
     int			fft_win_type; 
     estimate		hist[ HIST_SIZE ]; 
@@ -291,6 +295,26 @@ static void pitch_detector_send( int mod_num, psynth_net* pnet, int offset, int
     }
 #endif
 }
+//Update the Confidence controller and send it (0...100% -> 0...32768) to the connected modules:
+static void pitch_detector_set_confidence( int mod_num, psynth_net* pnet, int offset, int confidence )
+{
+    psynth_module* mod = &pnet->mods[ mod_num ];
+    MODULE_DATA* data = (MODULE_DATA*)mod->data_ptr;
+    data->ctl_confidence = confidence;
+    if( data->ctl_confidence_out == 0 ) return;
+    if( data->prev_confidence == confidence ) return;
+    data->prev_confidence = confidence;
+    psynth_event* evt = &data->ctl_evt;
+    evt->offset = offset;
+    evt->controller.ctl_num = data->ctl_confidence_out - 1;
+    evt->controller.ctl_val = confidence * 32768 / 100;
+    for( int i = 0; i < mod->output_links_num; i++ )
+    {
+        int l = mod->output_links[ i ];
+        if( !psynth_get_module( l, pnet ) ) continue;
+        psynth_add_event( l, evt, pnet );
+    }
+}
 static void pitch_detector_reinit_buffers( psynth_module* mod, int mod_num )
 {
     MODULE_DATA* data = (MODULE_DATA*)mod->data_ptr;
@@ -318,17 +342,14 @@ static void pitch_detector_reinit_buffers( psynth_module* mod, int mod_num )
     if( buf_hop < 8 ) buf_hop = 8;
     data->buf_size_scaled = buf_size * data->resamp->ratio_fp / 65536;
     data->buf_hop = buf_hop;
-    size_t new_size = buf_size * sizeof( float );
-    size_t old_size = smem_get_size( data->buf );
-    if( new_size > old_size )
+    if( !data->buf )
     {
-	data->buf = (float*)SMEM_RESIZE( data->buf, new_size );
-	data->energy_terms = (float*)SMEM_RESIZE( data->energy_terms, new_size / 2 );
-	data->fft_i1 = (float*)SMEM_RESIZE( data->fft_i1, new_size );
-	data->fft_r1 = (float*)SMEM_RESIZE( data->fft_r1, new_size );
-	data->fft_i2 = (float*)SMEM_RESIZE( data->fft_i2, new_size );
-	data->fft_r2 = (float*)SMEM_RESIZE( data->fft_r2, new_size );
-	data->fft_win = (float*)SMEM_RESIZE( data->fft_win, new_size );
+	//First call (PS_CMD_SETUP_FINISHED): allocate for the max buffer size, so the controller changes don't allocate in the audio thread
+	data->buf = SMEM_ALLOC2( float, MAX_BUF_SIZE );
+	data->energy_terms = SMEM_ALLOC2( float, MAX_BUF_SIZE / 2 );
+	data->fft_i1 = SMEM_ALLOC2( float, MAX_BUF_SIZE );
+	data->fft_r1 = SMEM_ALLOC2( float, MAX_BUF_SIZE );
+	data->fft_win = SMEM_ALLOC2( float, MAX_BUF_SIZE );
     }
     if( data->buf_size != buf_size || data->fft_win_type != fft_win_type )
     {
@@ -351,6 +372,30 @@ static void pitch_detector_reinit_buffers( psynth_module* mod, int mod_num )
 	}
     }
 }
+//Autocorrelation fft_r1[ t ] = sum( buf[ j ] * buf[ j + t ] ), j = 0...buf_size/2-1; t = 0...buf_size/2-1.
+//Two FFTs: z = buf + i * (first half of buf); R = X * conj( Y ), where X and Y are separated from Z using the conjugate symmetry.
+static void pitch_detector_autocorr( MODULE_DATA* data )
+{
+    int size = data->buf_size;
+    int half = size / 2;
+    float* re = data->fft_r1;
+    float* im = data->fft_i1;
+    for( int t = 0; t < size; t++ ) re[ t ] = data->buf[ t ];
+    for( int t = 0; t < half; t++ ) im[ t ] = data->buf[ t ];
+    for( int t = half; t < size; t++ ) im[ t ] = 0;
+    fft( 0, im, re, size );
+    for( int k = 0; k <= half; k++ )
+    {
+	int j = ( size - k ) & ( size - 1 );
+	float a = re[ k ]; float b = im[ k ];
+	float c = re[ j ]; float d = im[ j ];
+	float r = ( a * d + b * c ) * 0.5F;
+	float i = ( a * a + b * b - c * c - d * d ) * 0.25F;
+	re[ k ] = r; im[ k ] = i;
+	re[ j ] = r; im[ j ] = -i;
+    }
+    fft( FFT_FLAG_INVERSE, im, re, size );
+}
 static float parabolic_interpolation( float v0, float v1, float v2, int t )
 {
     float correction = ( v2 - v0 ) / ( 2 * ( 2 * v1 - v2 - v0 ) );
@@ -441,14 +486,14 @@ PS_RETTYPE MODULE_HANDLER(
 	    break;
 	case PS_CMD_INIT:
 	    {
-        	psynth_resize_ctls_storage( mod_num, 12, pnet );
+        	psynth_resize_ctls_storage( mod_num, 14, pnet );
         	int ctl;
 #ifdef PS_STYPE_FLOATINGPOINT
     #define DEF_ALG 1
 #else
     #define DEF_ALG 0
 #endif
-		psynth_register_ctl( mod_num, ps_get_string( STR_PS_ALGORITHM ), ps_get_string( STR_PS_PD_ALGS ), 0, 3, DEF_ALG, 1, &data->ctl_alg, DEF_ALG, 0, pnet ); 
+		psynth_register_ctl( mod_num, ps_get_string( STR_PS_ALGORITHM ), ps_get_string( STR_PS_PD_ALGS ), 0, 4, DEF_ALG, 1, &data->ctl_alg, DEF_ALG, 0, pnet ); 
 		ctl = psynth_register_ctl( mod_num, ps_get_string( STR_PS_THRESHOLD ), "", 0, 10000, 80, 0, &data->ctl_threshold, -1, 0, pnet ); 
         	    psynth_set_ctl_flags( mod_num, ctl, PSYNTH_CTL_FLAG_EXP3, pnet );
 		ctl = psynth_register_ctl( mod_num, ps_get_string( STR_PS_GAIN ), "", 0, 256, 0, 0, &data->ctl_vel_gain, 0, 0, pnet );
@@ -464,7 +509,12 @@ PS_RETTYPE MODULE_HANDLER(
 		psynth_register_ctl( mod_num, ps_get_string( STR_PS_PD_ALG1_BUF_OVERLAP ), "%", 0, 100, 50, 0, &data->ctl_buf_overlap, 50, 2, pnet );
 		psynth_register_ctl( mod_num, ps_get_string( STR_PS_PD_ALG1_ABS_THRESHOLD ), "", 0, 100, 10, 0, &data->ctl_abs_threshold, 10, 2, pnet );
 		psynth_register_ctl( mod_num, ps_get_string( STR_PS_RECORD_NOTES ), ps_get_string( STR_PS_OFF_ON ), 0, 1, 0, 1, &data->ctl_rec, -1, 3, pnet ); 
+		psynth_register_ctl( mod_num, ps_get_string( STR_PS_PD_ALG1_CONFIDENCE ), "%", 0, 100, 0, 0, &data->ctl_confidence, -1, 2, pnet );
+		psynth_register_ctl( mod_num, ps_get_string( STR_PS_PD_ALG1_CONFIDENCE_OUT_CTL ), "", 0, 255, 0, 1, &data->ctl_confidence_out, -1, 2, pnet );
                 smem_clear( &data->out_evt, sizeof( data->out_evt ) );
+                smem_clear( &data->ctl_evt, sizeof( data->ctl_evt ) );
+                data->ctl_evt.command = PS_CMD_SET_GLOBAL_CONTROLLER;
+                data->prev_confidence = -1;
                 data->max_period = pnet->sampling_freq / 25;
 		data->redraw_period1 = pnet->sampling_freq / 20;
 		data->redraw_period2 = pnet->sampling_freq / 1;
@@ -673,9 +723,9 @@ PS_RETTYPE MODULE_HANDLER(
 		    }
         	    break;
         	}
-        	case 1: case 2: case 3:
+        	case 1: case 2: case 3: case 4:
         	{
-        	    int max_freq = data->ctl_alg == 1 ? 2000 : 1000; 
+        	    int max_freq = ( data->ctl_alg == 1 || data->ctl_alg == 4 ) ? 2000 : 1000; 
         	    if( pnet->base_host_version >= 0x02010200 )
         	    {
         		if( data->ctl_lp_freq == 0 )
@@ -695,7 +745,7 @@ PS_RETTYPE MODULE_HANDLER(
         		if( data->buf_ptr >= data->buf_size )
         		{
         		    float amp = 0;
-        		    if( data->ctl_alg == 1 )
+        		    if( data->ctl_alg == 1 || data->ctl_alg == 4 )
         		    {
         			data->energy_terms[ 0 ] = 0;
         			for( int t = 0; t < data->buf_size / 2; t++ ) 
@@ -706,37 +756,31 @@ PS_RETTYPE MODULE_HANDLER(
         			amp = 
         			    ( sqrt( data->energy_terms[ 0 ] / ( data->buf_size / 2 ) ) + sqrt( amp2 / ( data->buf_size / 4 ) ) ) / 2;
         		    }
-        		    if( data->ctl_alg >= 2 )
+        		    if( data->ctl_alg == 2 || data->ctl_alg == 3 )
         		    {
         			for( int t = 0; t < data->buf_size; t += 2 )
         			    amp += data->buf[ t ] * data->buf[ t ];
         			amp = sqrt( amp / ( data->buf_size / 2 ) ); 
         		    }
         		    float amp_threshold = (float)data->ctl_threshold / 10000.0F;
+        		    int evt_offset = i * data->resamp->ratio_fp / 65536;
+        		    if( evt_offset >= frames ) evt_offset = frames - 1;
         		    if( amp > 1.0F / ( 32768.0F * 2 ) || data->playing )
         		    {
         			int T = min_T; 
-        			if( data->ctl_alg == 1 )
+        			float confidence = 0;
+        			if( data->ctl_alg == 1 || data->ctl_alg == 4 )
         			{
         			    for( int t = 1; t < data->buf_size / 2; t++ ) 
         				data->energy_terms[ t ] =
         				    data->energy_terms[ t - 1 ]
         				    - data->buf[ t - 1 ] * data->buf[ t - 1 ]
         				    + data->buf[ t + data->buf_size / 2 ] * data->buf[ t + data->buf_size / 2 ];
-        			    memset( data->fft_i1, 0, data->buf_size * sizeof( float ) );
-        			    for( int t = 0; t < data->buf_size; t++ ) data->fft_r1[ t ] = data->buf[ t ];
-        			    fft( 0, data->fft_i1, data->fft_r1, data->buf_size );
-        			    memset( data->fft_i2, 0, data->buf_size * sizeof( float ) );
-        			    for( int t = 0; t <= data->buf_size / 2; t++ ) data->fft_r2[ t ] = 0;
-        			    data->fft_r2[ 0 ] = data->buf[ 0 ]; for( int t = 1; t < data->buf_size / 2; t++ ) data->fft_r2[ data->buf_size - t ] = data->buf[ t ];
-        			    fft( 0, data->fft_i2, data->fft_r2, data->buf_size );
-        			    for( int t = 0; t < data->buf_size; t++ )
-        			    {
-        				float r1 = data->fft_r1[ t ];
-    					data->fft_r1[ t ] = data->fft_r1[ t ] * data->fft_r2[ t ] - data->fft_i1[ t ] * data->fft_i2[ t ];
-    					data->fft_i1[ t ] = data->fft_i1[ t ] * data->fft_r2[ t ] + r1                * data->fft_i2[ t ];
-        			    }
-        			    fft( FFT_FLAG_INVERSE, data->fft_i1, data->fft_r1, data->buf_size );
+        			    pitch_detector_autocorr( data );
+        			}
+        			if( data->ctl_alg == 1 )
+        			{
+        			    //YIN: cumulative mean normalized difference function
         			    for( int t = 0; t < data->buf_size / 2; t++ ) 
         				data->fft_r1[ t ] = data->energy_terms[ 0 ] + data->energy_terms[ t ] - 2 * data->fft_r1[ t ];
         			    float sum = 0;
@@ -752,10 +796,57 @@ PS_RETTYPE MODULE_HANDLER(
         				if( data->fft_r1[ T ] < threshold )
         				{
         				    while( T + 1 < data->buf_size / 2 && data->fft_r1[ T + 1 ] < data->fft_r1[ T ] ) T++;
+        				    confidence = 1 - data->fft_r1[ T ];
         				    break;
         				}
         			    }
         			}
+        			if( data->ctl_alg == 4 )
+        			{
+        			    //McLeod: normalized square difference function; 
+        			    //key maxima = max of each positive lobe after the first negative zero crossing;
+        			    //T = first key maximum above k * (highest key maximum)
+        			    int half = data->buf_size / 2;
+        			    for( int t = 0; t < half; t++ )
+        			    {
+        				float m = data->energy_terms[ 0 ] + data->energy_terms[ t ];
+        				data->fft_r1[ t ] = m > 0 ? 2 * data->fft_r1[ t ] / m : 0;
+        			    }
+        			    float k = 1 - (float)data->ctl_abs_threshold / 100.0F;
+        			    float nmax = 0;
+        			    for( int pass = 0; pass < 2; pass++ )
+        			    {
+        				int t = 1;
+        				while( t < half && data->fft_r1[ t ] > 0 ) t++;
+        				T = half;
+        				while( t < half )
+        				{
+        				    while( t < half && data->fft_r1[ t ] <= 0 ) t++;
+        				    int key = -1;
+        				    for( ; t < half && data->fft_r1[ t ] > 0; t++ )
+        					if( t >= min_T && ( key < 0 || data->fft_r1[ t ] > data->fft_r1[ key ] ) ) key = t;
+        				    if( key < 0 || key >= half - 1 ) continue;
+        				    float v = data->fft_r1[ key ];
+        				    if( pass == 0 )
+        				    {
+        					if( v > nmax ) nmax = v;
+        				    }
+        				    else if( v >= k * nmax )
+        				    {
+        					T = key;
+        					break;
+        				    }
+        				}
+        				if( nmax < MPM_MIN_CLARITY ) { T = half; break; }
+        			    }
+        			    if( T < half )
+        			    {
+        				float v0 = data->fft_r1[ T - 1 ];
+        				float v1 = data->fft_r1[ T ];
+        				float v2 = data->fft_r1[ T + 1 ];
+        				confidence = v1 + 0.25F * ( v2 - v0 ) * ( get_T( data, data->fft_r1, T ) - T );
+        			    }
+        			}
         			if( data->ctl_alg == 2 )
         			{
         			    for( int t = 0; t < data->buf_size; t++ ) data->fft_r1[ t ] = data->buf[ t ] * data->fft_win[ t ];
@@ -800,13 +891,14 @@ PS_RETTYPE MODULE_HANDLER(
         			    }
         			    T = max_b;
         			}
+        			if( confidence < 0 ) confidence = 0;
+        			if( confidence > 1 ) confidence = 1;
+        			pitch_detector_set_confidence( mod_num, pnet, mod->offset + evt_offset, confidence * 100 );
 #if OUTPUT_TO_FILE == 2
 				float vvvv = -1;
 				sfs_write( &vvvv, sizeof( float ), 1, g_fout );
 				sfs_write( data->fft_r1, sizeof( float ), data->buf_size / 2, g_fout );
 #endif
-        			int evt_offset = i * data->resamp->ratio_fp / 65536;
-        			if( evt_offset >= frames ) evt_offset = frames - 1;
         			if( data->ctl_alg == 3 )
         			{
         			    if( T )
@@ -878,6 +970,7 @@ PS_RETTYPE MODULE_HANDLER(
 				    }
         			}
         		    } 
+        		    else pitch_detector_set_confidence( mod_num, pnet, mod->offset + evt_offset, 0 );
         		    data->buf_ptr = data->buf_size - data->buf_hop;
         		    for( int h = 0; h < data->buf_size - data->buf_hop; h++ )
         		    {
@@ -947,6 +1040,8 @@ PS_RETTYPE MODULE_HANDLER(
 	    data->playing = 0;
 	    data->frame_cnt = 0;
 	    data->str_mod_name[ 0 ] = 0;
+	    data->ctl_confidence = 0;
+	    data->prev_confidence = -1;
 	    for( int i = 0; i < FILTER_STATE_VARS * FILTERS; i++ ) data->lp_state[ i ] = 0;
 	    psynth_resampler_reset( data->resamp );
 	    data->empty = true;
@@ -980,9 +1075,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    smem_free( data->buf );
 	    smem_free( data->energy_terms );
 	    smem_free( data->fft_i1 );
-	    smem_free( data->fft_i2 );
 	    smem_free( data->fft_r1 );
-	    smem_free( data->fft_r2 );
 	    smem_free( data->fft_win );
 	    psynth_resampler_remove( data->resamp );
 #ifdef SUNVOX_GUI
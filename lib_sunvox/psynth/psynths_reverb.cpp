@@ -28,6 +28,9 @@ IN THE SOFTWARE.
 
 #include "psynth.h"
 #include "psynths_dc_blocker.h"
+#if defined(PS_STYPE_FLOATINGPOINT) && defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
 #define MODULE_DATA	psynth_reverb_data
 #define MODULE_HANDLER	psynth_reverb
 #define MODULE_INPUTS	2
@@ -257,6 +260,148 @@ static void clean_filters( MODULE_DATA* data )
     }
     data->filters_clean = true;
 }
+#if defined(PS_STYPE_FLOATINGPOINT) && defined(__SSE2__)
+#define REVERB_SIMD
+#if defined(__GNUC__)
+    #define REVERB_KEEP( v ) __asm__( "" : "+x"( v ) ) //-ffast-math can reassociate the vector operations; this keeps the order of the scalar code
+#else
+    #define REVERB_KEEP( v ) {}
+#endif
+//Comb bank (4 combs per vector; 4 frames per step) + allpass chain (4 frames per vector).
+//Same operations in the same order as the scalar code, so the result is identical.
+//Stops before the nearest delay line wrap; returns the number of rendered frames (multiple of 4):
+static int reverb_render_x4( MODULE_DATA* data, PS_STYPE* outL_ch, PS_STYPE* outR_ch, int frames, int outputs_num, int filters_add, int allpass_mode, PS_STYPE2 ctl_wet )
+{
+    comb_filter* combs[ MAX_COMBS * 2 ];
+    allpass_filter* allpasses[ MAX_ALLPASSES * 2 ];
+    int combs_num = 0;
+    int allpasses_num = 0;
+    int len = frames;
+    for( int a = 0; a < MAX_COMBS * outputs_num; a += filters_add )
+    {
+	comb_filter* f = &data->combs[ a ];
+	combs[ combs_num++ ] = f;
+	int n = f->buf_size - f->buf_ptr;
+	if( n < len ) len = n;
+    }
+    if( allpass_mode )
+    {
+	for( int a = 0; a < MAX_ALLPASSES * outputs_num; a += filters_add )
+	{
+	    allpass_filter* f = &data->allpasses[ a ];
+	    allpasses[ allpasses_num++ ] = f;
+	    int n = f->buf_size - f->buf_ptr;
+	    if( n < len ) len = n;
+	}
+    }
+    len &= ~3;
+    if( len <= 0 ) return 0;
+    int groups = combs_num / 4;
+    int ch_combs = combs_num / outputs_num;
+    int ch_allpasses = allpasses_num / outputs_num;
+    __m128 fs[ MAX_COMBS * 2 / 4 ];
+    __m128 damp1[ MAX_COMBS * 2 / 4 ];
+    __m128 damp2[ MAX_COMBS * 2 / 4 ];
+    __m128 feedback[ MAX_COMBS * 2 / 4 ];
+    for( int g = 0; g < groups; g++ )
+    {
+	comb_filter** f = &combs[ g * 4 ];
+	fs[ g ] = _mm_setr_ps( f[ 0 ]->filterstore, f[ 1 ]->filterstore, f[ 2 ]->filterstore, f[ 3 ]->filterstore );
+	damp1[ g ] = _mm_setr_ps( f[ 0 ]->damp1, f[ 1 ]->damp1, f[ 2 ]->damp1, f[ 3 ]->damp1 );
+	damp2[ g ] = _mm_setr_ps( f[ 0 ]->damp2, f[ 1 ]->damp2, f[ 2 ]->damp2, f[ 3 ]->damp2 );
+	feedback[ g ] = _mm_setr_ps( f[ 0 ]->feedback, f[ 1 ]->feedback, f[ 2 ]->feedback, f[ 3 ]->feedback );
+    }
+    __m128 half = _mm_set1_ps( 0.5F );
+    __m128 out_div = _mm_set1_ps( 1.0F / (PS_STYPE2)(16*INPUT_MUL) ); //power of 2: same as the division
+    __m128 wet = _mm_set1_ps( ctl_wet );
+    for( int i = 0; i < len; i += 4 )
+    {
+	__m128 input = _mm_loadu_ps( outL_ch + i );
+	if( outR_ch ) input = _mm_mul_ps( _mm_add_ps( input, _mm_loadu_ps( outR_ch + i ) ), half );
+	__m128 in0 = _mm_shuffle_ps( input, input, _MM_SHUFFLE( 0, 0, 0, 0 ) );
+	__m128 in1 = _mm_shuffle_ps( input, input, _MM_SHUFFLE( 1, 1, 1, 1 ) );
+	__m128 in2 = _mm_shuffle_ps( input, input, _MM_SHUFFLE( 2, 2, 2, 2 ) );
+	__m128 in3 = _mm_shuffle_ps( input, input, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+	__m128 sum[ 2 ] = { _mm_setzero_ps(), _mm_setzero_ps() };
+	for( int g = 0; g < groups; g++ )
+	{
+	    comb_filter** f = &combs[ g * 4 ];
+	    PS_STYPE2* p0 = f[ 0 ]->buf + f[ 0 ]->buf_ptr + i;
+	    PS_STYPE2* p1 = f[ 1 ]->buf + f[ 1 ]->buf_ptr + i;
+	    PS_STYPE2* p2 = f[ 2 ]->buf + f[ 2 ]->buf_ptr + i;
+	    PS_STYPE2* p3 = f[ 3 ]->buf + f[ 3 ]->buf_ptr + i;
+	    //Comb outputs (4 frames each):
+	    __m128 c0 = _mm_loadu_ps( p0 );
+	    __m128 c1 = _mm_loadu_ps( p1 );
+	    __m128 c2 = _mm_loadu_ps( p2 );
+	    __m128 c3 = _mm_loadu_ps( p3 );
+	    __m128 s = sum[ ( g * 4 ) / ch_combs ];
+	    s = _mm_add_ps( s, c0 ); REVERB_KEEP( s );
+	    s = _mm_add_ps( s, c1 ); REVERB_KEEP( s );
+	    s = _mm_add_ps( s, c2 ); REVERB_KEEP( s );
+	    s = _mm_add_ps( s, c3 ); REVERB_KEEP( s );
+	    sum[ ( g * 4 ) / ch_combs ] = s;
+	    //Frames -> lanes:
+	    __m128 t0 = c0, t1 = c1, t2 = c2, t3 = c3;
+	    _MM_TRANSPOSE4_PS( t0, t1, t2, t3 );
+	    __m128 v = fs[ g ];
+	    __m128 d1 = damp1[ g ];
+	    __m128 d2 = damp2[ g ];
+	    __m128 fb = feedback[ g ];
+	    v = _mm_add_ps( _mm_mul_ps( t0, d1 ), _mm_mul_ps( v, d2 ) ); REVERB_KEEP( v ); t0 = _mm_add_ps( in0, _mm_mul_ps( v, fb ) );
+	    v = _mm_add_ps( _mm_mul_ps( t1, d1 ), _mm_mul_ps( v, d2 ) ); REVERB_KEEP( v ); t1 = _mm_add_ps( in1, _mm_mul_ps( v, fb ) );
+	    v = _mm_add_ps( _mm_mul_ps( t2, d1 ), _mm_mul_ps( v, d2 ) ); REVERB_KEEP( v ); t2 = _mm_add_ps( in2, _mm_mul_ps( v, fb ) );
+	    v = _mm_add_ps( _mm_mul_ps( t3, d1 ), _mm_mul_ps( v, d2 ) ); REVERB_KEEP( v ); t3 = _mm_add_ps( in3, _mm_mul_ps( v, fb ) );
+	    fs[ g ] = v;
+	    //Lanes -> frames:
+	    _MM_TRANSPOSE4_PS( t0, t1, t2, t3 );
+	    _mm_storeu_ps( p0, t0 );
+	    _mm_storeu_ps( p1, t1 );
+	    _mm_storeu_ps( p2, t2 );
+	    _mm_storeu_ps( p3, t3 );
+	}
+	for( int ch = 0; ch < outputs_num; ch++ )
+	{
+	    __m128 v = sum[ ch ];
+	    for( int a = 0; a < ch_allpasses; a++ )
+	    {
+		allpass_filter* f = allpasses[ ch * ch_allpasses + a ];
+		PS_STYPE2* p = f->buf + f->buf_ptr + i;
+		__m128 bufout = _mm_loadu_ps( p );
+		__m128 buf_write = _mm_add_ps( v, _mm_mul_ps( bufout, half ) );
+		REVERB_KEEP( buf_write );
+		_mm_storeu_ps( p, buf_write );
+		if( allpass_mode == 1 )
+		    v = _mm_sub_ps( bufout, v );
+		else
+		    v = _mm_sub_ps( bufout, _mm_mul_ps( buf_write, half ) );
+		REVERB_KEEP( v );
+	    }
+	    v = _mm_mul_ps( v, out_div ); REVERB_KEEP( v );
+	    _mm_storeu_ps( ( ch == 0 ? outL_ch : outR_ch ) + i, _mm_mul_ps( v, wet ) ); //( v / 16 ) * wet
+	}
+    }
+    for( int g = 0; g < groups; g++ )
+    {
+	float v[ 4 ];
+	_mm_storeu_ps( v, fs[ g ] );
+	for( int l = 0; l < 4; l++ ) combs[ g * 4 + l ]->filterstore = v[ l ];
+    }
+    for( int a = 0; a < combs_num; a++ )
+    {
+	comb_filter* f = combs[ a ];
+	f->buf_ptr += len;
+	if( f->buf_ptr >= f->buf_size ) f->buf_ptr = 0;
+    }
+    for( int a = 0; a < allpasses_num; a++ )
+    {
+	allpass_filter* f = allpasses[ a ];
+	f->buf_ptr += len;
+	if( f->buf_ptr >= f->buf_size ) f->buf_ptr = 0;
+    }
+    return len;
+}
+#endif
 PS_RETTYPE MODULE_HANDLER( 
     PSYNTH_MODULE_HANDLER_PARAMETERS
     )
@@ -470,6 +615,10 @@ PS_RETTYPE MODULE_HANDLER(
 		    {
 			for( int i = 0; i < frames; i++ )
 			{
+#ifdef REVERB_SIMD
+			    i += reverb_render_x4( data, outL_ch + i, outR_ch ? outR_ch + i : 0, frames - i, outputs_num, filters_add, 0, ctl_wet );
+			    if( i >= frames ) break;
+#endif
 			    PS_STYPE2 outL = 0;
 			    PS_STYPE2 outR = 0;
 			    PS_STYPE2 input = outL_ch[ i ];
@@ -501,6 +650,10 @@ PS_RETTYPE MODULE_HANDLER(
 		    {
 			for( int i = 0; i < frames; i++ )
 			{
+#ifdef REVERB_SIMD
+			    i += reverb_render_x4( data, outL_ch + i, outR_ch ? outR_ch + i : 0, frames - i, outputs_num, filters_add, 1, ctl_wet );
+			    if( i >= frames ) break;
+#endif
 			    PS_STYPE2 outL = 0;
 			    PS_STYPE2 outR = 0;
 			    PS_STYPE2 input = outL_ch[ i ];
@@ -549,6 +702,10 @@ PS_RETTYPE MODULE_HANDLER(
 		    {
 			for( int i = 0; i < frames; i++ )
 			{
+#ifdef REVERB_SIMD
+			    i += reverb_render_x4( data, outL_ch + i, outR_ch ? outR_ch + i : 0, frames - i, outputs_num, filters_add, 2, ctl_wet );
+			    if( i >= frames ) break;
+#endif
 			    PS_STYPE2 outL = 0;
 			    PS_STYPE2 outR = 0;
 			    PS_STYPE2 input = outL_ch[ i ];
@@ -29,6 +29,9 @@ IN THE SOFTWARE.
 #include "psynth_net.h"
 #include "psynths_sampler.h"
 #include "sunvox_engine.h"
+#if defined(PS_STYPE_FLOATINGPOINT) && defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
 #define MODULE_DATA	psynth_sampler_data
 #define MODULE_HANDLER	psynth_sampler
 #define MODULE_INPUTS	2
@@ -43,12 +46,18 @@ IN THE SOFTWARE.
 #define CHUNK_OPT			CHUNK_SMP( MAX_SAMPLES )
 #define CHUNK_ENV( env_num )		( CHUNK_OPT + 1 + env_num )
 #define CHUNK_EFFECT_MOD		( CHUNK_ENV( 8 ) )
+#define CHUNK_SMP_PACKED( smp_num )	( CHUNK_EFFECT_MOD + 1 + smp_num ) 
 #define SUBMOD_MAX_CHANNELS 		MAX_CHANNELS
 #define SUBMOD_SUNVOX_FLAGS		SUNVOX_FLAG_NO_MODULE_CHANNELS
 #define INTERP_PREC ( PSYNTH_FP64_PREC - 1 ) 
 #define INS_SIGN 'SAMP'
 #define INS_VERSION 6
 #define LOAD_XI_FLAG_SET_MAX_VOLUME	1
+#if defined(PS_STYPE_FLOATINGPOINT) && defined(__SSE2__)
+#define SAMPLER_SIMD
+#define SAMPLER_LANES		4 //voices per lane group (one voice per SIMD lane)
+#define SAMPLER_LANE_FRAMES	128 //max frames rendered ahead by the lane group
+#endif
 struct sampler_options
 {
     bool	rec_on_play; 
@@ -145,7 +154,12 @@ struct gen_channel
     int16_t    	smp_note_num;
     PS_CTYPE   	local_pan;
     PS_CTYPE	local_reverse;
+#ifdef SAMPLER_SIMD
+    PS_STYPE*	lane_buf; //frames rendered ahead by the voice lanes (see sampler_render_lanes()): lane_buf[ output * SAMPLER_LANE_FRAMES + i ]
+    int		lane_frames;
+#endif
 };
+struct sampler_pack_cache;
 struct MODULE_DATA
 {
     PS_CTYPE	ctl_volume;
@@ -195,6 +209,10 @@ struct MODULE_DATA
     std::atomic_int	rec_thread_state; 
     ssemaphore	rec_thread_sem;
     sampler_options* opt;
+    sampler_pack_cache* pack_cache; 
+#ifdef SAMPLER_SIMD
+    PS_STYPE*	lane_buf; //( MAX_CHANNELS + 1 ) * MODULE_OUTPUTS * SAMPLER_LANE_FRAMES; the last one - for the unused lanes
+#endif
 #ifdef SUNVOX_GUI
     window_manager* 	wm;
     gen_channel		editor_player_channel;
@@ -303,12 +321,473 @@ static int load_instrument_or_sample(
     psynth_net* net, 
     int sample_num );
 #include "psynths_sampler_gui.h"
+//Packed sample storage (sampler_par() 9):
+//losslessly compressed blocks of SMP_PACK_BLOCK frames in the CHUNK_SMP_PACKED chunk (instead of CHUNK_SMP_DATA);
+//each block channel = fixed predictor (order 0...2) + Rice codes (or verbatim);
+//the blocks are decoded on demand into the decode cache shared by all voices of the module;
+//the reads across the block boundaries and the loop points use the small windows (also decoded from the cache);
+//the cache is allocated by sampler_pack_sample(), so the render never allocates memory.
+//Packed data is not saved: PCM chunks are restored temporarily before saving (PS_CMD_BEFORE_SAVE).
+#define SMP_PACK_BLOCK			1024 //frames
+#define SMP_PACK_CACHE_BLOCKS		32
+#define SMP_PACK_LOOPS			4 //loop windows in the cache
+#define SMP_PACK_SEAM			128 //frames
+#define SMP_PACK_MARGIN			32 //frames
+#define SMP_PACK_READ_BEFORE		15 //max interpolation reads: p-15 ... p+16 (sinc, 32 taps)
+#define SMP_PACK_READ_AFTER		16
+struct sampler_pack
+{
+    uint32_t	id; //unique ID (decode cache key)
+    uint32_t	frames;
+    uint32_t	pcm_size; //original chunk size (bytes)
+    uint32_t	blocks;
+    uint8_t	bits; //0 - int8; 1 - int16; 2 - float32 (24-bit integer values only)
+    uint8_t	channels;
+    uint8_t	frame_size; //bytes
+    uint8_t	reserved;
+    //uint32_t block offsets[ blocks + 1 ] (from the beginning of the pack);
+    //block data: for each channel: mode (predictor order; 3 - verbatim), rice k, bits...
+};
+struct sampler_pack_loop //window for the loop points (see sampler_pack_get_loop())
+{
+    uint32_t	id; //pack ID; 0 - empty
+    uint32_t	stamp; //LRU
+    SMPPTR	reppnt;
+    SMPPTR	replen;
+    SMPPTR	smp_len;
+    int8_t	data[ SMP_PACK_SEAM * 8 ];
+};
+struct sampler_pack_cache
+{
+    uint32_t	id[ SMP_PACK_CACHE_BLOCKS ]; //pack ID; 0 - empty
+    uint32_t	block[ SMP_PACK_CACHE_BLOCKS ];
+    uint32_t	stamp[ SMP_PACK_CACHE_BLOCKS ]; //LRU
+    uint32_t	clock;
+    int		frame_size; //max frame size of the packed samples of the module
+    sampler_pack_loop loop[ SMP_PACK_LOOPS ];
+    int8_t	seam[ SMP_PACK_SEAM * 8 ]; //window across the block boundary
+    //int8_t	data[ SMP_PACK_CACHE_BLOCKS * SMP_PACK_BLOCK * frame_size ];
+};
+#define SMP_PACK_CACHE_SIZE( frame_size ) ( sizeof( sampler_pack_cache ) + SMP_PACK_CACHE_BLOCKS * SMP_PACK_BLOCK * ( frame_size ) )
+static std::atomic_uint g_smp_pack_id( 0 );
+struct sampler_bit_writer
+{
+    uint8_t*	p;
+    uint64_t	acc;
+    int		n;
+};
+static inline void sampler_bits_put( sampler_bit_writer* w, uint32_t v, int bits )
+{
+    if( bits == 0 ) return;
+    w->acc = ( w->acc << bits ) | ( v & ( ( (uint64_t)1 << bits ) - 1 ) );
+    w->n += bits;
+    while( w->n >= 8 ) { w->n -= 8; *w->p++ = (uint8_t)( w->acc >> w->n ); }
+}
+static inline void sampler_bits_flush( sampler_bit_writer* w )
+{
+    if( w->n ) sampler_bits_put( w, 0, 8 - w->n );
+}
+struct sampler_bit_reader
+{
+    const uint8_t* p;
+    uint64_t	acc; //left-aligned
+    int		n;
+};
+static inline void sampler_bits_fill( sampler_bit_reader* r )
+{
+    while( r->n <= 56 ) { r->acc |= (uint64_t)*r->p++ << ( 56 - r->n ); r->n += 8; }
+}
+static inline uint32_t sampler_bits_get( sampler_bit_reader* r, int bits )
+{
+    if( bits == 0 ) return 0;
+    if( r->n < bits ) sampler_bits_fill( r );
+    uint32_t v = (uint32_t)( r->acc >> ( 64 - bits ) );
+    r->acc <<= bits;
+    r->n -= bits;
+    return v;
+}
+static inline int sampler_clz64( uint64_t v ) //v != 0
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll( v );
+#else
+    int n = 0;
+    while( ( v >> 56 ) == 0 ) { v <<= 8; n += 8; }
+    while( ( v >> 63 ) == 0 ) { v <<= 1; n++; }
+    return n;
+#endif
+}
+static inline uint32_t sampler_bits_get_unary( sampler_bit_reader* r )
+{
+    uint32_t q = 0;
+    while( r->acc == 0 )
+    {
+	q += r->n;
+	r->n = 0;
+	sampler_bits_fill( r );
+    }
+    int z = sampler_clz64( r->acc );
+    r->acc <<= z;
+    r->acc <<= 1;
+    r->n -= z + 1;
+    return q + z;
+}
+static inline int32_t sampler_pack_predict( int order, int32_t s1, int32_t s2 )
+{
+    if( order == 1 ) return s1;
+    if( order == 2 ) return 2 * s1 - s2;
+    return 0;
+}
+static sampler_pack* sampler_pack_encode( const void* pcm, uint frames, uint pcm_size, int bits, int channels )
+{
+    if( frames == 0 || bits > 2 || channels < 1 || channels > 2 ) return NULL;
+    int bps = 8 << bits; if( bps > 24 ) bps = 24;
+    int frame_size = channels << bits;
+    if( (size_t)frames * frame_size > pcm_size ) return NULL;
+    uint blocks = ( frames + SMP_PACK_BLOCK - 1 ) / SMP_PACK_BLOCK;
+    size_t hdr_size = sizeof( sampler_pack ) + ( blocks + 1 ) * sizeof( uint32_t );
+    size_t max_size = hdr_size + (size_t)blocks * channels * ( 2 + ( SMP_PACK_BLOCK * bps ) / 8 + 1 );
+    if( max_size > 0xFFFFFFFF ) return NULL;
+    sampler_pack* pack = (sampler_pack*)SMEM_ALLOC( max_size );
+    int32_t* x = SMEM_ALLOC2( int32_t, SMP_PACK_BLOCK );
+    uint32_t* u = SMEM_ALLOC2( uint32_t, SMP_PACK_BLOCK );
+    bool err = !pack || !x || !u;
+    if( !err )
+    {
+	pack->id = 0;
+	pack->frames = frames;
+	pack->pcm_size = pcm_size;
+	pack->blocks = blocks;
+	pack->bits = bits;
+	pack->channels = channels;
+	pack->frame_size = frame_size;
+	pack->reserved = 0;
+	uint32_t* offsets = (uint32_t*)( pack + 1 );
+	sampler_bit_writer w;
+	w.p = (uint8_t*)pack + hdr_size;
+	for( uint b = 0; b < blocks && !err; b++ )
+	{
+	    offsets[ b ] = (uint32_t)( w.p - (uint8_t*)pack );
+	    uint b0 = b * SMP_PACK_BLOCK;
+	    int n = frames - b0; if( n > SMP_PACK_BLOCK ) n = SMP_PACK_BLOCK;
+	    for( int ch = 0; ch < channels; ch++ )
+	    {
+		//Get the integer samples:
+		switch( bits )
+		{
+		    case 0: { const int8_t* s = (const int8_t*)pcm + (size_t)b0 * channels + ch; for( int i = 0; i < n; i++ ) x[ i ] = s[ i * channels ]; } break;
+		    case 1: { const int16_t* s = (const int16_t*)pcm + (size_t)b0 * channels + ch; for( int i = 0; i < n; i++ ) x[ i ] = s[ i * channels ]; } break;
+		    case 2:
+			{
+			    const float* s = (const float*)pcm + (size_t)b0 * channels + ch;
+			    for( int i = 0; i < n; i++ )
+			    {
+				float v = s[ i * channels ];
+				if( !( v >= -1.0F && v < 1.0F ) ) { err = true; break; }
+				int32_t iv = (int32_t)( v * 8388608.0F );
+				if( (float)iv / 8388608.0F != v ) { err = true; break; } //not a 24-bit value
+				x[ i ] = iv;
+			    }
+			}
+			break;
+		}
+		if( err ) break;
+		//Predictor with the min sum of residuals:
+		uint64_t sum[ 3 ] = { 0, 0, 0 };
+		for( int i = 0; i < n; i++ )
+		{
+		    int32_t v = x[ i ];
+		    sum[ 0 ] += (uint32_t)( v < 0 ? -v : v );
+		    if( i >= 1 ) { int32_t r = v - x[ i - 1 ]; sum[ 1 ] += (uint32_t)( r < 0 ? -r : r ); }
+		    if( i >= 2 ) { int32_t r = v - 2 * x[ i - 1 ] + x[ i - 2 ]; sum[ 2 ] += (uint32_t)( r < 0 ? -r : r ); }
+		}
+		int order = 0;
+		for( int o = 1; o < 3 && o < n; o++ ) if( sum[ o ] < sum[ order ] ) order = o;
+		int cnt = n - order;
+		for( int i = order; i < n; i++ )
+		{
+		    int32_t r = x[ i ] - sampler_pack_predict( order, order > 0 ? x[ i - 1 ] : 0, order > 1 ? x[ i - 2 ] : 0 );
+		    u[ i ] = ( (uint32_t)r << 1 ) ^ (uint32_t)( r >> 31 ); //zigzag
+		}
+		//Rice parameter:
+		int k = 0;
+		if( cnt > 0 )
+		{
+		    uint64_t mean = ( sum[ order ] * 2 ) / cnt;
+		    while( k < 30 && ( (uint64_t)1 << ( k + 1 ) ) <= mean ) k++;
+		}
+		uint64_t best_size = 0;
+		int best_k = -1;
+		for( int kk = k - 1; kk <= k + 1; kk++ )
+		{
+		    if( kk < 0 || kk > 30 ) continue;
+		    uint64_t size = (uint64_t)cnt * ( kk + 1 );
+		    for( int i = order; i < n; i++ ) size += u[ i ] >> kk;
+		    if( best_k < 0 || size < best_size ) { best_size = size; best_k = kk; }
+		}
+		k = best_k;
+		int mode = order;
+		if( (uint64_t)order * bps + best_size >= (uint64_t)n * bps ) mode = 3;
+		*w.p++ = (uint8_t)mode;
+		*w.p++ = (uint8_t)k;
+		w.acc = 0;
+		w.n = 0;
+		if( mode == 3 )
+		{
+		    for( int i = 0; i < n; i++ ) sampler_bits_put( &w, (uint32_t)x[ i ], bps );
+		}
+		else
+		{
+		    for( int i = 0; i < order; i++ ) sampler_bits_put( &w, (uint32_t)x[ i ], bps );
+		    for( int i = order; i < n; i++ )
+		    {
+			uint32_t q = u[ i ] >> k;
+			while( q >= 32 ) { sampler_bits_put( &w, 0, 32 ); q -= 32; }
+			sampler_bits_put( &w, 1, q + 1 );
+			sampler_bits_put( &w, u[ i ], k );
+		    }
+		}
+		sampler_bits_flush( &w );
+	    }
+	}
+	if( !err )
+	{
+	    offsets[ blocks ] = (uint32_t)( w.p - (uint8_t*)pack );
+	    pack = (sampler_pack*)SMEM_RESIZE( pack, offsets[ blocks ] + 8 ); //+ bit reader prefetch
+	    if( !pack ) err = true;
+	}
+    }
+    smem_free( x );
+    smem_free( u );
+    if( err )
+    {
+	smem_free( pack );
+	return NULL;
+    }
+    pack->id = ++g_smp_pack_id;
+    if( pack->id == 0 ) pack->id = ++g_smp_pack_id;
+    return pack;
+}
+static void sampler_pack_decode( const sampler_pack* pack, uint block, void* dest ) //dest: SMP_PACK_BLOCK frames
+{
+    const uint32_t* offsets = (const uint32_t*)( pack + 1 );
+    int bits = pack->bits;
+    int channels = pack->channels;
+    int bps = 8 << bits; if( bps > 24 ) bps = 24;
+    int n = pack->frames - block * SMP_PACK_BLOCK; if( n > SMP_PACK_BLOCK ) n = SMP_PACK_BLOCK;
+    int32_t x[ SMP_PACK_BLOCK ];
+    sampler_bit_reader r;
+    r.p = (const uint8_t*)pack + offsets[ block ];
+    r.n = 0;
+    for( int ch = 0; ch < channels; ch++ )
+    {
+	r.p -= r.n / 8; //unused bytes of the previous channel
+	int mode = *r.p++;
+	int k = *r.p++;
+	r.acc = 0;
+	r.n = 0;
+	int warmup = mode == 3 ? n : mode;
+	for( int i = 0; i < warmup; i++ )
+	    x[ i ] = (int32_t)( sampler_bits_get( &r, bps ) << ( 32 - bps ) ) >> ( 32 - bps );
+	for( int i = warmup; i < n; i++ )
+	{
+	    uint32_t q = sampler_bits_get_unary( &r );
+	    uint32_t u = ( q << k ) | sampler_bits_get( &r, k );
+	    x[ i ] = (int32_t)( ( u >> 1 ) ^ ( 0 - ( u & 1 ) ) );
+	}
+	switch( mode )
+	{
+	    case 1: for( int i = 1; i < n; i++ ) x[ i ] += x[ i - 1 ]; break;
+	    case 2: for( int i = 2; i < n; i++ ) x[ i ] += 2 * x[ i - 1 ] - x[ i - 2 ]; break;
+	}
+	switch( bits )
+	{
+	    case 0: { int8_t* d = (int8_t*)dest + ch; for( int i = 0; i < n; i++ ) d[ i * channels ] = (int8_t)x[ i ]; } break;
+	    case 1: { int16_t* d = (int16_t*)dest + ch; for( int i = 0; i < n; i++ ) d[ i * channels ] = (int16_t)x[ i ]; } break;
+	    case 2: { float* d = (float*)dest + ch; for( int i = 0; i < n; i++ ) d[ i * channels ] = (float)x[ i ] / 8388608.0F; } break;
+	}
+    }
+}
+//Decode the packed data into the PCM buffer (pack->pcm_size bytes):
+static void* sampler_pack_unpack_all( const sampler_pack* pack )
+{
+    int8_t* pcm = (int8_t*)SMEM_ZALLOC( pack->pcm_size );
+    if( !pcm ) return NULL;
+    for( uint b = 0; b < pack->blocks; b++ )
+	sampler_pack_decode( pack, b, pcm + (size_t)b * SMP_PACK_BLOCK * pack->frame_size );
+    return pcm;
+}
+static int8_t* sampler_pack_get_block( sampler_pack_cache* c, const sampler_pack* pack, uint block )
+{
+    c->clock++;
+    int oldest = 0;
+    for( int i = 0; i < SMP_PACK_CACHE_BLOCKS; i++ )
+    {
+	if( c->id[ i ] == pack->id && c->block[ i ] == block ) 
+	{
+	    c->stamp[ i ] = c->clock;
+	    return (int8_t*)( c + 1 ) + i * SMP_PACK_BLOCK * c->frame_size;
+	}
+	if( c->stamp[ i ] < c->stamp[ oldest ] ) oldest = i;
+    }
+    int8_t* dest = (int8_t*)( c + 1 ) + oldest * SMP_PACK_BLOCK * c->frame_size;
+    sampler_pack_decode( pack, block, dest );
+    c->id[ oldest ] = pack->id;
+    c->block[ oldest ] = block;
+    c->stamp[ oldest ] = c->clock;
+    return dest;
+}
+//Copy frames [w0, w1) to dest:
+static void sampler_pack_get_frames( sampler_pack_cache* c, const sampler_pack* pack, SMPPTR w0, SMPPTR w1, int8_t* dest )
+{
+    int fs = pack->frame_size;
+    while( w0 < w1 )
+    {
+	uint b = w0 / SMP_PACK_BLOCK;
+	SMPPTR b0 = b * SMP_PACK_BLOCK;
+	SMPPTR n = b0 + SMP_PACK_BLOCK - w0; if( n > w1 - w0 ) n = w1 - w0;
+	smem_copy( dest, sampler_pack_get_block( c, pack, b ) + ( w0 - b0 ) * fs, n * fs );
+	dest += n * fs;
+	w0 += n;
+    }
+}
+//Window for the loop points (decoded from the block cache); a = min( reppnt, SMP_PACK_MARGIN ); b = min( smp_len - repend, SMP_PACK_MARGIN );
+//short loop (a + replen + b <= SMP_PACK_SEAM): frames [ reppnt - a; repend + b );
+//long loop: frames [ reppnt - a; reppnt + SMP_PACK_MARGIN ) + [ repend - SMP_PACK_MARGIN; repend + b ) =
+//virtual sample with the loop of SMP_PACK_MARGIN * 2 frames: near the loop points it reads the same frames as the original sample.
+static int8_t* sampler_pack_get_loop( sampler_pack_cache* c, const sampler_pack* pack, SMPPTR reppnt, SMPPTR replen, SMPPTR smp_len )
+{
+    c->clock++;
+    int oldest = 0;
+    for( int i = 0; i < SMP_PACK_LOOPS; i++ )
+    {
+	sampler_pack_loop* l = &c->loop[ i ];
+	if( l->id == pack->id && l->reppnt == reppnt && l->replen == replen && l->smp_len == smp_len )
+	{
+	    l->stamp = c->clock;
+	    return l->data;
+	}
+	if( l->stamp < c->loop[ oldest ].stamp ) oldest = i;
+    }
+    sampler_pack_loop* l = &c->loop[ oldest ];
+    SMPPTR repend = reppnt + replen;
+    SMPPTR a = reppnt; if( a > SMP_PACK_MARGIN ) a = SMP_PACK_MARGIN;
+    SMPPTR b = smp_len - repend; if( b > SMP_PACK_MARGIN ) b = SMP_PACK_MARGIN;
+    if( a + replen + b <= SMP_PACK_SEAM )
+    {
+	sampler_pack_get_frames( c, pack, reppnt - a, repend + b, l->data );
+    }
+    else
+    {
+	sampler_pack_get_frames( c, pack, reppnt - a, reppnt + SMP_PACK_MARGIN, l->data );
+	sampler_pack_get_frames( c, pack, repend - SMP_PACK_MARGIN, repend + b, l->data + ( a + SMP_PACK_MARGIN ) * pack->frame_size );
+    }
+    l->id = pack->id;
+    l->reppnt = reppnt;
+    l->replen = replen;
+    l->smp_len = smp_len;
+    l->stamp = c->clock;
+    return l->data;
+}
+//Memory used by the packed samples of the module: PCM size -> packed data + decode cache (frame_size = the cache block frame size):
+static size_t sampler_pack_memory( int mod_num, psynth_net* net, size_t* pcm_size, int frame_size )
+{
+    size_t size = 0;
+    size_t pcm = 0;
+    for( int s = 0; s < MAX_SAMPLES; s++ )
+    {
+	sampler_pack* pack = (sampler_pack*)psynth_get_chunk_data( mod_num, CHUNK_SMP_PACKED( s ), net );
+	if( !pack ) continue;
+	size += smem_get_size( pack );
+	pcm += pack->pcm_size;
+	if( pack->frame_size > frame_size ) frame_size = pack->frame_size;
+    }
+    if( pcm_size ) *pcm_size = pcm;
+    if( pcm == 0 ) return 0;
+    return size + SMP_PACK_CACHE_SIZE( frame_size );
+}
+static void sampler_pack_remove( int mod_num, int smp_num, psynth_net* net )
+{
+    MODULE_DATA* data = (MODULE_DATA*)net->mods[ mod_num ].data_ptr;
+    if( !psynth_get_chunk_data( mod_num, CHUNK_SMP_PACKED( smp_num ), net ) ) return;
+    psynth_remove_chunk( mod_num, CHUNK_SMP_PACKED( smp_num ), net );
+    size_t pcm_size = 0;
+    sampler_pack_memory( mod_num, net, &pcm_size, 0 );
+    if( pcm_size == 0 && data->pack_cache )
+    {
+	//No packed samples:
+	smem_free( data->pack_cache );
+	data->pack_cache = NULL;
+    }
+}
+//PCM -> packed; the caller must lock the module:
+static int sampler_pack_sample( int mod_num, int smp_num, psynth_net* net )
+{
+    MODULE_DATA* data = (MODULE_DATA*)net->mods[ mod_num ].data_ptr;
+    if( psynth_get_chunk_data( mod_num, CHUNK_SMP_PACKED( smp_num ), net ) ) return 0;
+    sample* smp = (sample*)psynth_get_chunk_data( mod_num, CHUNK_SMP( smp_num ), net );
+    void* smp_data = psynth_get_chunk_data( mod_num, CHUNK_SMP_DATA( smp_num ), net );
+    if( !smp || !smp_data ) return -1;
+    size_t size = 0;
+    uint flags = 0;
+    int freq = 0;
+    if( psynth_get_chunk_info( mod_num, CHUNK_SMP_DATA( smp_num ), net, &size, &flags, &freq ) ) return -1;
+    int channels = ( smp->type & SAMPLE_TYPE_FLAG_STEREO ) ? 2 : 1;
+    sampler_pack* pack = sampler_pack_encode( smp_data, smp->length, size, ( smp->type >> 4 ) & 3, channels );
+    if( !pack ) return -1;
+    //Memory gain (all packed samples of the module + decode cache):
+    int frame_size = pack->frame_size;
+    if( data->pack_cache && data->pack_cache->frame_size > frame_size ) frame_size = data->pack_cache->frame_size;
+    size_t pcm_size = 0;
+    size_t packed_size = sampler_pack_memory( mod_num, net, &pcm_size, frame_size );
+    if( packed_size == 0 ) packed_size = SMP_PACK_CACHE_SIZE( frame_size );
+    if( packed_size + smem_get_size( pack ) >= pcm_size + size ) 
+    {
+	//No gain:
+	smem_free( pack );
+	return -1;
+    }
+    if( !data->pack_cache || data->pack_cache->frame_size < frame_size )
+    {
+	sampler_pack_cache* cache = (sampler_pack_cache*)SMEM_ZALLOC( SMP_PACK_CACHE_SIZE( frame_size ) );
+	if( !cache ) { smem_free( pack ); return -1; }
+	cache->frame_size = frame_size;
+	smem_free( data->pack_cache );
+	data->pack_cache = cache;
+    }
+    psynth_chunk c;
+    c.data = pack;
+    c.flags = flags | PS_CHUNK_FLAG_DONT_SAVE;
+    c.freq = freq;
+    psynth_new_chunk( mod_num, CHUNK_SMP_PACKED( smp_num ), &c, net );
+    if( !psynth_get_chunk_data( mod_num, CHUNK_SMP_PACKED( smp_num ), net ) ) return -1;
+    psynth_remove_chunk( mod_num, CHUNK_SMP_DATA( smp_num ), net );
+    return 0;
+}
+//Packed -> PCM; the caller must lock the module:
+static int sampler_unpack_sample( int mod_num, int smp_num, psynth_net* net )
+{
+    sampler_pack* pack = (sampler_pack*)psynth_get_chunk_data( mod_num, CHUNK_SMP_PACKED( smp_num ), net );
+    if( !pack ) return -1;
+    uint flags = 0;
+    int freq = 0;
+    psynth_get_chunk_info( mod_num, CHUNK_SMP_PACKED( smp_num ), net, 0, &flags, &freq );
+    psynth_chunk c;
+    c.data = sampler_pack_unpack_all( pack );
+    if( !c.data ) return -1;
+    c.flags = flags & ~PS_CHUNK_FLAG_DONT_SAVE;
+    c.freq = freq;
+    psynth_new_chunk( mod_num, CHUNK_SMP_DATA( smp_num ), &c, net );
+    sampler_pack_remove( mod_num, smp_num, net );
+    return 0;
+}
 static void remove_instrument_and_samples( int mod_num, psynth_net* pnet )
 {
     for( int i = 0; i < CHUNK_OPT; i++ )
     {
 	psynth_remove_chunk( mod_num, i, pnet );
     }
+    for( int i = 0; i < MAX_SAMPLES; i++ ) sampler_pack_remove( mod_num, i, pnet );
     pnet->change_counter++;
 }
 static void reset_sampler_channel( MODULE_DATA* module_data, gen_channel* ch )
@@ -358,7 +837,8 @@ static void recalc_base_pitch( int smp_num, int mod_num, MODULE_DATA* module_dat
     sample* smp = (sample*)psynth_get_chunk_data( mod_num, CHUNK_SMP( smp_num ), net );
     if( !smp ) return; 
     int freq = 0;
-    psynth_get_chunk_info( mod_num, CHUNK_SMP_DATA( smp_num ), net, 0, 0, &freq );
+    if( psynth_get_chunk_info( mod_num, CHUNK_SMP_DATA( smp_num ), net, 0, 0, &freq ) )
+	psynth_get_chunk_info( mod_num, CHUNK_SMP_PACKED( smp_num ), net, 0, 0, &freq );
     if( freq == 0 ) freq = 44100;
     int base_pitch = PS_SFREQ_TO_PITCH( freq );
     base_pitch = PS_NOTE0_PITCH / 4 - ( ( PS_NOTE0_PITCH - base_pitch ) / 4 );
@@ -817,6 +1297,7 @@ static void* create_raw_instrument_or_sample(
     if( sample_num >= 0 ) new_sample_num = sample_num;
     sample* smp;
     void* smp_data;
+    sampler_pack_remove( mod_num, new_sample_num, net );
     psynth_new_chunk( mod_num, CHUNK_SMP( new_sample_num ), sizeof( sample ), 0, 0, net );
     smp = (sample*)psynth_get_chunk_data( mod_num, CHUNK_SMP( new_sample_num ), net );
     reset_sample_pars( data_bytes, smp );
@@ -929,16 +1410,24 @@ static void save_audio_file(
     instrument* ins = (instrument*)psynth_get_chunk_data( mod_num, CHUNK_INS, net );
     sample* smp = (sample*)psynth_get_chunk_data( mod_num, CHUNK_SMP( sample_num ), net );
     void* smp_data = psynth_get_chunk_data( mod_num, CHUNK_SMP_DATA( sample_num ), net );
+    sampler_pack* pack = (sampler_pack*)psynth_get_chunk_data( mod_num, CHUNK_SMP_PACKED( sample_num ), net );
+    void* unpacked = NULL;
+    if( !smp_data && pack ) 
+    {
+	unpacked = sampler_pack_unpack_all( pack );
+	smp_data = unpacked;
+    }
     while( ins && smp && smp_data )
     {
 	uint flags = 0;
 	int freq = 0;
 	size_t sdata_size = 0;
-	if( psynth_get_chunk_info( mod_num, CHUNK_SMP_DATA( sample_num ), net, &sdata_size, &flags, &freq ) )
+	if( psynth_get_chunk_info( mod_num, unpacked ? CHUNK_SMP_PACKED( sample_num ) : CHUNK_SMP_DATA( sample_num ), net, &sdata_size, &flags, &freq ) )
 	{
 	    slog( "Can't get sample properties\n" );
-	    return;
+	    break;
 	}
+	if( unpacked ) sdata_size = pack->pcm_size;
 	if( freq == 0 ) freq = 44100;
 	sfs_sample_format sample_format = SFMT_INT8;
 	int channels = ( ( flags & PS_CHUNK_SMP_CH_MASK ) >> PS_CHUNK_SMP_CH_OFFSET ) + 1;
@@ -975,6 +1464,7 @@ static void save_audio_file(
 	sfs_sound_encoder_deinit( &e );
 	break;
     }
+    smem_free( unpacked );
 #ifdef SUNVOX_GUI
     if( module_data->wm )
 	hide_status_message( module_data->wm );
@@ -983,6 +1473,7 @@ static void save_audio_file(
 static void load_xi_sample_data( sfs_file f, int mod_num, MODULE_DATA* module_data, psynth_net* net, sample* src_smp, int dest_slot, bool psytexx_ext )
 {
     net->change_counter++;
+    sampler_pack_remove( mod_num, dest_slot, net );
     psynth_new_chunk( mod_num, CHUNK_SMP( dest_slot ), sizeof( sample ), 0, 0, net );
     sample* smp = (sample*)psynth_get_chunk_data( mod_num, CHUNK_SMP( dest_slot ), net );
     if( !smp ) return;
@@ -1384,6 +1875,7 @@ int sampler_load( const char* filename, sfs_file f, int mod_num, psynth_net* net
     {
         psynth_remove_chunk( mod_num, CHUNK_SMP( sample_num ), net );
         psynth_remove_chunk( mod_num, CHUNK_SMP_DATA( sample_num ), net );
+        sampler_pack_remove( mod_num, sample_num, net );
     }
     int rv2 = load_instrument_or_sample( filename, f, LOAD_XI_FLAG_SET_MAX_VOLUME, mod_num, net, sample_num );
     if( rv2 == 0 )
@@ -1499,17 +1991,386 @@ int sampler_par( psynth_net* net, int mod_num, int smp_num, int par_num, int par
 		    smp->start_pos = par_val;
 	    }
 	    break;
+	case 9:
+	    prev_val = psynth_get_chunk_data( mod_num, CHUNK_SMP_PACKED( smp_num ), net ) != NULL;
+	    if( set && ( par_val != 0 ) != ( prev_val != 0 ) )
+	    {
+		if( smutex_lock( psynth_get_mutex( mod_num, net ) ) == 0 )
+		{
+		    if( par_val )
+			sampler_pack_sample( mod_num, smp_num, net );
+		    else
+			sampler_unpack_sample( mod_num, smp_num, net );
+		    smutex_unlock( psynth_get_mutex( mod_num, net ) );
+		}
+	    }
+	    return prev_val;
 	default: break;
     }
     net->change_counter++;
     return prev_val;
 }
+//Fast path of sampler_render() (one voice): forward playback without loop/end crossing inside the span;
+//same math as the generic loop, but without the per-frame loop handling and offset checks
+//(several voices at once - see sampler_render_lanes()):
+#define SAMPLER_FAST_LOOP( CODE ) \
+    for( int i = 0; i < frames; i++ ) \
+    { \
+	SMPPTR s_offset = ptr_h; \
+	CODE; \
+	PSYNTH_FP64_ADD( ptr_h, ptr_l, delta_h, delta_l ) \
+    }
+#define SAMPLER_FAST_NOINT( SRC, SHIFT, CONV ) \
+    if( out1 ) \
+    { \
+	SAMPLER_FAST_LOOP( \
+	    SMPPTR s_xoffset = s_offset << 1; \
+	    CONV( s0, SRC[ s_xoffset ], SHIFT ); out0[ i ] = s0; \
+	    CONV( s1, SRC[ s_xoffset + 1 ], SHIFT ); out1[ i ] = s1; ) \
+    } \
+    else \
+    { \
+	SAMPLER_FAST_LOOP( CONV( s0, SRC[ s_offset ], SHIFT ); out0[ i ] = s0; ) \
+    }
+#define SAMPLER_FAST_INT_CONV( res, val, SHIFT ) PS_INT16_TO_STYPE( res, (int)(val) << SHIFT )
+#define SAMPLER_FAST_FLOAT_CONV( res, val, SHIFT ) res = (val) * PS_STYPE_ONE
+#define SAMPLER_FAST_LIN_INT( SRC, SHIFT ) \
+    { \
+	int iv1; \
+	int iv2; \
+	uint intr = ptr_l >> ( PSYNTH_FP64_PREC - INTERP_PREC ); \
+	uint intr2 = ( 1 << INTERP_PREC ) - 1 - intr; \
+	if( stereo ) \
+	{ \
+	    SMPPTR s_xoffset = s_offset << 1; \
+	    iv1 = SRC[ s_xoffset ]; iv1 <<= SHIFT; iv1 *= intr2; \
+	    iv2 = SRC[ s_xoffset + 2 ]; iv2 <<= SHIFT; iv2 *= intr; \
+	    iv1 += iv2; iv1 >>= INTERP_PREC; \
+	    PS_INT16_TO_STYPE( s0, iv1 ); \
+	    iv1 = SRC[ s_xoffset + 1 ]; iv1 <<= SHIFT; iv1 *= intr2; \
+	    iv2 = SRC[ s_xoffset + 3 ]; iv2 <<= SHIFT; iv2 *= intr; \
+	    iv1 += iv2; iv1 >>= INTERP_PREC; \
+	    PS_INT16_TO_STYPE( s1, iv1 ); \
+	    out1[ i ] = s1; \
+	} \
+	else \
+	{ \
+	    iv1 = SRC[ s_offset ]; iv1 <<= SHIFT; iv1 *= intr2; \
+	    iv2 = SRC[ s_offset + 1 ]; iv2 <<= SHIFT; iv2 *= intr; \
+	    iv1 += iv2; iv1 >>= INTERP_PREC; \
+	    PS_INT16_TO_STYPE( s0, iv1 ); \
+	} \
+	out0[ i ] = s0; \
+    }
+#define SAMPLER_FAST_LIN_FLOAT( SRC ) \
+    { \
+	float iv1; \
+	float iv2; \
+	uint intr = ptr_l >> ( PSYNTH_FP64_PREC - INTERP_PREC ); \
+	uint intr2 = ( 1 << INTERP_PREC ) - 1 - intr; \
+	if( stereo ) \
+	{ \
+	    SMPPTR s_xoffset = s_offset << 1; \
+	    iv1 = SRC[ s_xoffset ]; iv1 *= (float)intr2 / 32768.0F; \
+	    iv2 = SRC[ s_xoffset + 2 ]; iv2 *= (float)intr / 32768.0F; \
+	    iv1 += iv2; \
+	    s0 = iv1 * PS_STYPE_ONE; \
+	    iv1 = SRC[ s_xoffset + 1 ]; iv1 *= (float)intr2 / 32768.0F; \
+	    iv2 = SRC[ s_xoffset + 3 ]; iv2 *= (float)intr / 32768.0F; \
+	    iv1 += iv2; \
+	    s1 = iv1 * PS_STYPE_ONE; \
+	    out1[ i ] = s1; \
+	} \
+	else \
+	{ \
+	    iv1 = SRC[ s_offset ]; iv1 *= (float)intr2 / 32768.0F; \
+	    iv2 = SRC[ s_offset + 1 ]; iv2 *= (float)intr / 32768.0F; \
+	    iv1 += iv2; \
+	    s0 = iv1 * PS_STYPE_ONE; \
+	} \
+	out0[ i ] = s0; \
+    }
+#define SAMPLER_FAST_SPLINE_CH( SRC, X, DIV, RES ) \
+    { \
+	PS_STYPE2 y0 = SRC[ X - ch_step ]; \
+	PS_STYPE2 y1 = SRC[ X ]; \
+	PS_STYPE2 y2 = SRC[ X + ch_step ]; \
+	PS_STYPE2 y3 = SRC[ X + ch_step * 2 ]; \
+	PS_STYPE2 a = ( 3 * ( y1-y2 ) - y0 + y3 ) / 2; \
+	PS_STYPE2 b = 2 * y2 + y0 - ( 5 * y1 + y3 ) / 2; \
+	PS_STYPE2 c2 = ( y2 - y0 ) / 2; \
+	RES = ( ( ( a * mu ) + b ) * mu + c2 ) * mu + y1; \
+	RES /= DIV; \
+    }
+#define SAMPLER_FAST_SPLINE( SRC, DIV ) \
+    { \
+	PS_STYPE2 mu = (PS_STYPE2)ptr_l / (PS_STYPE2)( 1 << PSYNTH_FP64_PREC ); \
+	if( stereo ) \
+	{ \
+	    SMPPTR s_xoffset = s_offset << 1; \
+	    SAMPLER_FAST_SPLINE_CH( SRC, s_xoffset, DIV, s0 ); \
+	    SAMPLER_FAST_SPLINE_CH( SRC, s_xoffset + 1, DIV, s1 ); \
+	    out1[ i ] = s1; \
+	} \
+	else \
+	{ \
+	    SAMPLER_FAST_SPLINE_CH( SRC, s_offset, DIV, s0 ); \
+	} \
+	out0[ i ] = s0; \
+    }
+//Windowed-sinc (ctl_smp_int 3...5 - 8, 16, 32 taps):
+#define SAMPLER_SINC_TAPS( ctl_smp_int ) ( 4 << ( ( ctl_smp_int ) - 2 ) )
+static inline const float* sampler_sinc_window( const int8_t* src, int n, float* RESTRICT win )
+{
+    for( int i = 0; i < n; i++ ) win[ i ] = (float)src[ i ] * ( 1.0F / 128.0F );
+    return win;
+}
+static inline const float* sampler_sinc_window( const int16_t* src, int n, float* RESTRICT win )
+{
+    for( int i = 0; i < n; i++ ) win[ i ] = (float)src[ i ] * ( 1.0F / 32768.0F );
+    return win;
+}
+static inline const float* sampler_sinc_window( const float* src, int n, float* RESTRICT win )
+{
+    return src;
+}
+#define SAMPLER_FAST_SINC( SRC ) \
+    { \
+	float v0; \
+	float v1; \
+	psynth_sinc_kernel( coefs, sinc_table, ptr_l, taps ); \
+	if( stereo ) \
+	{ \
+	    psynth_sinc_dot2( sampler_sinc_window( SRC + ( s_offset - before ) * 2, taps * 2, win ), coefs, taps, &v0, &v1 ); \
+	    PS_FLOAT_TO_STYPE( s0, v0 ); \
+	    PS_FLOAT_TO_STYPE( s1, v1 ); \
+	    out1[ i ] = s1; \
+	} \
+	else \
+	{ \
+	    v0 = psynth_sinc_dot( sampler_sinc_window( SRC + s_offset - before, taps, win ), coefs, taps ); \
+	    PS_FLOAT_TO_STYPE( s0, v0 ); \
+	} \
+	out0[ i ] = s0; \
+    }
+//Kernel table for the current pitch of the channel (created in PS_CMD_SETUP_FINISHED); NULL if ctl_smp_int is not a sinc mode:
+static inline const float* sampler_sinc_table( gen_channel* chan, int ctl_smp_int )
+{
+    if( ctl_smp_int < 3 ) return NULL;
+    uint delta = 0xFFFFFFFF;
+    if( (uint)chan->delta_h < 0xFFFF ) delta = ( (uint)chan->delta_h << 16 ) | ( (uint)chan->delta_l >> ( PSYNTH_FP64_PREC - 16 ) );
+    return psynth_get_sinc_table( SAMPLER_SINC_TAPS( ctl_smp_int ), psynth_sinc_band( delta ) );
+}
+//Sample offset for the sinc tap (with the loop); -1 - outside of the sample (zero):
+static inline SMPPTR sampler_sinc_offset( SMPPTR o, SMPPTR reppnt, SMPPTR replen, uint8_t loop_type, bool inloop, SMPPTR smp_len )
+{
+    if( replen )
+    {
+	SMPPTR repend = reppnt + replen;
+	if( o >= repend )
+	{
+	    SMPPTR d = o - repend;
+	    if( loop_type == 1 ) o = reppnt + d % replen;
+	    else { d %= replen * 2; o = d < replen ? repend - 1 - d : reppnt + ( d - replen ); }
+	}
+	else if( o < reppnt && inloop )
+	{
+	    SMPPTR d = reppnt - 1 - o;
+	    if( loop_type == 1 ) o = repend - 1 - d % replen;
+	    else { d %= replen * 2; o = d < replen ? reppnt + d : repend - 1 - ( d - replen ); }
+	}
+    }
+    if( (unsigned)o >= (unsigned)smp_len ) return -1;
+    return o;
+}
+//Number of frames in the fast span (forward playback without loop/end crossing), or 0:
+static inline int sampler_fast_frames( 
+    gen_channel* chan, 
+    uint8_t smp_bits, 
+    int ctl_smp_int, 
+    SMPPTR end, //exclusive limit for the sample offsets used by the interpolation (loop end or sample length)
+    SMPPTR smp_len,
+    SMPPTR start, //min offset of the previous frame (spline)
+    int frames )
+{
+    SMPPTR ptr_h = chan->ptr_h;
+    int ptr_l = chan->ptr_l;
+    int delta_l = chan->delta_l;
+    int margin = ctl_smp_int; //1 - linear (+1 frame); 2 - spline (+2 frames)
+    int margin_before = ( ctl_smp_int == 2 ); //spline (-1 frame)
+    if( ctl_smp_int >= 3 )
+    {
+	margin = SAMPLER_SINC_TAPS( ctl_smp_int ) / 2;
+	margin_before = margin - 1;
+    }
+    if( smp_bits > 2 ) return 0;
+    if( ptr_h < start + margin_before ) return 0;
+    if( (uint)ptr_l >= ( 1 << PSYNTH_FP64_PREC ) || (uint)delta_l >= ( 1 << PSYNTH_FP64_PREC ) ) return 0;
+    end -= margin;
+    if( end > smp_len ) end = smp_len;
+    if( ptr_h >= end ) return 0;
+    //Number of frames before the limit:
+    int64_t pos = ( (int64_t)ptr_h << PSYNTH_FP64_PREC ) + ptr_l;
+    int64_t delta = ( (int64_t)chan->delta_h << PSYNTH_FP64_PREC ) + delta_l;
+    int64_t lim = (int64_t)end << PSYNTH_FP64_PREC;
+    if( delta > 0 )
+    {
+	int64_t n = ( lim - 1 - pos ) / delta + 1;
+	if( n < frames ) frames = (int)n;
+    }
+    return frames;
+}
+static inline int sampler_render_fast( 
+    gen_channel* chan, 
+    void* smp_data, 
+    uint8_t smp_bits, 
+    bool stereo, 
+    int ctl_smp_int, 
+    const float* sinc_table,
+    PS_STYPE* RESTRICT out0, 
+    PS_STYPE* RESTRICT out1, 
+    SMPPTR end, 
+    SMPPTR smp_len,
+    SMPPTR start, 
+    int frames )
+{
+    frames = sampler_fast_frames( chan, smp_bits, ctl_smp_int, end, smp_len, start, frames );
+    if( frames <= 0 ) return 0;
+    SMPPTR ptr_h = chan->ptr_h;
+    int ptr_l = chan->ptr_l;
+    SMPPTR delta_h = chan->delta_h;
+    int delta_l = chan->delta_l;
+    PS_STYPE2 s0;
+    PS_STYPE2 s1;
+    int8_t* smp8 = (int8_t*)smp_data;
+    int16_t* smp16 = (int16_t*)smp_data;
+    float* smp32f = (float*)smp_data;
+    if( !stereo ) out1 = NULL;
+    switch( ctl_smp_int )
+    {
+	case 0:
+	    switch( smp_bits )
+	    {
+		case 0: SAMPLER_FAST_NOINT( smp8, 8, SAMPLER_FAST_INT_CONV ); break;
+		case 1: SAMPLER_FAST_NOINT( smp16, 0, SAMPLER_FAST_INT_CONV ); break;
+		case 2: SAMPLER_FAST_NOINT( smp32f, 0, SAMPLER_FAST_FLOAT_CONV ); break;
+	    }
+	    break;
+	case 1:
+	    switch( smp_bits )
+	    {
+		case 0: SAMPLER_FAST_LOOP( SAMPLER_FAST_LIN_INT( smp8, 8 ) ); break;
+		case 1: SAMPLER_FAST_LOOP( SAMPLER_FAST_LIN_INT( smp16, 0 ) ); break;
+		case 2: SAMPLER_FAST_LOOP( SAMPLER_FAST_LIN_FLOAT( smp32f ) ); break;
+	    }
+	    break;
+#ifdef PS_STYPE_FLOATINGPOINT
+	case 2:
+	    {
+		int ch_step = stereo ? 2 : 1;
+		switch( smp_bits )
+		{
+		    case 0: SAMPLER_FAST_LOOP( SAMPLER_FAST_SPLINE( smp8, 128.0F ) ); break;
+		    case 1: SAMPLER_FAST_LOOP( SAMPLER_FAST_SPLINE( smp16, 32768.0F ) ); break;
+		    case 2: SAMPLER_FAST_LOOP( SAMPLER_FAST_SPLINE( smp32f, 1.0F ) ); break;
+		}
+	    }
+	    break;
+#endif
+	case 3:
+	case 4:
+	case 5:
+	    {
+		int taps = SAMPLER_SINC_TAPS( ctl_smp_int );
+		int before = taps / 2 - 1;
+		float coefs[ PSYNTH_SINC_MAX_TAPS ];
+		float win[ PSYNTH_SINC_MAX_TAPS * 2 ];
+		switch( smp_bits )
+		{
+		    case 0: SAMPLER_FAST_LOOP( SAMPLER_FAST_SINC( smp8 ) ); break;
+		    case 1: SAMPLER_FAST_LOOP( SAMPLER_FAST_SINC( smp16 ) ); break;
+		    case 2: SAMPLER_FAST_LOOP( SAMPLER_FAST_SINC( smp32f ) ); break;
+		}
+	    }
+	    break;
+	default: return 0;
+    }
+    chan->ptr_h = ptr_h;
+    chan->ptr_l = ptr_l;
+    return frames;
+}
+//Position at the loop points (the loop is on); it depends on the distances to the loop points only (the loop can be shifted):
+static inline void sampler_loop_wrap( gen_channel* chan, SMPPTR reppnt, SMPPTR replen, uint8_t loop_type )
+{
+    SMPPTR repend = reppnt + replen;
+    if( chan->ptr_h >= repend )
+    {
+	if( loop_type == 1 ) 
+	{
+	    while( 1 )
+	    {
+		chan->ptr_h -= replen;
+		if( chan->ptr_h < repend ) break;
+	    }
+	}
+	else
+	{
+	    SMPPTR rep_part = ( chan->ptr_h - reppnt ) / replen; 
+	    if( rep_part & 1 )
+	    {
+		chan->flags |= GEN_CHANNEL_FLAG_REVERSE;
+		SMPPTR temp_ptr_h = chan->ptr_h;
+		int temp_ptr_l = chan->ptr_l;
+		chan->ptr_h = reppnt + replen * ( rep_part + 1 );
+		chan->ptr_l = 0;
+		PSYNTH_FP64_SUB( chan->ptr_h, chan->ptr_l, temp_ptr_h, temp_ptr_l );
+		chan->ptr_h += reppnt;
+		if( chan->ptr_h == repend && chan->ptr_h > 0 ) 
+		{
+		    chan->ptr_h = repend - 1;
+		    chan->ptr_l = ( 1 << PSYNTH_FP64_PREC ) - 1;
+		}
+	    }
+	    else
+	    {
+		chan->flags &= ~GEN_CHANNEL_FLAG_REVERSE;
+		chan->ptr_h -= replen * rep_part;
+	    }
+	}
+    }
+    if( ( chan->flags & GEN_CHANNEL_FLAG_REVERSE ) && chan->ptr_h < reppnt )
+    {
+	SMPPTR temp_ptr_h2 = chan->ptr_h;
+	int temp_ptr_l2 = chan->ptr_l;
+	chan->ptr_h = reppnt;
+	chan->ptr_l = 0;
+	PSYNTH_FP64_SUB( chan->ptr_h, chan->ptr_l, temp_ptr_h2, temp_ptr_l2 );
+	SMPPTR rep_part = chan->ptr_h / replen;
+	chan->ptr_h += reppnt;
+	if( rep_part & 1 )
+	{
+	    chan->flags |= GEN_CHANNEL_FLAG_REVERSE;
+	    SMPPTR temp_ptr_h = chan->ptr_h;
+	    int temp_ptr_l = chan->ptr_l;
+	    chan->ptr_h = reppnt + replen * ( rep_part + 1 );
+	    chan->ptr_l = 0;
+	    PSYNTH_FP64_SUB( chan->ptr_h, chan->ptr_l, temp_ptr_h, temp_ptr_l );
+	    chan->ptr_h += reppnt;
+	}
+	else
+	{
+	    chan->flags &= ~GEN_CHANNEL_FLAG_REVERSE;
+	    chan->ptr_h -= replen * rep_part;
+	}
+    }
+}
 static inline uint sampler_render( 
     gen_channel* chan, 
     instrument* ins, 
     sample* smp, 
     void* smp_data,
     int ctl_smp_int, 
+    const float* sinc_table, //for ctl_smp_int 3...5 (sinc)
     PS_STYPE** outputs, 
     int outputs_num, 
     int frames )
@@ -1547,80 +2408,87 @@ static inline uint sampler_render(
 	    }
 	}
     }
+    bool fast = !smp_stereo || out1;
     int i = 0;
+#ifdef SAMPLER_SIMD
+    if( chan->lane_frames )
+    {
+	//Rendered ahead by the voice lanes; the position is already after these frames:
+	i = chan->lane_frames;
+	if( i > frames ) i = frames;
+	for( int p = 0; p < ( smp_stereo ? 2 : 1 ); p++ )
+	{
+	    PS_STYPE* RESTRICT src = chan->lane_buf + p * SAMPLER_LANE_FRAMES;
+	    PS_STYPE* RESTRICT outx = outputs[ p ];
+	    for( int i2 = 0; i2 < i; i2++ ) outx[ i2 ] = src[ i2 ];
+	}
+	chan->lane_buf += i;
+	chan->lane_frames -= i;
+    }
+#endif
     for( ; i < frames; i++ )
     {
-	if( replen )
+	if( fast && ( chan->flags & GEN_CHANNEL_FLAG_REVERSE ) == 0 )
 	{
-	    if( chan->ptr_h >= repend )
+	    int n = sampler_render_fast( 
+		chan, smp_data, smp_bits, smp_stereo, ctl_smp_int, sinc_table, out0 + i, out1 ? out1 + i : NULL, 
+		replen ? repend : smp_len, smp_len, ( replen && ( chan->flags & GEN_CHANNEL_FLAG_INLOOP ) ) ? reppnt : 0, 
+		frames - i );
+	    i += n;
+	    if( i >= frames ) break;
+	}
+	if( replen ) sampler_loop_wrap( chan, reppnt, replen, loop_type );
+	SMPPTR s_offset = chan->ptr_h;
+	if( (unsigned)s_offset >= (unsigned)smp_len )
+	{
+	    chan->flags &= ~GEN_CHANNEL_FLAG_PLAYING;
+	    chan->id = ~0;
+	    break;
+	}
+        if( ctl_smp_int >= 3 )
+        {
+	    //Windowed-sinc (slow path: loop points or the sample edges inside the window):
+	    int taps = SAMPLER_SINC_TAPS( ctl_smp_int );
+	    int before = taps / 2 - 1;
+	    int ch_num = smp_stereo ? 2 : 1;
+	    float coefs[ PSYNTH_SINC_MAX_TAPS ];
+	    float win[ PSYNTH_SINC_MAX_TAPS * 2 ];
+	    if( replen && s_offset + taps / 2 >= repend ) chan->flags |= GEN_CHANNEL_FLAG_INLOOP;
+	    bool inloop = ( chan->flags & GEN_CHANNEL_FLAG_INLOOP ) != 0;
+	    for( int t = 0; t < taps; t++ )
 	    {
-		if( loop_type == 1 ) 
-		{
-		    while( 1 )
-		    {
-			chan->ptr_h -= replen;
-			if( chan->ptr_h < repend ) break;
-		    }
-		}
-		else
+		SMPPTR o = sampler_sinc_offset( s_offset - before + t, reppnt, replen, loop_type, inloop, smp_len );
+		for( int ch = 0; ch < ch_num; ch++ )
 		{
-		    SMPPTR rep_part = ( chan->ptr_h - reppnt ) / replen; 
-		    if( rep_part & 1 )
+		    float v = 0;
+		    if( o >= 0 )
 		    {
-			chan->flags |= GEN_CHANNEL_FLAG_REVERSE;
-			SMPPTR temp_ptr_h = chan->ptr_h;
-			int temp_ptr_l = chan->ptr_l;
-			chan->ptr_h = reppnt + replen * ( rep_part + 1 );
-			chan->ptr_l = 0;
-			PSYNTH_FP64_SUB( chan->ptr_h, chan->ptr_l, temp_ptr_h, temp_ptr_l );
-			chan->ptr_h += reppnt;
-			if( chan->ptr_h == repend && chan->ptr_h > 0 ) 
+			SMPPTR x = o * ch_num + ch;
+			switch( smp_bits )
 			{
-			    chan->ptr_h = repend - 1;
-			    chan->ptr_l = ( 1 << PSYNTH_FP64_PREC ) - 1;
+			    case 0: v = (float)smp8[ x ] * ( 1.0F / 128.0F ); break;
+			    case 1: v = (float)smp16[ x ] * ( 1.0F / 32768.0F ); break;
+			    case 2: v = smp32f[ x ]; break;
 			}
 		    }
-		    else
-		    {
-			chan->flags &= ~GEN_CHANNEL_FLAG_REVERSE;
-			chan->ptr_h -= replen * rep_part;
-		    }
+		    win[ t * ch_num + ch ] = v;
 		}
 	    }
-	    if( ( chan->flags & GEN_CHANNEL_FLAG_REVERSE ) && chan->ptr_h < reppnt )
+	    psynth_sinc_kernel( coefs, sinc_table, chan->ptr_l & ( ( 1 << PSYNTH_FP64_PREC ) - 1 ), taps );
+	    float v0;
+	    float v1;
+	    if( smp_stereo )
 	    {
-		SMPPTR temp_ptr_h2 = chan->ptr_h;
-		int temp_ptr_l2 = chan->ptr_l;
-		chan->ptr_h = reppnt;
-		chan->ptr_l = 0;
-		PSYNTH_FP64_SUB( chan->ptr_h, chan->ptr_l, temp_ptr_h2, temp_ptr_l2 );
-		SMPPTR rep_part = chan->ptr_h / replen;
-		chan->ptr_h += reppnt;
-		if( rep_part & 1 )
-		{
-		    chan->flags |= GEN_CHANNEL_FLAG_REVERSE;
-		    SMPPTR temp_ptr_h = chan->ptr_h;
-		    int temp_ptr_l = chan->ptr_l;
-		    chan->ptr_h = reppnt + replen * ( rep_part + 1 );
-		    chan->ptr_l = 0;
-		    PSYNTH_FP64_SUB( chan->ptr_h, chan->ptr_l, temp_ptr_h, temp_ptr_l );
-		    chan->ptr_h += reppnt;
-		}
-		else
-		{
-		    chan->flags &= ~GEN_CHANNEL_FLAG_REVERSE;
-		    chan->ptr_h -= replen * rep_part;
-		}
+		psynth_sinc_dot2( win, coefs, taps, &v0, &v1 );
+		PS_FLOAT_TO_STYPE( s1, v1 );
 	    }
-	} 
-	SMPPTR s_offset = chan->ptr_h;
-	if( (unsigned)s_offset >= (unsigned)smp_len )
-	{
-	    chan->flags &= ~GEN_CHANNEL_FLAG_PLAYING;
-	    chan->id = ~0;
-	    break;
-	}
-        if( ctl_smp_int )
+	    else
+	    {
+		v0 = psynth_sinc_dot( win, coefs, taps );
+	    }
+	    PS_FLOAT_TO_STYPE( s0, v0 );
+        }
+        else if( ctl_smp_int )
         {
 	    SMPPTR s_offset0;
 	    SMPPTR s_offset2;
@@ -1983,6 +2851,454 @@ static inline uint sampler_render(
     }
     return i;
 }
+//Frames before the next tick/subtick of the channel:
+static inline int sampler_tick_frames( gen_channel* chan, MODULE_DATA* data, int subtick_size, int frames )
+{
+    int buf_size = frames;
+    if( buf_size > ( data->tick_size2 - chan->tick_counter ) / 256 ) buf_size = ( data->tick_size2 - chan->tick_counter ) / 256;
+    if( ( data->tick_size2 - chan->tick_counter ) & 255 ) buf_size++; 
+    if( subtick_size )
+    {
+	if( buf_size > ( subtick_size - chan->subtick_counter ) / 256 ) buf_size = ( subtick_size - chan->subtick_counter ) / 256;
+	if( ( subtick_size - chan->subtick_counter ) & 255 ) buf_size++; 
+    }
+    if( buf_size > frames ) buf_size = frames;
+    if( buf_size < 0 ) buf_size = 0;
+    return buf_size;
+}
+#ifdef SAMPLER_SIMD
+//Voice lanes: SAMPLER_LANES voices (SoA) are rendered together, one voice per SIMD lane;
+//only the fast spans (see sampler_fast_frames()) of the linear and spline interpolation;
+//linear: same result as sampler_render_fast(); spline: same formula, but the float rounding may differ (-ffast-math);
+//the other stages (effect, envelopes, anticlick) remain per voice:
+struct sampler_lanes
+{
+    alignas( 16 ) int	ptr_h[ SAMPLER_LANES ];
+    alignas( 16 ) int	ptr_l[ SAMPLER_LANES ];
+    alignas( 16 ) int	delta_h[ SAMPLER_LANES ];
+    alignas( 16 ) int	delta_l[ SAMPLER_LANES ];
+    const void*		src[ SAMPLER_LANES ];
+    PS_STYPE*		out[ SAMPLER_LANES ]; //out[ lane ][ output * SAMPLER_LANE_FRAMES + i ]
+};
+static inline __m128i sampler_lanes_load( const void* p, int bytes ) //unaligned
+{
+    switch( bytes )
+    {
+	case 2: { uint16_t v; memcpy( &v, p, 2 ); return _mm_cvtsi32_si128( v ); }
+	case 4: { int v; memcpy( &v, p, 4 ); return _mm_cvtsi32_si128( v ); }
+	case 8: return _mm_loadl_epi64( (const __m128i*)p );
+	default: return _mm_loadu_si128( (const __m128i*)p );
+    }
+}
+//Two taps ( x, x + 1 ) of all lanes -> int16 pairs ( y1, y2 ) for _mm_madd_epi16(); 8-bit: << 8; y[ channel ]:
+static inline void sampler_lanes_pairs( const sampler_lanes* l, const int* h, int bits, int ch_num, __m128i* y )
+{
+    __m128i v[ SAMPLER_LANES ];
+    for( int n = 0; n < SAMPLER_LANES; n++ )
+    {
+	SMPPTR x = h[ n ] * ch_num;
+	if( bits == 0 )
+	    v[ n ] = _mm_unpacklo_epi8( _mm_setzero_si128(), sampler_lanes_load( (const int8_t*)l->src[ n ] + x, 2 * ch_num ) );
+	else
+	    v[ n ] = sampler_lanes_load( (const int16_t*)l->src[ n ] + x, 4 * ch_num );
+	if( ch_num == 2 ) v[ n ] = _mm_shufflelo_epi16( v[ n ], _MM_SHUFFLE( 3, 1, 2, 0 ) ); //L1 R1 L2 R2 -> L1 L2 R1 R2
+    }
+    __m128i v01 = _mm_unpacklo_epi32( v[ 0 ], v[ 1 ] );
+    __m128i v23 = _mm_unpacklo_epi32( v[ 2 ], v[ 3 ] );
+    y[ 0 ] = _mm_unpacklo_epi64( v01, v23 );
+    if( ch_num == 2 ) y[ 1 ] = _mm_unpackhi_epi64( v01, v23 );
+}
+//Taps ( x + first ) ... ( x + first + taps - 1 ) of all lanes -> float (without scaling); y[ channel ][ tap ]:
+static inline void sampler_lanes_taps( const sampler_lanes* l, const int* h, int first, int taps, int bits, int ch_num, __m128 (*y)[ 4 ] )
+{
+    __m128 rows[ 2 ][ SAMPLER_LANES ]; //[ channel ][ lane ]: 4 taps
+    for( int n = 0; n < SAMPLER_LANES; n++ )
+    {
+	SMPPTR x = ( h[ n ] + first ) * ch_num;
+	if( bits == 2 )
+	{
+	    const float* src = (const float*)l->src[ n ] + x;
+	    if( ch_num == 1 )
+	    {
+		if( taps == 2 )
+		    rows[ 0 ][ n ] = _mm_castsi128_ps( _mm_loadl_epi64( (const __m128i*)src ) );
+		else
+		    rows[ 0 ][ n ] = _mm_loadu_ps( src );
+	    }
+	    else
+	    {
+		__m128 a = _mm_loadu_ps( src );
+		__m128 b = taps == 2 ? a : _mm_loadu_ps( src + 4 );
+		rows[ 0 ][ n ] = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+		rows[ 1 ][ n ] = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+	    }
+	    continue;
+	}
+	__m128i v; //int16: 4 * ch_num
+	if( bits == 0 )
+	{
+	    v = sampler_lanes_load( (const int8_t*)l->src[ n ] + x, 4 * ch_num );
+	    v = _mm_srai_epi16( _mm_unpacklo_epi8( v, v ), 8 );
+	}
+	else
+	{
+	    v = sampler_lanes_load( (const int16_t*)l->src[ n ] + x, 8 * ch_num );
+	}
+	if( ch_num == 1 )
+	{
+	    rows[ 0 ][ n ] = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( v, v ), 16 ) );
+	}
+	else
+	{
+	    rows[ 0 ][ n ] = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_slli_epi32( v, 16 ), 16 ) );
+	    rows[ 1 ][ n ] = _mm_cvtepi32_ps( _mm_srai_epi32( v, 16 ) );
+	}
+    }
+    for( int ch = 0; ch < ch_num; ch++ )
+    {
+	_MM_TRANSPOSE4_PS( rows[ ch ][ 0 ], rows[ ch ][ 1 ], rows[ ch ][ 2 ], rows[ ch ][ 3 ] );
+	for( int t = 0; t < 4; t++ ) y[ ch ][ t ] = rows[ ch ][ t ];
+    }
+}
+#define SAMPLER_LANES_LINEAR( BITS, CH_NUM ) \
+{ \
+    __m128i intr = _mm_srli_epi32( ptr_l, PSYNTH_FP64_PREC - INTERP_PREC ); \
+    __m128i intr2 = _mm_sub_epi32( _mm_set1_epi32( ( 1 << INTERP_PREC ) - 1 ), intr ); \
+    if( BITS == 2 ) \
+    { \
+	__m128 y[ 2 ][ 4 ]; \
+	sampler_lanes_taps( l, h, 0, 2, BITS, CH_NUM, y ); \
+	__m128 k = _mm_set1_ps( 1.0F / 32768.0F ); \
+	__m128 w2 = _mm_mul_ps( _mm_cvtepi32_ps( intr2 ), k ); \
+	__m128 w = _mm_mul_ps( _mm_cvtepi32_ps( intr ), k ); \
+	for( int ch = 0; ch < CH_NUM; ch++ ) \
+	    res[ f ][ ch ] = _mm_add_ps( _mm_mul_ps( y[ ch ][ 0 ], w2 ), _mm_mul_ps( y[ ch ][ 1 ], w ) ); \
+    } \
+    else \
+    { \
+	__m128i y[ 2 ]; \
+	sampler_lanes_pairs( l, h, BITS, CH_NUM, y ); \
+	__m128i w = _mm_or_si128( intr2, _mm_slli_epi32( intr, 16 ) ); \
+	for( int ch = 0; ch < CH_NUM; ch++ ) \
+	{ \
+	    __m128i iv = _mm_srai_epi32( _mm_madd_epi16( y[ ch ], w ), INTERP_PREC ); \
+	    res[ f ][ ch ] = _mm_mul_ps( _mm_cvtepi32_ps( iv ), _mm_set1_ps( 1.0F / 32768.0F ) ); /*PS_INT16_TO_STYPE()*/ \
+	} \
+    } \
+}
+#define SAMPLER_LANES_SPLINE( BITS, CH_NUM ) \
+{ \
+    __m128 y[ 2 ][ 4 ]; \
+    sampler_lanes_taps( l, h, -1, 4, BITS, CH_NUM, y ); \
+    __m128 half = _mm_set1_ps( 0.5F ); \
+    __m128 mu = _mm_mul_ps( _mm_cvtepi32_ps( ptr_l ), _mm_set1_ps( 1.0F / (float)( 1 << PSYNTH_FP64_PREC ) ) ); \
+    __m128 k = _mm_set1_ps( BITS == 0 ? 1.0F / 128.0F : ( BITS == 1 ? 1.0F / 32768.0F : 1.0F ) ); \
+    for( int ch = 0; ch < CH_NUM; ch++ ) \
+    { \
+	__m128 y0 = y[ ch ][ 0 ]; \
+	__m128 y1 = y[ ch ][ 1 ]; \
+	__m128 y2 = y[ ch ][ 2 ]; \
+	__m128 y3 = y[ ch ][ 3 ]; \
+	/*a = ( 3 * ( y1-y2 ) - y0 + y3 ) / 2; b = 2 * y2 + y0 - ( 5 * y1 + y3 ) / 2; c2 = ( y2 - y0 ) / 2:*/ \
+	__m128 a = _mm_mul_ps( _mm_add_ps( _mm_sub_ps( _mm_mul_ps( _mm_set1_ps( 3 ), _mm_sub_ps( y1, y2 ) ), y0 ), y3 ), half ); \
+	__m128 b = _mm_sub_ps( _mm_add_ps( _mm_add_ps( y2, y2 ), y0 ), _mm_mul_ps( _mm_add_ps( _mm_mul_ps( _mm_set1_ps( 5 ), y1 ), y3 ), half ) ); \
+	__m128 c2 = _mm_mul_ps( _mm_sub_ps( y2, y0 ), half ); \
+	__m128 v = _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( a, mu ), b ), mu ), c2 ), mu ), y1 ); \
+	res[ f ][ ch ] = _mm_mul_ps( v, k ); \
+    } \
+}
+//PSYNTH_FP64_ADD( ptr_h, ptr_l, delta_h, delta_l ) for all lanes:
+#define SAMPLER_LANES_STEP \
+{ \
+    ptr_l = _mm_add_epi32( ptr_l, delta_l ); \
+    __m128i carry = _mm_srli_epi32( ptr_l, PSYNTH_FP64_PREC ); \
+    ptr_l = _mm_and_si128( ptr_l, _mm_set1_epi32( ( 1 << PSYNTH_FP64_PREC ) - 1 ) ); \
+    ptr_h = _mm_add_epi32( _mm_add_epi32( ptr_h, delta_h ), carry ); \
+}
+//4 frames at once: 4 frames x 4 lanes -> 4 frames of each lane; then the rest (one frame):
+#define SAMPLER_LANES_LOOP( CH_NUM, CODE ) \
+{ \
+    __m128 res[ 4 ][ 2 ]; /*[ frame ][ channel ]: all lanes*/ \
+    int i = 0; \
+    for( ; i + 4 <= frames; i += 4 ) \
+    { \
+	for( int f = 0; f < 4; f++ ) \
+	{ \
+	    _mm_store_si128( (__m128i*)h, ptr_h ); \
+	    CODE; \
+	    SAMPLER_LANES_STEP; \
+	} \
+	for( int ch = 0; ch < CH_NUM; ch++ ) \
+	{ \
+	    _MM_TRANSPOSE4_PS( res[ 0 ][ ch ], res[ 1 ][ ch ], res[ 2 ][ ch ], res[ 3 ][ ch ] ); \
+	    for( int n = 0; n < SAMPLER_LANES; n++ ) \
+		_mm_storeu_ps( l->out[ n ] + ch * SAMPLER_LANE_FRAMES + i, res[ n ][ ch ] ); \
+	} \
+    } \
+    for( ; i < frames; i++ ) \
+    { \
+	int f = 0; \
+	_mm_store_si128( (__m128i*)h, ptr_h ); \
+	CODE; \
+	SAMPLER_LANES_STEP; \
+	alignas( 16 ) float v[ SAMPLER_LANES ]; \
+	for( int ch = 0; ch < CH_NUM; ch++ ) \
+	{ \
+	    _mm_store_ps( v, res[ 0 ][ ch ] ); \
+	    for( int n = 0; n < SAMPLER_LANES; n++ ) l->out[ n ][ ch * SAMPLER_LANE_FRAMES + i ] = v[ n ]; \
+	} \
+    } \
+}
+static void sampler_lanes_render( sampler_lanes* l, int ctl_smp_int, int bits, bool stereo, int frames )
+{
+    __m128i ptr_h = _mm_load_si128( (__m128i*)l->ptr_h );
+    __m128i ptr_l = _mm_load_si128( (__m128i*)l->ptr_l );
+    __m128i delta_h = _mm_load_si128( (__m128i*)l->delta_h );
+    __m128i delta_l = _mm_load_si128( (__m128i*)l->delta_l );
+    alignas( 16 ) int h[ SAMPLER_LANES ];
+    switch( ( ctl_smp_int - 1 ) * 6 + bits * 2 + stereo )
+    {
+	case 0: SAMPLER_LANES_LOOP( 1, SAMPLER_LANES_LINEAR( 0, 1 ) ); break;
+	case 1: SAMPLER_LANES_LOOP( 2, SAMPLER_LANES_LINEAR( 0, 2 ) ); break;
+	case 2: SAMPLER_LANES_LOOP( 1, SAMPLER_LANES_LINEAR( 1, 1 ) ); break;
+	case 3: SAMPLER_LANES_LOOP( 2, SAMPLER_LANES_LINEAR( 1, 2 ) ); break;
+	case 4: SAMPLER_LANES_LOOP( 1, SAMPLER_LANES_LINEAR( 2, 1 ) ); break;
+	case 5: SAMPLER_LANES_LOOP( 2, SAMPLER_LANES_LINEAR( 2, 2 ) ); break;
+	case 6: SAMPLER_LANES_LOOP( 1, SAMPLER_LANES_SPLINE( 0, 1 ) ); break;
+	case 7: SAMPLER_LANES_LOOP( 2, SAMPLER_LANES_SPLINE( 0, 2 ) ); break;
+	case 8: SAMPLER_LANES_LOOP( 1, SAMPLER_LANES_SPLINE( 1, 1 ) ); break;
+	case 9: SAMPLER_LANES_LOOP( 2, SAMPLER_LANES_SPLINE( 1, 2 ) ); break;
+	case 10: SAMPLER_LANES_LOOP( 1, SAMPLER_LANES_SPLINE( 2, 1 ) ); break;
+	case 11: SAMPLER_LANES_LOOP( 2, SAMPLER_LANES_SPLINE( 2, 2 ) ); break;
+    }
+    _mm_store_si128( (__m128i*)l->ptr_h, ptr_h );
+    _mm_store_si128( (__m128i*)l->ptr_l, ptr_l );
+}
+//Render the beginning of the block (up to SAMPLER_LANE_FRAMES) for the groups of similar voices;
+//sampler_render() will take these frames from chan->lane_buf:
+static void sampler_render_lanes( MODULE_DATA* data, psynth_module* mod, int ctl_smp_int, int subtick_size, int frames )
+{
+    int list[ 2 * 3 * 2 ][ MAX_CHANNELS ]; //[ ( interpolation - 1 ) * 6 + sample bits * 2 + stereo ][]
+    int list_len[ 2 * 3 * 2 ];
+    int span[ MAX_CHANNELS ];
+    smem_clear( list_len, sizeof( list_len ) );
+    for( int c = 0; c < data->ctl_channels; c++ )
+    {
+	gen_channel* chan = &data->channels[ c ];
+	chan->lane_frames = 0;
+	if( ( chan->flags & GEN_CHANNEL_FLAG_PLAYING ) == 0 ) continue;
+	if( chan->flags & GEN_CHANNEL_FLAG_REVERSE ) continue;
+	if( psynth_get_chunk_data( mod, CHUNK_SMP_PACKED( chan->smp_num ) ) ) continue;
+	sample* smp = (sample*)psynth_get_chunk_data( mod, CHUNK_SMP( chan->smp_num ) );
+	void* smp_data = psynth_get_chunk_data( mod, CHUNK_SMP_DATA( chan->smp_num ) );
+	if( !smp || !smp_data ) continue;
+	int smp_int = ctl_smp_int;
+	if( smp_int >= 3 && !sampler_sinc_table( chan, smp_int ) ) smp_int = 1;
+	if( smp_int != 1 && smp_int != 2 ) continue;
+	if( chan->tick_counter == 0xFFFFFFF )
+	{
+	    chan->tick_counter = data->tick_size2;
+	    chan->subtick_counter = subtick_size;
+	}
+	//Same limits as in sampler_render():
+	int n = sampler_tick_frames( chan, data, subtick_size, frames );
+	if( n > SAMPLER_LANE_FRAMES ) n = SAMPLER_LANE_FRAMES;
+	uint8_t smp_type = smp->type;
+	uint8_t loop_type = smp_type & 3;
+	uint8_t smp_bits = ( smp_type >> 4 ) & 3;
+	SMPPTR reppnt = smp->reppnt;
+	SMPPTR replen = smp->replen;
+	if( loop_type == 0 ) replen = 0;
+	if( ( chan->flags & GEN_CHANNEL_FLAG_SUSTAIN ) == 0 && ( smp_type & SAMPLE_TYPE_FLAG_LOOPRELEASE ) ) replen = 0;
+	n = sampler_fast_frames( 
+	    chan, smp_bits, smp_int, 
+	    replen ? reppnt + replen : smp->length, smp->length, ( replen && ( chan->flags & GEN_CHANNEL_FLAG_INLOOP ) ) ? reppnt : 0, 
+	    n );
+	if( n < SAMPLER_LANES ) continue;
+	int l = ( smp_int - 1 ) * 6 + smp_bits * 2 + ( ( smp_type & SAMPLE_TYPE_FLAG_STEREO ) != 0 );
+	//Sorted by the span length (longer first), so the voices of the group have the similar spans:
+	int i = list_len[ l ]++;
+	for( ; i > 0 && span[ list[ l ][ i - 1 ] ] < n; i-- ) list[ l ][ i ] = list[ l ][ i - 1 ];
+	list[ l ][ i ] = c;
+	span[ c ] = n;
+    }
+    for( int l = 0; l < 2 * 3 * 2; l++ )
+    {
+	for( int g = 0; g + 1 < list_len[ l ]; g += SAMPLER_LANES ) //at least two voices in the group
+	{
+	    sampler_lanes lanes;
+	    int lanes_num = list_len[ l ] - g;
+	    if( lanes_num > SAMPLER_LANES ) lanes_num = SAMPLER_LANES;
+	    int group_frames = frames;
+	    for( int n = 0; n < SAMPLER_LANES; n++ )
+	    {
+		//Unused lanes: copy of the first one, with the output to the last lane_buf:
+		int c = list[ l ][ g + ( n < lanes_num ? n : 0 ) ];
+		gen_channel* chan = &data->channels[ c ];
+		lanes.ptr_h[ n ] = chan->ptr_h;
+		lanes.ptr_l[ n ] = chan->ptr_l;
+		lanes.delta_h[ n ] = chan->delta_h;
+		lanes.delta_l[ n ] = chan->delta_l;
+		lanes.src[ n ] = psynth_get_chunk_data( mod, CHUNK_SMP_DATA( chan->smp_num ) );
+		lanes.out[ n ] = data->lane_buf + ( n < lanes_num ? c : MAX_CHANNELS ) * MODULE_OUTPUTS * SAMPLER_LANE_FRAMES;
+		if( span[ c ] < group_frames ) group_frames = span[ c ];
+	    }
+	    sampler_lanes_render( &lanes, l / 6 + 1, ( l / 2 ) % 3, l & 1, group_frames );
+	    for( int n = 0; n < lanes_num; n++ )
+	    {
+		gen_channel* chan = &data->channels[ list[ l ][ g + n ] ];
+		chan->ptr_h = lanes.ptr_h[ n ];
+		chan->ptr_l = lanes.ptr_l[ n ];
+		chan->lane_buf = lanes.out[ n ];
+		chan->lane_frames = group_frames;
+	    }
+	}
+    }
+}
+#endif
+//Packed sample: sampler_render() on the windows of decoded PCM; the base pointer is shifted so that
+//the window is addressed by the absolute frame numbers, and each span is limited to keep all reads inside the window;
+//the position is wrapped at the loop points here (in the absolute frame numbers), so the spans of the long loop never cross the loop points:
+static uint sampler_render_packed( 
+    sampler_pack_cache* c,
+    sampler_pack* pack,
+    gen_channel* chan, 
+    instrument* ins, 
+    sample* smp, 
+    int ctl_smp_int, 
+    const float* sinc_table,
+    PS_STYPE** outputs, 
+    int outputs_num, 
+    int frames )
+{
+    if( !c ) return 0;
+    SMPPTR smp_len = smp->length;
+    if( (uint)smp_len > pack->frames ) return 0;
+    int fs = pack->frame_size;
+    PS_STYPE* outs[ MODULE_OUTPUTS ];
+    int i = 0;
+    while( i < frames )
+    {
+	SMPPTR reppnt = smp->reppnt;
+	SMPPTR replen = smp->replen;
+	uint8_t loop_type = smp->type & 3;
+	if( loop_type == 0 ) replen = 0;
+	else if( ( chan->flags & GEN_CHANNEL_FLAG_SUSTAIN ) == 0 && ( smp->type & SAMPLE_TYPE_FLAG_LOOPRELEASE ) ) { replen = 0; chan->flags &= ~GEN_CHANNEL_FLAG_REVERSE; }
+	SMPPTR repend = reppnt + replen;
+	if( replen )
+	{
+	    if( repend > smp_len || repend < reppnt ) break;
+	    sampler_loop_wrap( chan, reppnt, replen, loop_type );
+	}
+	bool reverse = ( chan->flags & GEN_CHANNEL_FLAG_REVERSE ) != 0;
+	SMPPTR p = chan->ptr_h;
+	int64_t pos = ( (int64_t)p << PSYNTH_FP64_PREC ) + chan->ptr_l;
+	int64_t delta = ( (int64_t)chan->delta_h << PSYNTH_FP64_PREC ) + chan->delta_l;
+	int64_t n = frames - i;
+	int8_t* base;
+	sample vsmp; //loop window = virtual sample
+	sample* rsmp = smp;
+	SMPPTR shift = 0; //absolute frame number - window frame number
+	SMPPTR lim0 = -0x7FFFFFFF; //first position of the span
+	SMPPTR lim1 = 0x7FFFFFFF; //last position of the span + 1
+	SMPPTR la = reppnt; if( la > SMP_PACK_MARGIN ) la = SMP_PACK_MARGIN;
+	SMPPTR lb = smp_len - repend; if( lb > SMP_PACK_MARGIN ) lb = SMP_PACK_MARGIN;
+	bool short_loop = la + replen + lb <= SMP_PACK_SEAM;
+	if( replen && p >= reppnt - SMP_PACK_READ_AFTER && 
+	    ( short_loop || p < reppnt + SMP_PACK_MARGIN - SMP_PACK_READ_AFTER || p >= repend - SMP_PACK_MARGIN + SMP_PACK_READ_BEFORE ) )
+	{
+	    //Loop points (the reads can jump between them):
+	    base = sampler_pack_get_loop( c, pack, reppnt, replen, smp_len );
+	    vsmp = *smp;
+	    vsmp.reppnt = la;
+	    rsmp = &vsmp;
+	    if( short_loop )
+	    {
+		shift = reppnt - la;
+		vsmp.length = la + replen + lb;
+	    }
+	    else
+	    {
+		vsmp.replen = SMP_PACK_MARGIN * 2;
+		vsmp.length = la + SMP_PACK_MARGIN * 2 + lb;
+		if( p < reppnt + SMP_PACK_MARGIN - SMP_PACK_READ_AFTER )
+		{
+		    shift = reppnt - la;
+		    lim0 = reppnt;
+		    lim1 = reppnt + SMP_PACK_MARGIN - SMP_PACK_READ_AFTER;
+		}
+		else
+		{
+		    shift = repend - SMP_PACK_MARGIN * 2 - la;
+		    lim0 = repend - SMP_PACK_MARGIN + SMP_PACK_READ_BEFORE;
+		    lim1 = repend;
+		}
+	    }
+	}
+	else if( p < 0 || p >= smp_len )
+	{
+	    base = c->seam; //nothing to read: the sample is finished
+	}
+	else
+	{
+	    uint b = p / SMP_PACK_BLOCK;
+	    SMPPTR w0 = b * SMP_PACK_BLOCK;
+	    SMPPTR w1 = w0 + SMP_PACK_BLOCK; if( w1 > smp_len ) w1 = smp_len;
+	    if( ( p - SMP_PACK_READ_BEFORE >= w0 || w0 == 0 ) && ( p + SMP_PACK_READ_AFTER < w1 || w1 == smp_len ) )
+	    {
+		base = sampler_pack_get_block( c, pack, b );
+	    }
+	    else
+	    {
+		//Block boundary:
+		w0 = p - SMP_PACK_MARGIN; if( w0 < 0 ) w0 = 0;
+		w1 = w0 + SMP_PACK_SEAM; if( w1 > smp_len ) w1 = smp_len;
+		sampler_pack_get_frames( c, pack, w0, w1, c->seam );
+		base = c->seam;
+	    }
+	    base -= (size_t)w0 * fs;
+	    if( w0 > 0 ) lim0 = w0 + SMP_PACK_READ_BEFORE;
+	    if( w1 < smp_len ) lim1 = w1 - SMP_PACK_READ_AFTER;
+	    if( replen )
+	    {
+		if( p < reppnt )
+		{
+		    //Stop before the loop points:
+		    if( lim1 > reppnt - SMP_PACK_READ_AFTER ) lim1 = reppnt - SMP_PACK_READ_AFTER;
+		    chan->flags &= ~GEN_CHANNEL_FLAG_INLOOP; //(loop points changed during playback) previous frame is taken from the window
+		}
+		else
+		{
+		    //Inside the long loop:
+		    if( lim0 < reppnt + SMP_PACK_READ_BEFORE ) lim0 = reppnt + SMP_PACK_READ_BEFORE;
+		    if( lim1 > repend - SMP_PACK_READ_AFTER ) lim1 = repend - SMP_PACK_READ_AFTER;
+		}
+	    }
+	}
+	if( (uint)chan->ptr_l >= ( 1 << PSYNTH_FP64_PREC ) || (uint)chan->delta_l >= ( 1 << PSYNTH_FP64_PREC ) ) n = 1;
+	else if( delta > 0 )
+	{
+	    int64_t n2 = n;
+	    if( reverse )
+	    {
+		if( lim0 != -0x7FFFFFFF ) n2 = ( pos - ( (int64_t)lim0 << PSYNTH_FP64_PREC ) ) / delta + 1;
+	    }
+	    else
+	    {
+		if( lim1 != 0x7FFFFFFF ) n2 = ( ( (int64_t)lim1 << PSYNTH_FP64_PREC ) - 1 - pos ) / delta + 1;
+	    }
+	    if( n2 < n ) n = n2;
+	    if( n < 1 ) n = 1;
+	}
+	for( int ch = 0; ch < outputs_num; ch++ ) outs[ ch ] = outputs[ ch ] + i;
+	chan->ptr_h -= shift;
+	uint r = sampler_render( chan, ins, rsmp, base, ctl_smp_int, sinc_table, outs, outputs_num, (int)n );
+	chan->ptr_h += shift;
+	i += r;
+	if( r < n ) break;
+    }
+    return i;
+}
 static inline void sampler_apply_volume_envelope( 
     gen_channel* chan, 
     int ctl_env_int, 
@@ -2625,7 +3941,7 @@ PS_RETTYPE MODULE_HANDLER(
 		psynth_register_ctl( mod_num, ps_get_string( STR_PS_VOLUME ), "", 0, 512, 256, 0, &data->ctl_volume, -1, 0, pnet );
 		psynth_register_ctl( mod_num, ps_get_string( STR_PS_PANNING ), "", 0, 256, 128, 0, &data->ctl_pan, 128, 0, pnet );
 		psynth_set_ctl_show_offset( mod_num, 1, -128, pnet );
-		psynth_register_ctl( mod_num, ps_get_string( STR_PS_SAMPLE_INTERPOLATION ), ps_get_string( STR_PS_SAMPLE_INTERP_TYPES ), 0, 2, 2, 1, &data->ctl_smp_int, -1, 1, pnet );
+		psynth_register_ctl( mod_num, ps_get_string( STR_PS_SAMPLE_INTERPOLATION ), ps_get_string( STR_PS_SAMPLE_INTERP_TYPES ), 0, 5, 2, 1, &data->ctl_smp_int, -1, 1, pnet );
 		psynth_register_ctl( mod_num, ps_get_string( STR_PS_ENVELOPE_INTERPOLATION ), ps_get_string( STR_PS_ENVELOPE_INTERP_TYPES ), 0, 1, 1, 1, &data->ctl_env_int, -1, 1, pnet );
 		psynth_register_ctl( mod_num, ps_get_string( STR_PS_POLYPHONY ), ps_get_string( STR_PS_CH ), 1, MAX_CHANNELS, 8, 1, &data->ctl_channels, -1, 2, pnet );
 		psynth_register_ctl( mod_num, ps_get_string( STR_PS_REC_THRESHOLD ), "", 0, 10000, 4, 0, &data->ctl_rec_threshold, -1, 3, pnet );
@@ -2671,6 +3987,10 @@ PS_RETTYPE MODULE_HANDLER(
 		data->rec_16bit = 0;
 		data->rec_play_pressed = false;
 		data->rec_frames = 0;
+		data->pack_cache = NULL;
+#ifdef SAMPLER_SIMD
+		data->lane_buf = SMEM_ALLOC2( PS_STYPE, ( MAX_CHANNELS + 1 ) * MODULE_OUTPUTS * SAMPLER_LANE_FRAMES );
+#endif
 		atomic_init( &data->rec_wp, (uint)0 );
 		atomic_init( &data->rec_thread_stop_request, (int)0 );
 		atomic_init( &data->rec_thread_state, (int)0 );
@@ -2848,6 +4168,8 @@ PS_RETTYPE MODULE_HANDLER(
                 	slog( "Sampler effect load failed (%d bytes)\n", (int)size );
                     }
                 }
+		//Sinc kernel tables for all interpolation modes (the ctl can be changed in the audio thread):
+		for( int i = 3; i <= 5; i++ ) psynth_sinc_tables_init( SAMPLER_SINC_TAPS( i ) );
 	    }
 	    retval = 1;
 	    break;
@@ -2886,6 +4208,26 @@ PS_RETTYPE MODULE_HANDLER(
                 	sfs_close( f );
             	    }
 		}
+		for( int s = 0; s < MAX_SAMPLES; s++ )
+		{
+		    //Packed samples are saved as PCM (temporary chunks; render uses the packed data):
+		    sampler_pack* pack = (sampler_pack*)psynth_get_chunk_data( mod_num, CHUNK_SMP_PACKED( s ), pnet );
+		    if( !pack || psynth_get_chunk_data( mod_num, CHUNK_SMP_DATA( s ), pnet ) ) continue;
+		    psynth_chunk c;
+		    c.data = sampler_pack_unpack_all( pack );
+		    if( !c.data ) continue;
+		    psynth_get_chunk_info( mod_num, CHUNK_SMP_PACKED( s ), pnet, 0, &c.flags, &c.freq );
+		    c.flags &= ~PS_CHUNK_FLAG_DONT_SAVE;
+		    psynth_new_chunk( mod_num, CHUNK_SMP_DATA( s ), &c, pnet );
+		}
+	    }
+	    retval = 1;
+	    break;
+	case PS_CMD_AFTER_SAVE:
+	    for( int s = 0; s < MAX_SAMPLES; s++ )
+	    {
+		if( psynth_get_chunk_data( mod_num, CHUNK_SMP_PACKED( s ), pnet ) )
+		    psynth_remove_chunk( mod_num, CHUNK_SMP_DATA( s ), pnet );
 	    }
 	    retval = 1;
 	    break;
@@ -2987,6 +4329,12 @@ PS_RETTYPE MODULE_HANDLER(
 		instrument* ins = (instrument*)psynth_get_chunk_data( mod, CHUNK_INS );
 		if( !ins ) break;
 		int ctl_smp_int = data->ctl_smp_int;
+		if( pnet->sinc_taps && ctl_smp_int >= 2 )
+		{
+		    //High quality rendering (config option "sinc_taps"): spline/sinc -> sinc with at least sinc_taps taps:
+		    int sinc_int = pnet->sinc_taps == 8 ? 3 : ( pnet->sinc_taps == 16 ? 4 : 5 );
+		    if( ctl_smp_int < sinc_int ) ctl_smp_int = sinc_int;
+		}
 #ifndef PS_STYPE_FLOATINGPOINT
 		if( ctl_smp_int == 2 ) ctl_smp_int = 1; 
 #endif
@@ -3006,9 +4354,10 @@ PS_RETTYPE MODULE_HANDLER(
 		    gen_channel* chan = &data->editor_player_channel;
 		    if( ( chan->flags & GEN_CHANNEL_FLAG_PLAYING ) == 0 ) break;
 		    sample* smp = (sample*)psynth_get_chunk_data( mod, CHUNK_SMP( chan->smp_num ) );
-		    void* smp_data = psynth_get_chunk_data( mod, CHUNK_SMP_DATA( chan->smp_num ) );
+		    sampler_pack* pack = (sampler_pack*)psynth_get_chunk_data( mod, CHUNK_SMP_PACKED( chan->smp_num ) );
+		    void* smp_data = pack ? NULL : psynth_get_chunk_data( mod, CHUNK_SMP_DATA( chan->smp_num ) );
 		    if( !smp ) break;
-		    if( !smp_data ) break;
+		    if( !smp_data && !pack ) break;
 		    data->no_active_channels = false;
 		    PS_STYPE* render_bufs[ MODULE_OUTPUTS ];
 		    if( retval == 0 )
@@ -3021,7 +4370,14 @@ PS_RETTYPE MODULE_HANDLER(
 		        for( int p = 0; p < MODULE_OUTPUTS; p++ )
 		    	    render_bufs[ p ] = psynth_get_temp_buf( mod_num, pnet, p );
 		    }
-		    int rendered = sampler_render( chan, ins, smp, smp_data, ctl_smp_int, render_bufs, MODULE_OUTPUTS, frames );
+		    int rendered;
+		    int smp_int = ctl_smp_int;
+		    const float* sinc_table = sampler_sinc_table( chan, smp_int );
+		    if( smp_int >= 3 && !sinc_table ) smp_int = 1;
+		    if( pack )
+			rendered = sampler_render_packed( data->pack_cache, pack, chan, ins, smp, smp_int, sinc_table, render_bufs, MODULE_OUTPUTS, frames );
+		    else
+			rendered = sampler_render( chan, ins, smp, smp_data, smp_int, sinc_table, render_bufs, MODULE_OUTPUTS, frames );
 		    if( rendered < frames )
 		    {
 			chan->flags &= ~GEN_CHANNEL_FLAG_PLAYING;
@@ -3053,15 +4409,19 @@ PS_RETTYPE MODULE_HANDLER(
 		    retval = 1;
 		    break;
 		}
+#endif
+#ifdef SAMPLER_SIMD
+		sampler_render_lanes( data, mod, ctl_smp_int, subtick_size, frames );
 #endif
 		for( int c = 0; c < data->ctl_channels; c++ ) 
 		{
 		    gen_channel* chan = &data->channels[ c ];
 		    if( ( chan->flags & GEN_CHANNEL_FLAG_PLAYING ) == 0 ) continue;
 		    sample* smp = (sample*)psynth_get_chunk_data( mod, CHUNK_SMP( chan->smp_num ) );
-		    void* smp_data = psynth_get_chunk_data( mod, CHUNK_SMP_DATA( chan->smp_num ) );
+		    sampler_pack* pack = (sampler_pack*)psynth_get_chunk_data( mod, CHUNK_SMP_PACKED( chan->smp_num ) );
+		    void* smp_data = pack ? NULL : psynth_get_chunk_data( mod, CHUNK_SMP_DATA( chan->smp_num ) );
 		    if( !smp ) continue;
-		    if( !smp_data ) continue;
+		    if( !smp_data && !pack ) continue;
 		    data->no_active_channels = false;
 		    chan->flags &= ~GEN_CHANNEL_FLAG_READY_TO_PLAY;
     		    if( chan->tick_counter == 0xFFFFFFF )
@@ -3084,16 +4444,7 @@ PS_RETTYPE MODULE_HANDLER(
 		    bool sample_finished = false;
 		    while( sample_finished == false )
 		    {
-			int buf_size = frames - ptr;
-			if( buf_size > ( data->tick_size2 - chan->tick_counter ) / 256 ) buf_size = ( data->tick_size2 - chan->tick_counter ) / 256;
-			if( ( data->tick_size2 - chan->tick_counter ) & 255 ) buf_size++; 
-			if( subtick_size )
-			{
-			    if( buf_size > ( subtick_size - chan->subtick_counter ) / 256 ) buf_size = ( subtick_size - chan->subtick_counter ) / 256;
-			    if( ( subtick_size - chan->subtick_counter ) & 255 ) buf_size++; 
-			}
-			if( buf_size > frames - ptr ) buf_size = frames - ptr;
-			if( buf_size < 0 ) buf_size = 0;
+			int buf_size = sampler_tick_frames( chan, data, subtick_size, frames - ptr );
 			PS_STYPE* render_bufs2[ MODULE_OUTPUTS ];
 			for( int p = 0; p < MODULE_OUTPUTS; p++ )
 			    render_bufs2[ p ] = render_bufs[ p ] + ptr;
@@ -3102,7 +4453,14 @@ PS_RETTYPE MODULE_HANDLER(
 			    if( data->anticlick_len * 2 < buf_size )
 				buf_size = data->anticlick_len * 2;
 			}
-			int rendered = sampler_render( chan, ins, smp, smp_data, ctl_smp_int, render_bufs2, MODULE_OUTPUTS, buf_size );
+			int rendered;
+			int smp_int = ctl_smp_int;
+			const float* sinc_table = sampler_sinc_table( chan, smp_int );
+			if( smp_int >= 3 && !sinc_table ) smp_int = 1;
+			if( pack )
+			    rendered = sampler_render_packed( data->pack_cache, pack, chan, ins, smp, smp_int, sinc_table, render_bufs2, MODULE_OUTPUTS, buf_size );
+			else
+			    rendered = sampler_render( chan, ins, smp, smp_data, smp_int, sinc_table, render_bufs2, MODULE_OUTPUTS, buf_size );
 			if( rendered < buf_size )
 			{
 			    buf_size = rendered;
@@ -3547,6 +4905,10 @@ PS_RETTYPE MODULE_HANDLER(
 	    psynth_sunvox_remove( data->ps );
 	    smutex_destroy( &data->rec_btn_mutex );
 	    smem_free( data->rec_buf );
+	    smem_free( data->pack_cache );
+#ifdef SAMPLER_SIMD
+	    smem_free( data->lane_buf );
+#endif
 #ifdef SUNVOX_GUI
 	    smutex_destroy( &data->gfx_mutex );
 #endif
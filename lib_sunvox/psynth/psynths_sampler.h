@@ -19,4 +19,7 @@ Set/get sample parameter:
   6 - Finetune: -128 ... 0 ... +127 (higher value = higher pitch);
   7 - Relative note: -128 ... 0 ... +127 (higher value = higher pitch);
   8 - Start position: 0 ... (sample_length - 1);
+  9 - Storage: 0 - PCM; 1 - packed (lossless compression in RAM; decoded block by block during playback);
+      the sample is packed only if it saves memory (including the decode cache of the module);
+      the packed state is not saved: the sample is saved as PCM, so set this parameter again after loading the project/module;
 */
@@ -156,6 +156,7 @@ PS_RETTYPE MODULE_HANDLER(
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_FREQ ), "", 1, 2048, 256, 0, &data->ctl_freq, -1, 0, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_CHANNELS ), ps_get_string( STR_PS_STEREO_MONO ), 0, 1, 0, 1, &data->ctl_mono, -1, 0, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_SET_PHASE ), "", 0, 256, 0, 0, &data->ctl_set_phase, -1, 0, pnet );
+	    psynth_set_ctl_flags( mod_num, 4, PSYNTH_CTL_FLAG_NO_COALESCING, pnet ); //trigger
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_FREQ_UNIT ), ps_get_string( STR_PS_LFO_FREQ_UNITS ), 0, FREQ_UNIT_MAX, 0, 1, &data->ctl_freq_units, -1, 0, pnet );
 	    psynth_register_ctl( mod_num, ps_get_string( STR_PS_EXP_AMP ), ps_get_string( STR_PS_OFF_ON ), 0, 1, 0, 1, &data->ctl_exp_amp, -1, 0, pnet );
 	    data->buf_size = pnet->sampling_freq / 25;
@@ -27,8 +27,42 @@ IN THE SOFTWARE.
 */
 
 #include "psynth_net.h"
+#ifdef LIBVORBIS_DECODER
+//Floating point decoder (libvorbis); build option MAKE_WITH_LIBVORBIS_DECODER=true:
+#define OV_EXCLUDE_STATIC_CALLBACKS
+#include "vorbis/codec.h"
+#include "vorbis/vorbisfile.h"
+typedef vorbis_info vplayer_vorbis_info;
+typedef float vplayer_smp; 
+#define vplayer_ov_open_callbacks	ov_open_callbacks
+#define vplayer_ov_info			ov_info
+#define vplayer_ov_clear		ov_clear
+#define vplayer_ov_pcm_tell		ov_pcm_tell
+#define vplayer_ov_pcm_total		ov_pcm_total
+#define vplayer_ov_pcm_seek		ov_pcm_seek
+#define vplayer_ov_time_seek		ov_time_seek
+#define VPLAYER_SMP_TO_STYPE( res, val ) PS_FLOAT_TO_STYPE( res, val )
+#define VPLAYER_INTERP( res, v1, v2, p ) PS_FLOAT_TO_STYPE( res, ( (v1) * (float)( ( ( 1 << PSYNTH_FP64_PREC ) - 1 ) - (p) ) + (v2) * (float)(p) ) * ( 1.0F / (float)( 1 << PSYNTH_FP64_PREC ) ) )
+#else
+//Integer decoder (tremor):
 #include "tremor/ivorbiscodec.h"
 #include "tremor/ivorbisfile.h"
+typedef tremor_vorbis_info vplayer_vorbis_info;
+typedef int16_t vplayer_smp; 
+#define vplayer_ov_open_callbacks	tremor_ov_open_callbacks
+#define vplayer_ov_info			tremor_ov_info
+#define vplayer_ov_clear		tremor_ov_clear
+#define vplayer_ov_pcm_tell		tremor_ov_pcm_tell
+#define vplayer_ov_pcm_total		tremor_ov_pcm_total
+#define vplayer_ov_pcm_seek		tremor_ov_pcm_seek
+#define vplayer_ov_time_seek		tremor_ov_time_seek
+#define VPLAYER_SMP_TO_STYPE( res, val ) PS_INT16_TO_STYPE( res, val )
+#define VPLAYER_INTERP( res, v1, v2, p ) \
+{ \
+    int v_ = ( ( (int)(v1) * ( ( ( 1 << PSYNTH_FP64_PREC ) - 1 ) - (p) ) ) >> PSYNTH_FP64_PREC ) + ( ( (int)(v2) * (p) ) >> PSYNTH_FP64_PREC ); \
+    PS_INT16_TO_STYPE( res, v_ ); \
+}
+#endif
 #include "psynths_vorbis_player.h"
 #include "sunvox_engine.h"
 #define MODULE_DATA	psynth_vplayer_data
@@ -49,11 +83,11 @@ struct gen_channel
     uint    		delta_l;
     OggVorbis_File  	vf;
     bool	    	vf_open;
-    tremor_vorbis_info*    	vi;
+    vplayer_vorbis_info*    	vi;
     size_t    		src_offset;
     sfs_file 		f;
     int	    		loaded;
-    int16_t    		pcmbuf[ PCMBUF_SAMPLES ]; 
+    vplayer_smp    	pcmbuf[ PCMBUF_SAMPLES ]; //decoded frames (ring buffer)
 };
 struct MODULE_DATA
 {
@@ -71,7 +105,9 @@ struct MODULE_DATA
     int	    		base_freq;
     int	    		base_pitch;
     uint*   		linear_freq_tab;
+#ifndef LIBVORBIS_DECODER
     int16_t    		pcmbuf[ PCMBUF_SAMPLES ]; 
+#endif
     ov_callbacks	vc;
     void* 		src;
     char*	    	src_file;
@@ -105,12 +141,12 @@ void vplayer_get_base_pitch( int mod_num, psynth_net* pnet )
     OggVorbis_File vf;
     data->cur_chan = MAX_CHANNELS;
     data->channels[ MAX_CHANNELS ].src_offset = 0;
-    int rv = tremor_ov_open_callbacks( (void*)data, &vf, 0, 0, data->vc );
+    int rv = vplayer_ov_open_callbacks( (void*)data, &vf, 0, 0, data->vc );
     if( rv == 0 )
     {
-	tremor_vorbis_info* vi = tremor_ov_info( &vf, -1 );
+	vplayer_vorbis_info* vi = vplayer_ov_info( &vf, -1 );
 	base_freq = vi->rate;
-	tremor_ov_clear( &vf );
+	vplayer_ov_clear( &vf );
     }
     int dist = 10000000;
     int pitch = 0;
@@ -172,7 +208,7 @@ uint64_t vplayer_get_pcm_time( int mod_num, psynth_net* pnet )
     {
 	if( data->channels[ c ].playing )
 	{
-	    return tremor_ov_pcm_tell( &data->channels[ c ].vf );
+	    return vplayer_ov_pcm_tell( &data->channels[ c ].vf );
 	}
     }
     return -1;
@@ -188,11 +224,11 @@ uint64_t vplayer_get_total_pcm_time( int mod_num, psynth_net* pnet )
     OggVorbis_File vf;
     data->cur_chan = MAX_CHANNELS;
     data->channels[ MAX_CHANNELS ].src_offset = 0;
-    int rv = tremor_ov_open_callbacks( (void*)data, &vf, 0, 0, data->vc );
+    int rv = vplayer_ov_open_callbacks( (void*)data, &vf, 0, 0, data->vc );
     if( rv == 0 )
     {
-	uint64_t t = tremor_ov_pcm_total( &vf, -1 );
-	tremor_ov_clear( &vf );
+	uint64_t t = vplayer_ov_pcm_total( &vf, -1 );
+	vplayer_ov_clear( &vf );
 	return t;
     }
     return 0;
@@ -209,7 +245,7 @@ void vplayer_set_pcm_time( int mod_num, uint64_t t, psynth_net* pnet )
     {
 	if( data->channels[ c ].playing )
 	{
-	    tremor_ov_pcm_seek( &data->channels[ c ].vf, t );
+	    vplayer_ov_pcm_seek( &data->channels[ c ].vf, t );
 	    break;
 	}
     }
@@ -255,7 +291,7 @@ int vplayer_load_file( int mod_num, const char* filename, sfs_file f, psynth_net
 	    if( data->channels[ c ].vf_open )
     	    {
 		data->cur_chan = c;
-		tremor_ov_clear( &data->channels[ c ].vf );
+		vplayer_ov_clear( &data->channels[ c ].vf );
 		data->channels[ c ].vf_open = 0;
 		data->channels[ c ].playing = 0;
 		data->channels[ c ].id = ~0;
@@ -556,7 +592,9 @@ PS_RETTYPE MODULE_HANDLER(
 	    {
 		PS_STYPE** outputs = mod->channels_out;
     		if( data->pause ) break;
+#ifndef LIBVORBIS_DECODER
 		int16_t* RESTRICT main_pcmbuf = data->pcmbuf;
+#endif
 		data->no_active_channels = 1;
 		for( int c = 0; c < data->ctl_channels; c++ )
 		{
@@ -587,21 +625,28 @@ PS_RETTYPE MODULE_HANDLER(
 			delta_h = chan->delta_h;
 			delta_l = chan->delta_l;
 		    }
-		    int16_t* RESTRICT chan_pcmbuf = chan->pcmbuf;
+		    vplayer_smp* RESTRICT chan_pcmbuf = chan->pcmbuf;
 		    while( frames > 0 && chan->playing )
 		    {
 			int read_rv = 1; 
 			while( chan->ptr_h + 1 >= chan->loaded )
 			{
+			    int current_section;
+#ifdef LIBVORBIS_DECODER
+			    //Float frames -> ring buffer (without the intermediate int16 buffer):
+			    int vi_channels = chan->vi->channels;
+			    float** pcm = NULL;
+			    read_rv = ov_read_float( &chan->vf, &pcm, ( PCMBUF_SAMPLES - 4 ) / vi_channels, &current_section );
+#else
 			    uint bytes_to_read = PCMBUF_BYTES - 8; 
 			    int pcm_offset = ( chan->loaded * chan->vi->channels * sizeof( int16_t ) ) & ( PCMBUF_BYTES - 1 );
-			    int current_section;
 			    read_rv = tremor_ov_read( &chan->vf, main_pcmbuf, bytes_to_read, &current_section );
+#endif
 			    if( read_rv <= 0 )
 			    {
 				if( read_rv == 0 && data->ctl_loop )
 				{
-				    tremor_ov_time_seek( &chan->vf, 0 );
+				    vplayer_ov_time_seek( &chan->vf, 0 );
 				}
 				else
 				{
@@ -612,6 +657,16 @@ PS_RETTYPE MODULE_HANDLER(
 			    }
 			    else
 			    {
+#ifdef LIBVORBIS_DECODER
+				uint pcm_offset = chan->loaded * vi_channels;
+				for( int ch = 0; ch < vi_channels; ch++ )
+				{
+				    float* RESTRICT pcm_src = pcm[ ch ];
+				    for( int i = 0; i < read_rv; i++ )
+					chan_pcmbuf[ ( pcm_offset + i * vi_channels + ch ) & ( PCMBUF_SAMPLES - 1 ) ] = pcm_src[ i ];
+				}
+				chan->loaded += read_rv;
+#else
 				int16_t* pcmbuf_src = main_pcmbuf;
 				for( uint i = pcm_offset / sizeof( int16_t ); i < ( pcm_offset + read_rv ) / sizeof( int16_t ); i++ )
 				{
@@ -620,6 +675,7 @@ PS_RETTYPE MODULE_HANDLER(
 				}
 				int read_frames = read_rv / ( chan->vi->channels * sizeof( int16_t ) );
 				chan->loaded += read_frames;
+#endif
 			    }
 			}
 			int ptr_h;
@@ -641,15 +697,10 @@ PS_RETTYPE MODULE_HANDLER(
 					for( frames_filled = 0; frames_filled < frames; frames_filled++ )
 					{
 					    if( ptr_h + 1 >= loaded ) break;
-					    int v1 = chan_pcmbuf[ ptr_h & ( PCMBUF_SAMPLES - 1 ) ];
-					    int v2 = chan_pcmbuf[ ( ptr_h + 1 ) & ( PCMBUF_SAMPLES - 1 ) ];
-					    v1 = v1 * ( ( ( 1 << PSYNTH_FP64_PREC ) - 1 ) - ptr_l );
-					    v1 >>= PSYNTH_FP64_PREC;
-					    v2 = v2 * ptr_l;
-					    v2 >>= PSYNTH_FP64_PREC;
-					    int v = v1 + v2;
+					    vplayer_smp v1 = chan_pcmbuf[ ptr_h & ( PCMBUF_SAMPLES - 1 ) ];
+					    vplayer_smp v2 = chan_pcmbuf[ ( ptr_h + 1 ) & ( PCMBUF_SAMPLES - 1 ) ];
 					    PS_STYPE2 s;
-					    PS_INT16_TO_STYPE( s, v );
+					    VPLAYER_INTERP( s, v1, v2, ptr_l );
 #ifdef PS_STYPE_FLOATINGPOINT
 					    if( retval == 0 ) *out = s * vol; else *out += s * vol;
 #else
@@ -666,15 +717,10 @@ PS_RETTYPE MODULE_HANDLER(
 					for( frames_filled = 0; frames_filled < frames; frames_filled++ )
 					{
 					    if( ptr_h + 1 >= loaded ) break;
-					    int v1 = chan_pcmbuf[ ( ( ptr_h * 2 ) & ( PCMBUF_SAMPLES - 1 ) ) + ch ];
-					    int v2 = chan_pcmbuf[ ( ( ( ptr_h + 1 ) * 2 ) & ( PCMBUF_SAMPLES - 1 ) ) + ch ];
-					    v1 = v1 * ( ( ( 1 << PSYNTH_FP64_PREC ) - 1 ) - ptr_l );
-					    v1 >>= PSYNTH_FP64_PREC;
-					    v2 = v2 * ptr_l;
-					    v2 >>= PSYNTH_FP64_PREC;
-					    int v = v1 + v2;
+					    vplayer_smp v1 = chan_pcmbuf[ ( ( ptr_h * 2 ) & ( PCMBUF_SAMPLES - 1 ) ) + ch ];
+					    vplayer_smp v2 = chan_pcmbuf[ ( ( ( ptr_h + 1 ) * 2 ) & ( PCMBUF_SAMPLES - 1 ) ) + ch ];
 					    PS_STYPE2 s;
-					    PS_INT16_TO_STYPE( s, v );
+					    VPLAYER_INTERP( s, v1, v2, ptr_l );
 #ifdef PS_STYPE_FLOATINGPOINT
 					    if( retval == 0 ) *out = s * vol; else *out += s * vol;
 #else
@@ -696,9 +742,9 @@ PS_RETTYPE MODULE_HANDLER(
 					    for( frames_filled = 0; frames_filled < frames; frames_filled++ )
 					    {
 						if( ptr_h >= loaded ) break;
-						int16_t v = chan_pcmbuf[ ptr_h & ( PCMBUF_SAMPLES - 1 ) ];
+						vplayer_smp v = chan_pcmbuf[ ptr_h & ( PCMBUF_SAMPLES - 1 ) ];
 						PS_STYPE s;
-						PS_INT16_TO_STYPE( s, v );
+						VPLAYER_SMP_TO_STYPE( s, v );
 						if( retval == 0 ) *out = s; else *out += s;
 						out++;
 						PSYNTH_FP64_ADD( ptr_h, ptr_l, delta_h, delta_l );
@@ -709,9 +755,9 @@ PS_RETTYPE MODULE_HANDLER(
 					    for( frames_filled = 0; frames_filled < frames; frames_filled++ )
 					    {
 						if( ptr_h >= loaded ) break;
-						int16_t v = chan_pcmbuf[ ( ( ( ptr_h * 2 ) & ( PCMBUF_SAMPLES - 1 ) ) ) + ch ];
+						vplayer_smp v = chan_pcmbuf[ ( ( ( ptr_h * 2 ) & ( PCMBUF_SAMPLES - 1 ) ) ) + ch ];
 						PS_STYPE s;
-						PS_INT16_TO_STYPE( s, v );
+						VPLAYER_SMP_TO_STYPE( s, v );
 						if( retval == 0 ) *out = s; else *out += s;
 						out++;
 						PSYNTH_FP64_ADD( ptr_h, ptr_l, delta_h, delta_l );
@@ -725,9 +771,9 @@ PS_RETTYPE MODULE_HANDLER(
 					    for( frames_filled = 0; frames_filled < frames; frames_filled++ )
 					    {
 						if( ptr_h >= loaded ) break;
-						int16_t v = chan_pcmbuf[ ptr_h & ( PCMBUF_SAMPLES - 1 ) ];
+						vplayer_smp v = chan_pcmbuf[ ptr_h & ( PCMBUF_SAMPLES - 1 ) ];
 						PS_STYPE2 s;
-						PS_INT16_TO_STYPE( s, v );
+						VPLAYER_SMP_TO_STYPE( s, v );
 #ifdef PS_STYPE_FLOATINGPOINT
 						if( retval == 0 ) *out = s * vol; else *out += s * vol;
 #else
@@ -744,9 +790,9 @@ PS_RETTYPE MODULE_HANDLER(
 					    for( frames_filled = 0; frames_filled < frames; frames_filled++ )
 					    {
 						if( ptr_h >= loaded ) break;
-						int16_t v = chan_pcmbuf[ ( ( ptr_h * 2 ) & ( PCMBUF_SAMPLES - 1 ) ) + ch ];
+						vplayer_smp v = chan_pcmbuf[ ( ( ptr_h * 2 ) & ( PCMBUF_SAMPLES - 1 ) ) + ch ];
 						PS_STYPE2 s;
-						PS_INT16_TO_STYPE( s, v );
+						VPLAYER_SMP_TO_STYPE( s, v );
 #ifdef PS_STYPE_FLOATINGPOINT
 						if( retval == 0 ) *out = s * vol; else *out += s * vol;
 #else
@@ -830,11 +876,11 @@ PS_RETTYPE MODULE_HANDLER(
 		int rv = 0;
 		if( chan->vf_open == 0 )
 		{
-		    rv = tremor_ov_open_callbacks( (void*)data, &chan->vf, 0, 0, data->vc );
+		    rv = vplayer_ov_open_callbacks( (void*)data, &chan->vf, 0, 0, data->vc );
 		}
 		else 
 		{
-		    tremor_ov_time_seek( &chan->vf, 0 );
+		    vplayer_ov_time_seek( &chan->vf, 0 );
 		}
 		if( rv == 0 )
 		{
@@ -852,7 +898,7 @@ PS_RETTYPE MODULE_HANDLER(
 		    chan->ptr_l = 0;
 		    if( chan->vf_open == 0 )
 		    {
-			chan->vi = tremor_ov_info( &chan->vf, -1 );
+			chan->vi = vplayer_ov_info( &chan->vf, -1 );
 		    }
 		    chan->loaded = 0;
 		    chan->vf_open = 1;
@@ -914,7 +960,7 @@ PS_RETTYPE MODULE_HANDLER(
                     }
                     if( new_offset >= data->src_pcm_total )
                         new_offset = data->src_pcm_total - 1;
-            	    tremor_ov_pcm_seek( &chan->vf, new_offset );
+            	    vplayer_ov_pcm_seek( &chan->vf, new_offset );
                     retval = 1;
                     break;
                 }
@@ -965,7 +1011,7 @@ PS_RETTYPE MODULE_HANDLER(
 		if( data->channels[ c ].vf_open )
 		{
 		    data->cur_chan = c;
-		    tremor_ov_clear( &data->channels[ c ].vf );
+		    vplayer_ov_clear( &data->channels[ c ].vf );
 		    data->channels[ c ].vf_open = 0;
 		}
 	    }
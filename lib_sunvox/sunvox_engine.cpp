@@ -217,6 +217,8 @@ void sunvox_engine_init(
     s->next_single_pattern_play = -1;
     s->bpm = 125;
     s->speed = 6;
+    s->proj_bpm = s->bpm;
+    s->proj_speed = s->speed;
     s->prev_bpm = 0;
     s->prev_speed = 0;
     s->sync_resolution = freq / 882;
@@ -270,7 +272,10 @@ void sunvox_engine_init(
     s->xoffset = 0;
     s->yoffset = 0;
     if( flags & SUNVOX_FLAG_MAIN )
+    {
 	s->user_commands = sring_buf_new( sizeof( sunvox_user_cmd ) * MAX_USER_COMMANDS, 0 ); 
+	s->user_ctls = sring_buf_new( USER_CTLS_BUF_BYTES, 0 );
+    }
     else
 	s->user_commands = sring_buf_new( sizeof( sunvox_user_cmd ) * MAX_USER_COMMANDS_FOR_METAMODULE, 0 );
     if( ( s->flags & SUNVOX_FLAG_NO_KBD_EVENTS ) == 0 )
@@ -283,15 +288,17 @@ void sunvox_engine_init(
     {
 	s->out_ui_events = sring_buf_new( sizeof( sunvox_ui_evt ) * MAX_UI_COMMANDS, SRING_BUF_FLAG_SINGLE_RTHREAD | SRING_BUF_FLAG_SINGLE_WTHREAD );
     }
-    s->cur_playing_pats[ 0 ] = -1;
     clean_pattern_state( &s->virtual_pat_state, s ); s->virtual_pat_tracks = 0;
-    if( !( flags & SUNVOX_FLAG_DYNAMIC_PATTERN_STATE ) )
-    {
-	s->pat_state_size = MAX_PLAYING_PATS;
-	s->pat_state = SMEM_ZALLOC2( sunvox_pattern_state, s->pat_state_size );
-	for( int i = 0; i < s->pat_state_size; i++ ) 
-	    clean_pattern_state( &s->pat_state[ i ], s );
-    }
+    if( flags & SUNVOX_FLAG_DYNAMIC_PATTERN_STATE )
+	sunvox_set_pattern_state_size( 1, s ); //grows in sunvox_reserve_pattern_state()
+    else
+	sunvox_set_pattern_state_size( MAX_PLAYING_PATS, s );
+    s->cur_playing_pats[ 0 ] = -1;
+    s->chase_back = 0;
+    atomic_init( &s->chase_middle, 1 );
+    s->chase_front = 2;
+    smutex_init( &s->tmap_mutex, 0 );
+    smutex_init( &s->pats_names_mutex, 0 );
     if( flags & SUNVOX_FLAG_CREATE_PATTERN )
     {
 	int p = sunvox_new_pattern( SUNVOX_PATTERN_DEFAULT_LINES( s ), SUNVOX_PATTERN_DEFAULT_TRACKS( SV ), 0, 0, (uint)( stime_ms() + stime_seconds() ), s );
@@ -303,6 +310,7 @@ void sunvox_engine_init(
     {
     }
     s->rand_next = stime_ms();
+    if( s->net->rand_seed >= 0 ) s->rand_next = s->net->rand_seed; //fixed seed mode (see psynth_init())
     s->velocity = 256;
 #ifndef NOMIDI
     if( ( flags & SUNVOX_FLAG_NO_MIDI ) == 0 )
@@ -369,8 +377,20 @@ void sunvox_engine_close( sunvox_engine* s )
 	s->pats_num = 0;
     }
     smem_free( s->pats_info ); s->pats_info = NULL;
+    ssymtab_delete( s->pats_names ); s->pats_names = NULL;
     smem_free( s->sorted_pats ); s->sorted_pats = NULL;
+    smem_free( s->sorted_pats_tree ); s->sorted_pats_tree = NULL;
+    smem_free( s->sorted_pats_slots ); s->sorted_pats_slots = NULL;
+    smem_free( s->cur_playing_pats ); s->cur_playing_pats = NULL;
+    smem_free( s->temp_pats ); s->temp_pats = NULL;
     smem_free( s->pat_state ); s->pat_state = NULL;
+    smem_free( s->pat_state_handled ); s->pat_state_handled = NULL;
+    sunvox_chase_reset( s );
+    smem_free( s->chase_base.items ); s->chase_base.items = NULL;
+    for( int i = 0; i < 3; i++ ) { smem_free( s->chase_result[ i ].items ); s->chase_result[ i ].items = NULL; }
+    sunvox_time_map_reset( s );
+    smutex_destroy( &s->tmap_mutex );
+    smutex_destroy( &s->pats_names_mutex );
     if( !( s->flags & SUNVOX_FLAG_NO_GUI ) )
     {
 #ifdef SUNVOX_GUI
@@ -397,6 +417,7 @@ void sunvox_engine_close( sunvox_engine* s )
     }
     smem_free( s->psynth_events );
     sring_buf_delete( s->user_commands );
+    sring_buf_delete( s->user_ctls );
     sring_buf_delete( s->out_ui_events );
     smem_free( s->kbd );
 #ifndef NOMIDI
@@ -700,6 +721,18 @@ int load_block( sunvox_load_state* state )
     }
     if( state->block_size )
     {
+	if( state->block_id == BID_CHDT && state->block_size >= SMEM_MAP_MIN_SIZE && state->s && ( state->s->flags & SUNVOX_FLAG_MAP_FILES ) )
+	{
+	    //Large chunk (sample data): reference the file pages instead of the copy
+	    void* data = sfs_map_block( state->block_size, state->f );
+	    if( data )
+	    {
+		smem_free( state->block_data );
+		state->block_data = data;
+		smem_copy( &state->block_data_int, data, 4 );
+		return 0;
+	    }
+	}
 	if( smem_get_size( state->block_data ) != state->block_size )
 	{
 	    smem_free( state->block_data );
@@ -859,6 +892,7 @@ void sunvox_rewind( int pos, int pat_num, sunvox_engine* s )
     playing = s->playing;
     if( playing ) sunvox_stop( s );
     sunvox_set_position( pos, s );
+    if( s->chase ) sunvox_chase_prepare( pos, s );
     if( playing ) sunvox_play( 0, false, pat_num, s );
 }
 static int sunvox_just_stop( sunvox_engine* s )
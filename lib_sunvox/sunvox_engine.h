@@ -10,15 +10,18 @@
 //SUNVOX_GUI - full version with GUI functions;
 //PS_STYPE_* - sample type;
 
-#define MAX_PLAYING_PATS	64 //number of simultaneously playing patterns & number of supertracks
+#define MAX_PLAYING_PATS	64 //default number of simultaneously playing patterns & number of supertracks
+#define MAX_PLAYING_PATS_LIMIT	4096 //pat_state[] can grow up to this size (without supertracks)
 #if HEAPSIZE <= 32
     #define MAX_USER_COMMANDS	256
     #define MAX_USER_COMMANDS_FOR_METAMODULE	256
+    #define USER_CTLS_BUF_BYTES	(16*1024)
     #define MAX_UI_COMMANDS	256
     #define MAX_KBD_EVENTS	256
 #else
     #define MAX_USER_COMMANDS	512
     #define MAX_USER_COMMANDS_FOR_METAMODULE	256
+    #define USER_CTLS_BUF_BYTES	(128*1024)
     #define MAX_UI_COMMANDS	512
     #define MAX_KBD_EVENTS	512
 #endif
@@ -149,7 +152,8 @@ enum
 #define NOTECMD_JUMP		137 // jump to line XXYY
 //==============================================================================================
 #define NOTECMD_CLEAN_MODULE	140 // stop the module - clear its internal buffers and put it into standby mode
-//#define NOTECMD_*		142
+#define NOTECMD_SET_CTLS	142 // set a block of controllers (from the user_ctls buffer); user command only; see sunvox_send_user_ctls()
+//#define NOTECMD_*		143
 
 struct sunvox_note
 {
@@ -222,7 +226,15 @@ struct sunvox_pattern
     uint8_t	   	fg[ 3 ];	//Foreground color
     uint8_t	    	bg[ 3 ];	//Background color
     int			icon_num;	//Icon number in the map
+
+    //Sparse event index (will not be saved with the project):
+    uint32_t*		evt_index;	//Bitmask of the non-empty tracks for each line; size = data_ysize
+    uint32_t		evt_changes;	//Content change counter; see SUNVOX_PATTERN_CHANGED()
+    uint32_t		evt_index_changes; //evt_changes value at the moment of the last index rebuild
+    bool		evt_index_user;	//Data buffer is shared with the user (sv_get_pattern_data()): the index will be rebuilt after sv_unlock_slot()
 };
+//Call it after any change of the pattern data (except the changes made through sunvox_pattern_evt_changed()):
+#define SUNVOX_PATTERN_CHANGED( pat, s ) { (pat)->evt_changes++; (s)->pats_changes++; }
 
 #define SUNVOX_PATTERN_INFO_FLAG_CLONE		( 1 << 0 )
 #define SUNVOX_PATTERN_INFO_FLAG_SELECTED	( 1 << 1 )
@@ -370,6 +382,13 @@ struct sunvox_user_cmd
     stime_ticks_t t; //0 = now
 };
 
+struct sunvox_ctl_value //for NOTECMD_SET_CTLS
+{
+    uint16_t mod;
+    uint16_t ctl;
+    uint16_t val; //0...0x8000 (same as XXYY of the controller event)
+};
+
 enum sunvox_ui_evt_type //some event from SunVox to UI
 {
     SUNVOX_UI_EVT_KBD, //keyboard event
@@ -508,6 +527,45 @@ typedef int (*tsunvox_sound_stream_control)( sunvox_stream_command cmd, void* us
 
 #define SUPERTRACK_BITARRAY_SIZE	( ( MAX_PLAYING_PATS + 31 ) / 32 )
 
+//Seek with chase (state-changing events before the new position):
+#define SUNVOX_CHASE_STEP		256 //lines between the checkpoints
+struct sunvox_chase_item
+{
+    uint32_t		key; //module << 8 | CC (controller number + 1)
+    uint16_t		val;
+    uint64_t		t; //event position: line << 32 | sorted pattern << 5 | track
+};
+#define SUNVOX_CHASE_NEW		4 //chase_middle flag: the result is ready
+struct sunvox_chase_state
+{
+    int			line; //chase_result[]: target line + 1; 0 - nothing
+    uint16_t		bpm; //0 - not changed
+    uint8_t		tpl; //0 - not changed
+    uint64_t		bpm_t;
+    uint64_t		tpl_t;
+    sunvox_chase_item*	items; //sorted by key
+    int			items_num;
+};
+
+//Cached time map (sunvox_time_map_update()):
+struct sunvox_time_map_seg
+{
+    int			line; //first line of the segment
+    uint16_t		bpm;
+    uint8_t		tpl;
+    uint		frame_add; //line length (in 1/256 frames)
+    uint64_t		frame; //segment position (in 1/256 frames)
+};
+struct sunvox_time_map_pat
+{
+    int			id; //-1 - empty slot
+    uint32_t		evt_changes;
+    int			x;
+    int			lines;
+    int			channels;
+    uint		flags;
+};
+
 struct sunvox_engine
 {
     WINDOWPTR		win; //base window (optional);
@@ -559,6 +617,8 @@ struct sunvox_engine
     uint8_t		prev_speed;
     uint16_t	    	bpm; //Beats Per Minute (One beat = 4 lines (24 ticks) on TPL 6)
     uint8_t	    	speed; //Ticks Per line
+    uint16_t		proj_bpm; //Project tempo (initial or loaded); bpm and speed may be changed by the 0F/1F effects during playback
+    uint8_t		proj_speed;
     uint8_t		tgrid; //It is actually number of lines per beat, but it only affects the UI. In future verions tgrid+TPL will be replaced by LPB (lines per beat)
     uint8_t		tgrid2;
     int			pars_changed;
@@ -569,15 +629,19 @@ struct sunvox_engine
     //For sunvox_sort_patterns() and sunvox_select_current_playing_patterns():
     int*                sorted_pats;
     int	    		sorted_pats_num;
-    int		    	cur_playing_pats[ MAX_PLAYING_PATS ]; //Current active patterns; pat_num = sorted_pats[ cur_playing_pats[ p ] ]
-    int		    	temp_pats[ MAX_PLAYING_PATS ];
+    int*		sorted_pats_tree; //Implicit interval tree: max( x + lines ) of each subtree of sorted_pats[]; [ 1 ] = root
+    int			sorted_pats_tree_leaves; //Number of leaves (power of 2)
+    int*		sorted_pats_slots; //Temp buffer for sunvox_sort_patterns()
+    int*	    	cur_playing_pats; //[ pat_state_size + 1 ] Current active patterns; pat_num = sorted_pats[ cur_playing_pats[ p ] ]
+    int*	    	temp_pats; //[ pat_state_size + 1 ]
     int		    	last_sort_pat; //Number of the last pattern (in sorted table) with X less then the cursor position
 
     int		    	proj_lines; //Project length (number of lines). Calculated in sunvox_sort_patterns()
-    uint	    	proj_len; //Project length (in frames). Calculated in play(), play_from_beginning()
+    uint64_t	    	proj_len; //Project length (in frames). Calculated in play(), play_from_beginning()
 
     //Handling events from the patterns:
-    sunvox_pattern_state*	pat_state; //[ MAX_PLAYING_PATS ];
+    sunvox_pattern_state*	pat_state; //[ pat_state_size ]; see sunvox_set_pattern_state_size()
+    uint32_t*			pat_state_handled; //[ ( pat_state_size + 31 ) / 32 ] bits; temp buffer for the audio callback
     int				pat_state_size; //pat_state[] capacity (maximum number of simultaneously playing patterns)
     uint32_t			supertrack_mute[ SUPERTRACK_BITARRAY_SIZE ]; //bits
 
@@ -585,6 +649,11 @@ struct sunvox_engine
     sunvox_pattern**	    	pats; //Empty areas (NULL patterns; or - holes) are ALLOWED. Be careful when using pattern REDO/UNDO operations...
     sunvox_pattern_info*    	pats_info;
     int				pats_num;
+    ssymtab*			pats_names; //Name -> first pattern with this name (see sunvox_get_pattern_num_by_name()); rebuilt in the user thread only
+    uint32_t			pats_names_changes; //new/remove/rename
+    uint32_t			pats_changes; //timeline changes: pattern content, size, position, flags, new/remove (see SUNVOX_PATTERN_CHANGED())
+    uint32_t			pats_names_index_changes;
+    smutex			pats_names_mutex; //rebuild of pats_names
     uint			pat_id_counter;
     int				pat_num; //For pattern editor
     int				pat_track; //For pattern editor
@@ -616,6 +685,7 @@ struct sunvox_engine
     // -> out_ui_events buffer for futher handling by UI:
     //(some events may be recorded)
     sring_buf*			user_commands; //sunvox_user_cmd 
+    sring_buf*			user_ctls; //blocks of controller values for NOTECMD_SET_CTLS: uint32_t num + sunvox_ctl_value * num; main engine only
 
     //    Notes from the external keyboards (UI THREAD: PC, ribbon/theremin, ...) ->
     // -> sunvox_send_kbd_event() ->
@@ -666,6 +736,27 @@ struct sunvox_engine
     undo_data		undo;
 #endif //!SUNVOX_LIB
 
+    //Seek with chase (sunvox_chase_prepare()):
+    bool			chase; //sunvox_rewind() will replay the controller and tempo events before the new position
+    sunvox_chase_state*		chase_points; //Lazy checkpoints: state before line N * SUNVOX_CHASE_STEP
+    int				chase_points_num;
+    uint32_t			chase_points_sig; //timeline signature of the checkpoints
+    sunvox_chase_state		chase_base; //initial controller values (project loading or sv_rewind_chase()); t = 0
+    sunvox_chase_state		chase_result[ 3 ]; //triple buffer for the audio thread (NOTECMD_PLAY):
+    int				chase_back; //user thread: the result is prepared here
+    int				chase_front; //audio thread: the result is applied from here
+    std::atomic_int		chase_middle; //index of the last prepared result | SUNVOX_CHASE_NEW
+
+    //Cached time map (from line 0; base tempo = bpm/speed):
+    smutex			tmap_mutex;
+    sunvox_time_map_seg*	tmap_segs; //tempo segments sorted by line; tmap_segs[ 0 ].line = 0
+    int				tmap_segs_num;
+    sunvox_time_map_pat*	tmap_pats; //pattern properties at the moment of the last update
+    int				tmap_pats_num;
+    uint64_t			tmap_base; //bpm, tpl, solo mode, sampling freq
+    uint32_t			tmap_pats_changes; //pats_changes at the moment of the last update
+    bool			tmap_valid;
+
     int			change_counter;
     int			prev_change_counter1; //SunVox engine
     int			prev_change_counter2; //PSynth engine
@@ -693,12 +784,15 @@ struct sunvox_render_data
     int			in_channels;
     sound_buffer_type	buffer_type;
     void*		buffer;
+    float**		planar_buffer; //optional: float32 output with separate channels (instead of buffer); channels = number of pointers
     int			frames;
     int			channels;
     int			out_latency; //desired output latency (frames); see description in sundog_sound (sound.h)
     int			out_latency2; //actual output latency (frames); see description in sundog_sound (sound.h)
     stime_ticks_t		out_time; //output time; see description in sundog_sound (sound.h)
-    sfs_sound_encoder_data**	out_file_encoders;
+    sfs_sound_encoder_data**	out_file_encoders; //[module number] (optional): module output -> encoder (0 - master)
+    void**		out_mod_buffers; //[module number] (optional): module output -> buffer (buffer_type, channels, frames); [0] is not used (master -> buffer)
+    int			out_mods_num; //size of out_file_encoders[] and out_mod_buffers[]; 0 - number of modules in the net
     bool		silence;
 };
 
@@ -749,6 +843,7 @@ int sunvox_action_handler( UNDO_HANDLER_PARS );
 #define SUNVOX_FLAG_KBD_ROUNDROBIN		( 1 << 18 ) //virtual pattern track allocation algorithm = Round-robin; instead of default tight packing;
 #define SUNVOX_FLAG_EXPORT			( 1 << 19 ) //set during sunvox_export_to_wav()
 #define SUNVOX_FLAG_IGNORE_EFF31		( 1 << 20 ) //ignore effect 31
+#define SUNVOX_FLAG_MAP_FILES			( 1 << 21 ) //large chunks are loaded as the copy-on-write file mappings (smem_map_file())
 
 int sunvox_global_init();
 int sunvox_global_deinit();
@@ -965,11 +1060,20 @@ struct sunvox_time_map_item
     uint8_t     tpl;
 };
 
-uint sunvox_get_time_map( sunvox_time_map_item* map, uint32_t* frame_map, int start_line, int len, sunvox_engine* s );
+//start_line = 0: the cached time map is used;
+uint64_t sunvox_get_time_map( sunvox_time_map_item* map, uint32_t* frame_map, int start_line, int len, sunvox_engine* s );
 int sunvox_get_proj_lines( sunvox_engine* s );
 //start_line, line_cnt - timeline segment specified in lines;
 //zero line_cnt = whole project;
-uint32_t sunvox_get_proj_frames( int start_line, int line_cnt, sunvox_engine* s ); //get project length in frames
+uint64_t sunvox_get_proj_frames( int start_line, int line_cnt, sunvox_engine* s ); //get project length in frames
+int64_t sunvox_line_to_frame( int line, sunvox_engine* s ); //O(log n); -1 - error
+int sunvox_frame_to_line( int64_t frame, sunvox_engine* s ); //O(log n); -1 - error
+void sunvox_time_map_reset( sunvox_engine* s );
+int sunvox_chase_prepare( int line, sunvox_engine* s ); //collect the controller/tempo changes before the line (for the next NOTECMD_PLAY)
+void sunvox_chase_apply( int offset, sunvox_engine* s ); //AUDIO THREAD
+void sunvox_chase_reset( sunvox_engine* s ); //remove the checkpoints
+void sunvox_chase_cancel( sunvox_engine* s ); //remove the prepared result
+void sunvox_chase_save_base( sunvox_engine* s ); //save the current controller values as the initial state of the chase
 int sunvox_export_to_wav(
     const char* name,
     sound_buffer_type buf_type,
@@ -989,6 +1093,8 @@ void sunvox_export_to_midi( const char* name, sunvox_engine* s );
 
 void sunvox_sort_patterns( sunvox_engine* s );
 int sunvox_get_mpp( sunvox_engine* s ); //Get the maximum number of simultaneously playing patterns
+void sunvox_set_pattern_state_size( int size, sunvox_engine* s ); //grow only
+void sunvox_reserve_pattern_state( int pat_num, sunvox_engine* s ); //user thread: grow the pattern state and sorting buffers for the new/moved/resized pattern (pat_num) or for all patterns (-1)
 void sunvox_select_current_playing_patterns( int first_sorted_pat, sunvox_engine* s );
 
 int sunvox_get_free_pattern_num( sunvox_engine* s );
@@ -1002,6 +1108,7 @@ void sunvox_convert_to_clone( int pat_num, int parent, sunvox_engine* s );
 void sunvox_remove_pattern( int pat_num, sunvox_engine* s );
 void sunvox_change_pattern_flags( int pat_num, uint pat_flags, uint pat_info_flags, bool reset_set, sunvox_engine* s );
 void sunvox_rename_pattern( int pat_num, const char* name, sunvox_engine* s );
+void sunvox_update_pattern_names_index( sunvox_engine* s ); //user thread: rebuild the name index if it is out of date
 int sunvox_get_pattern_num_by_name( const char* name, sunvox_engine* s );
 inline sunvox_pattern* sunvox_get_pattern( int pat_num, sunvox_engine* s )
 {
@@ -1016,6 +1123,9 @@ inline sunvox_pattern_info* sunvox_get_pattern_info( int pat_num, sunvox_engine*
     return NULL;
 }
 sunvox_note* sunvox_get_pattern_event( int pat_num, int track, int line, sunvox_engine* s );
+void sunvox_pattern_evt_index_resize( sunvox_pattern* pat, sunvox_engine* s ); //call it when the data buffer is (re)allocated
+uint32_t* sunvox_pattern_get_evt_index( sunvox_pattern* pat ); //retval: NULL (no index; scan all tracks) or bitmasks of non-empty tracks per line
+void sunvox_pattern_evt_changed( sunvox_pattern* pat, int line, sunvox_engine* s ); //one line has been changed
 int sunvox_get_free_icon_number( sunvox_engine* s );
 void sunvox_remove_icon( int num, sunvox_engine* s );
 void sunvox_make_icon( int pat_num, sunvox_engine* s );
@@ -1055,6 +1165,7 @@ void sunvox_record( sunvox_engine* s );
 //Audio callback:
 
 void sunvox_send_user_command( sunvox_user_cmd* cmd, sunvox_engine* s ); //Stop/Play/TPL/BPM/Ctl/...; some events may be recorded; for kbd use send_kbd_event!
+int sunvox_send_user_ctls( stime_ticks_t t, sunvox_ctl_value* vals, uint num, sunvox_engine* s ); //Set all these controllers at once (single command); retval: 0 or -1 (no free space)
 void sunvox_send_kbd_event( sunvox_kbd_event* evt, sunvox_engine* s ); //Call this in the main UI thread only!
 void sunvox_add_psynth_event_UNSAFE( int mod_num, psynth_event* evt, sunvox_engine* s );
 void sunvox_handle_all_commands_UNSAFE( sunvox_engine* s ); //For the single-threaded mode only!
@@ -34,6 +34,32 @@ void sunvox_send_user_command( sunvox_user_cmd* cmd, sunvox_engine* s )
     sring_buf_write( s->user_commands, cmd, sizeof( sunvox_user_cmd ) );
     sring_buf_write_unlock( s->user_commands );
 }
+int sunvox_send_user_ctls( stime_ticks_t t, sunvox_ctl_value* vals, uint num, sunvox_engine* s )
+{
+    sring_buf* b = s->user_ctls;
+    if( !b ) return -1;
+    size_t size = sizeof( uint32_t ) + num * sizeof( sunvox_ctl_value );
+    int rv = -1;
+    sring_buf_write_lock( b );
+    sring_buf_write_lock( s->user_commands );
+    //The command and its block must be written together (or not written at all):
+    if( size < b->buf_size - sring_buf_avail( b ) &&
+	sizeof( sunvox_user_cmd ) < s->user_commands->buf_size - sring_buf_avail( s->user_commands ) )
+    {
+	uint32_t n = num;
+	sring_buf_write( b, &n, sizeof( n ) );
+	sring_buf_write( b, vals, num * sizeof( sunvox_ctl_value ) );
+	sunvox_user_cmd cmd;
+	SMEM_CLEAR_STRUCT( cmd );
+	cmd.n.note = NOTECMD_SET_CTLS;
+	cmd.t = t;
+	sring_buf_write( s->user_commands, &cmd, sizeof( cmd ) );
+	rv = 0;
+    }
+    sring_buf_write_unlock( s->user_commands );
+    sring_buf_write_unlock( b );
+    return rv;
+}
 static void sunvox_send_ui_event_kbd( sunvox_kbd_event* evt, bool ftrack_first, int ftrack, sunvox_engine* s )
 {
     if( !s->out_ui_events ) return;
@@ -502,6 +528,7 @@ static void sunvox_handle_command(
     {
 	case NOTECMD_PLAY:
 	    {
+		sunvox_chase_apply( offset, s );
 		uint one_tick = PSYNTH_TICK_SIZE( s->net->sampling_freq, s->bpm );
 		s->playing = 1;
 		s->tick_counter = one_tick;
@@ -990,6 +1017,7 @@ delay:
 			{
 			    sunvox_note* snote2 = snote - track_num + tn;
 			    memset( snote2, 0, sizeof( sunvox_note ) );
+			    sunvox_pattern_evt_changed( pat, ( snote2 - pat->data ) / pat->data_xsize, s );
 			    s->change_counter++;
 			}
 		    }
@@ -1055,6 +1083,7 @@ delay:
 				src += src_pat->data_xsize;
 				dest += dest_pat->data_xsize;
 			    }
+			    SUNVOX_PATTERN_CHANGED( dest_pat, s );
 			}
 		    }
 		    s->change_counter++;
@@ -1093,6 +1122,7 @@ delay:
 			    case 6: snote2->ctl_val = ( snote2->ctl_val & 0xFF00 ) | ( v & 255 ); break; 
 			    case 7: snote2->ctl_val = v; break; 
 			}
+			sunvox_pattern_evt_changed( pat, ( snote2 - pat->data ) / pat->data_xsize, s );
 			s->change_counter++;
 		    }
 		}
@@ -1107,6 +1137,38 @@ static void sunvox_reset_track_effect( sunvox_track_eff* eff )
     eff->vel_speed = 0;
     eff->arpeggio = 0;
 }
+static void sunvox_handle_user_ctls( int ptr, sunvox_engine* s )
+{
+    sring_buf* b = s->user_ctls;
+    if( !b ) return;
+    sring_buf_read_lock( b );
+    uint32_t num = 0;
+    if( sring_buf_read( b, &num, sizeof( num ) ) == sizeof( num ) )
+    {
+	sring_buf_next( b, sizeof( num ) );
+	sunvox_reset_track_effect( &s->virtual_pat_state.effects[ 0 ] );
+	sunvox_note n;
+	SMEM_CLEAR_STRUCT( n );
+	sunvox_ctl_value vals[ 64 ];
+	while( num )
+	{
+	    uint cnt = num;
+	    if( cnt > 64 ) cnt = 64;
+	    size_t size = cnt * sizeof( sunvox_ctl_value );
+	    if( sring_buf_read( b, vals, size ) != size ) break;
+	    sring_buf_next( b, size );
+	    for( uint i = 0; i < cnt; i++ )
+	    {
+		n.mod = vals[ i ].mod + 1;
+		n.ctl = ( vals[ i ].ctl + 1 ) << 8;
+		n.ctl_val = vals[ i ].val;
+		sunvox_handle_command( ptr, &n, s->net, SUNVOX_VIRTUAL_PATTERN, 0, s );
+	    }
+	    num -= cnt;
+	}
+    }
+    sring_buf_read_unlock( b );
+}
 static void sunvox_handle_track_effects( 
     int offset,
     psynth_net* net,
@@ -2149,7 +2211,11 @@ static bool sunvox_render_piece_of_sound_level2(
 	    {
         	if( cmd.t == 0 || ( ( out_time - ( cmd.t + evt_latency ) ) & 0x80000000 ) == 0 )
         	{
-        	    if( cmd.ch < MAX_PATTERN_TRACKS )
+        	    if( cmd.n.note == NOTECMD_SET_CTLS )
+        	    {
+        		sunvox_handle_user_ctls( ptr, s );
+        	    }
+        	    else if( cmd.ch < MAX_PATTERN_TRACKS )
         	    {
         		sunvox_reset_track_effect( &s->virtual_pat_state.effects[ cmd.ch ] );
 			sunvox_handle_command( ptr, &cmd.n, s->net, SUNVOX_VIRTUAL_PATTERN, cmd.ch, s );
@@ -2384,8 +2450,8 @@ static bool sunvox_render_piece_of_sound_level2(
 			    }
 			}
 		    }
-		    uint32_t state_handled[ SUPERTRACK_BITARRAY_SIZE ];
-		    for( int i = 0; i < SUPERTRACK_BITARRAY_SIZE; i++ ) state_handled[ i ] = 0;
+		    uint32_t* state_handled = s->pat_state_handled;
+		    smem_clear( state_handled, ( ( s->pat_state_size + 31 ) / 32 ) * sizeof( uint32_t ) );
 		    for( int i = 0; i < p; i++ )
 		    {
 		        s->cur_playing_pats[ i ] = s->temp_pats[ i ];
@@ -2457,11 +2523,19 @@ static bool sunvox_render_piece_of_sound_level2(
 			    pat_info->track_status = 0;
 			    continue;
 			}
-			int pat_ptr = ( s->line_counter - pat_info->x ) * pat->data_xsize;
+			int pat_line = s->line_counter - pat_info->x;
+			int pat_ptr = pat_line * pat->data_xsize;
+			uint32_t* evt_index = sunvox_pattern_get_evt_index( pat ); //NULL - check all tracks
 			for( int track = 0; track < pat->channels; track++ )
 			{
-			    sunvox_handle_command( ptr, &pat->data[ pat_ptr ], s->net, pat_num, track, s );
-			    pat_ptr++;
+			    if( evt_index )
+			    {
+				uint32_t tracks = evt_index[ pat_line ] >> track;
+				if( !tracks ) break;
+				while( !( tracks & 1 ) ) { tracks >>= 1; track++; }
+			    }
+			    sunvox_handle_command( ptr, &pat->data[ pat_ptr + track ], s->net, pat_num, track, s );
+			    evt_index = sunvox_pattern_get_evt_index( pat ); //the effects 0x38...0x3D can change the pattern
 			}
 			if( !s->playing ) break;
 		    }
@@ -2502,8 +2576,8 @@ static bool sunvox_render_piece_of_sound_level2(
 		    }
 		    one_tick = sunvox_check_speed( ptr, s );
 		} 
-		uint32_t state_handled[ SUPERTRACK_BITARRAY_SIZE ];
-		for( int i = 0; i < SUPERTRACK_BITARRAY_SIZE; i++ ) state_handled[ i ] = 0;
+		uint32_t* state_handled = s->pat_state_handled;
+		smem_clear( state_handled, ( ( s->pat_state_size + 31 ) / 32 ) * sizeof( uint32_t ) );
 		for( int i = 0; i < s->pat_state_size; i++ )
 		{
 		    int sp = s->cur_playing_pats[ i ];
@@ -2537,18 +2611,34 @@ static bool sunvox_render_piece_of_sound_level2(
     psynth_render_setup( frames, rdata->out_time + ( (int64_t)s->level1_offset * stime_ticks_per_second() ) / freq, (char*)rdata->in_buffer, rdata->in_type, rdata->in_channels, s->net );
     psynth_render_all( s->net );
     int mods_num;
-    if( rdata->out_file_encoders == nullptr )
+    if( rdata->out_file_encoders == nullptr && rdata->out_mod_buffers == nullptr )
     {
 	mods_num = 1;
     }
     else
     {
 	mods_num = s->net->mods_num;
+	if( rdata->out_mods_num > 0 && rdata->out_mods_num < mods_num ) mods_num = rdata->out_mods_num;
     }
-    if( !rdata->buffer ) mods_num = 0;
+    if( !rdata->buffer && !rdata->planar_buffer ) mods_num = 0;
     for( int fnum = 0; fnum < mods_num; fnum++ )
     {
 	psynth_module* mod = &s->net->mods[ fnum ];
+	void* output_buf = rdata->buffer;
+	if( fnum > 0 && !output_buf && !rdata->out_mod_buffers ) break; //planar master only
+	if( fnum > 0 && rdata->out_mod_buffers )
+	{
+	    //Module output -> separate buffer (with the same offset as rdata->buffer):
+	    output_buf = rdata->out_mod_buffers[ fnum ];
+	    if( output_buf == nullptr ) continue;
+	    size_t frame_size = g_sample_size[ rdata->buffer_type ] * channels;
+	    output_buf = (int8_t*)output_buf + s->level1_offset * frame_size;
+	    if( ( mod->flags & PSYNTH_FLAG_EXISTS ) == 0 || ( mod->flags & PSYNTH_FLAG_MUTE ) )
+	    {
+		smem_clear( output_buf, frames * frame_size );
+		continue;
+	    }
+	}
 	if( ( mod->flags & PSYNTH_FLAG_EXISTS ) == 0 ) continue;
 	if( mod->flags & PSYNTH_FLAG_MUTE ) continue;
 	sfs_sound_encoder_data* enc = nullptr;
@@ -2556,7 +2646,12 @@ static bool sunvox_render_piece_of_sound_level2(
 	{
 	    enc = rdata->out_file_encoders[ fnum ];
 	}
-	if( fnum > 0 && enc == nullptr ) continue;
+	if( fnum > 0 && enc == nullptr && rdata->out_mod_buffers == nullptr ) continue;
+	if( fnum > 0 && output_buf && ( ( mod->flags & PSYNTH_FLAG_OUTPUT ) ? mod->channels_in[ 0 ] : mod->channels_out[ 0 ] ) == NULL )
+	{
+	    //No output channels (e.g. the controller-only module): silent stem
+	    smem_clear( output_buf, frames * g_sample_size[ rdata->buffer_type ] * channels );
+	}
 	int sample_size = 1;
 	for( int ch = 0; ch < channels; ch++ )
 	{
@@ -2590,11 +2685,23 @@ static bool sunvox_render_piece_of_sound_level2(
 	    }
 	    if( chan == NULL ) continue;
 	    if( chan_empty < frames ) rv = 1;
+	    if( fnum == 0 && rdata->planar_buffer )
+	    {
+		//Planar float32 (without interleaving):
+		float* output = rdata->planar_buffer[ ch ] + s->level1_offset;
+#ifdef PS_STYPE_FLOATINGPOINT
+		smem_copy( output, chan, frames * sizeof( float ) );
+#else
+		for( int i = 0; i < frames; i++ ) PS_STYPE_TO_FLOAT( output[ i ], chan[ i ] );
+#endif
+		sample_size = 4;
+	    }
+	    else
 	    switch( rdata->buffer_type )
 	    {
 		case sound_buffer_int16:
 		    {
-			int16_t* output = (int16_t*)rdata->buffer;
+			int16_t* output = (int16_t*)output_buf;
 			output += ch;
 			for( int i = 0; i < frames; i++ )
 			{
@@ -2608,7 +2715,7 @@ static bool sunvox_render_piece_of_sound_level2(
 		    break;
 		case sound_buffer_float32:
 		    {
-			float* output = (float*)rdata->buffer;
+			float* output = (float*)output_buf;
 			output += ch;
 			for( int i = 0; i < frames; i++ )
 			{
@@ -2639,12 +2746,36 @@ static bool sunvox_render_piece_of_sound_level2(
 		}
 	    }
 	}
-	if( enc )
+	if( enc && output_buf )
 	{
-	    sfs_sound_encoder_write( enc, rdata->buffer, frames );
+	    sfs_sound_encoder_write( enc, output_buf, frames );
+	}
+    }
+    if( rdata->planar_buffer )
+    {
+	int ptr2 = 0;
+	float* output_l = rdata->planar_buffer[ 0 ] + s->level1_offset;
+	float* output_r = output_l;
+	if( channels > 1 ) output_r = rdata->planar_buffer[ 1 ] + s->level1_offset;
+	for( int fp = f_prev_size; fp < f_new_size; fp ++ )
+	{
+	    int val_l = 0;
+	    int val_r = 0;
+	    if( rv )
+	    {
+		val_l = (int)( output_l[ ptr2>>8 ] * 32767 );
+		val_r = (int)( output_r[ ptr2>>8 ] * 32767 );
+		if( val_l < 0 ) val_l = -val_l;
+		if( val_r < 0 ) val_r = -val_r;
+		if( val_l > 32767 ) val_l = 32767;
+		if( val_r > 32767 ) val_r = 32767;
+	    }
+	    s->f_volume_l[ f_off + fp ] = val_l >> 7;
+	    s->f_volume_r[ f_off + fp ] = val_r >> 7;
+	    ptr2 += ptr2_step;
 	}
     }
-    if( rdata->buffer )
+    else if( rdata->buffer )
     {
 	int ptr2 = 0;
 	switch( rdata->buffer_type )
@@ -2722,12 +2853,13 @@ bool sunvox_render_piece_of_sound( sunvox_render_data* rdata, sunvox_engine* s )
     s->clipping_counter -= frames;
     if( s->clipping_counter < 0 ) 
 	s->clipping_counter = 0;
+    uint64_t fp_state = sundog_denormal_numbers_push();
     psynth_render_begin( rdata->out_time, s->net );
     int ptr = 0;
     while( 1 )
     {
 	int size = frames - ptr;
-	if( size > s->net->max_buf_size ) size = s->net->max_buf_size;
+	if( size > s->net->quantum ) size = s->net->quantum;
 	if( size > 0 )
 	{
 	    rdata->frames = size;
@@ -2767,6 +2899,7 @@ bool sunvox_render_piece_of_sound( sunvox_render_data* rdata, sunvox_engine* s )
 	if( ptr >= frames ) break;
     }
     psynth_render_end( frames, s->net );
+    sundog_denormal_numbers_pop( fp_state );
     return 1;
 }
 int sunvox_frames_get_value( int channel, stime_ticks_t t, sunvox_engine* s )
@@ -28,12 +28,11 @@ IN THE SOFTWARE.
 
 #include "sundog.h"
 #include "sunvox_engine.h"
-uint sunvox_get_time_map( sunvox_time_map_item* map, uint32_t* frame_map, int start_line, int len, sunvox_engine* s )
+#define SVH_INLINES //svh_ctl_value_to_xxyy()
+#include "sunvox_engine_helper.h"
+//Fill the bpm/tpl changes (zero = no change) of the lines [ start_line, start_line + len ):
+static void sunvox_get_tempo_changes( sunvox_time_map_item* map, int start_line, int len, sunvox_engine* s )
 {
-    if( len <= 0 ) return 0;
-    smem_clear( map, sizeof( sunvox_time_map_item ) * len );
-    map[ 0 ].bpm = s->bpm;
-    map[ 0 ].tpl = s->speed;
     for( int p = 0; p < s->pats_num; p++ )
     {
 	sunvox_pattern* pat = s->pats[ p ];
@@ -51,10 +50,18 @@ uint sunvox_get_time_map( sunvox_time_map_item* map, uint32_t* frame_map, int st
 	if( pat_lines <= 0 ) continue;
 	int pat_xoffset = pat_x - pat_info->x;
 	int pat_xx = pat_x - start_line;
+	uint32_t* evt_index = sunvox_pattern_get_evt_index( pat );
 	for( int ln = pat_xx, lp = pat_xoffset * pat->data_xsize; ln < pat_xx + pat_lines; ln++, lp += pat->data_xsize )
 	{
+	    uint32_t tracks = 0;
+	    if( evt_index )
+	    {
+		tracks = evt_index[ pat_xoffset + ln - pat_xx ];
+		if( !tracks ) continue; //empty line
+	    }
 	    for( int cn = 0, ptr = lp; cn < pat->channels; cn++, ptr++ )
 	    {
+		if( evt_index && !( ( tracks >> cn ) & 1 ) ) continue;
 	        sunvox_note* n = &pat->data[ ptr ];
 	        if( ( n->ctl & 0xFF ) == 0x0F || ( n->ctl & 0xFF ) == 0x1F )
 	        {
@@ -75,6 +82,138 @@ uint sunvox_get_time_map( sunvox_time_map_item* map, uint32_t* frame_map, int st
 	    }
 	}
     } 
+}
+void sunvox_time_map_reset( sunvox_engine* s )
+{
+    smem_free( s->tmap_segs ); s->tmap_segs = NULL;
+    smem_free( s->tmap_pats ); s->tmap_pats = NULL;
+    s->tmap_segs_num = 0;
+    s->tmap_pats_num = 0;
+    s->tmap_valid = false;
+}
+//Find the segment of the line (line >= 0):
+static sunvox_time_map_seg* sunvox_time_map_find_line( int line, sunvox_engine* s )
+{
+    int i1 = 0;
+    int i2 = s->tmap_segs_num - 1;
+    while( i1 < i2 )
+    {
+	int i = ( i1 + i2 + 1 ) / 2;
+	if( s->tmap_segs[ i ].line <= line ) i1 = i; else i2 = i - 1;
+    }
+    return &s->tmap_segs[ i1 ];
+}
+static uint64_t sunvox_time_map_frame( int line, sunvox_engine* s ) //in 1/256 frames
+{
+    sunvox_time_map_seg* seg = sunvox_time_map_find_line( line, s );
+    return seg->frame + (uint64_t)( line - seg->line ) * seg->frame_add;
+}
+//Bring the cached time map up to date; only the lines after the first changed pattern are rescanned.
+//Call it with tmap_mutex locked. Retval: false - not enough memory.
+static bool sunvox_time_map_update( sunvox_engine* s )
+{
+    uint64_t base = s->bpm | ( (uint64_t)s->speed << 16 ) | ( (uint64_t)s->pats_solo_mode << 24 ) | ( (uint64_t)s->net->sampling_freq << 32 );
+    uint32_t changes = s->pats_changes;
+    if( s->tmap_valid && base == s->tmap_base && changes == s->tmap_pats_changes ) return true; //no changes
+    int lines = sunvox_get_proj_lines( s );
+    int dirty = 0x7FFFFFFF; //first changed line
+    if( !s->tmap_valid || base != s->tmap_base || s->pats_num != s->tmap_pats_num )
+    {
+	dirty = 0;
+	sunvox_time_map_pat* pats = SMEM_ZRESIZE2( s->tmap_pats, sunvox_time_map_pat, s->pats_num + 1 );
+	if( !pats ) { sunvox_time_map_reset( s ); return false; }
+	s->tmap_pats = pats;
+	s->tmap_pats_num = s->pats_num;
+	s->tmap_base = base;
+    }
+    for( int p = 0; p < s->pats_num; p++ )
+    {
+	sunvox_pattern* pat = s->pats[ p ];
+	sunvox_time_map_pat* prev = &s->tmap_pats[ p ];
+	sunvox_time_map_pat cur;
+	SMEM_CLEAR_STRUCT( cur );
+	cur.id = -1;
+	if( pat )
+	{
+	    sunvox_pattern_info* pat_info = &s->pats_info[ p ];
+	    cur.id = pat->id;
+	    cur.evt_changes = pat->evt_changes;
+	    cur.x = pat_info->x;
+	    cur.lines = pat->lines;
+	    cur.channels = pat->channels;
+	    cur.flags = pat_info->flags & ( SUNVOX_PATTERN_INFO_FLAG_MUTE | SUNVOX_PATTERN_INFO_FLAG_SOLO );
+	}
+	if( smem_cmp( &cur, prev, sizeof( cur ) ) )
+	{
+	    if( prev->id >= 0 && prev->x < dirty ) dirty = prev->x;
+	    if( cur.id >= 0 && cur.x < dirty ) dirty = cur.x;
+	    *prev = cur;
+	}
+    }
+    if( dirty < 0 ) dirty = 0;
+    if( dirty != 0x7FFFFFFF )
+    {
+	//Remove the segments >= dirty:
+	if( dirty == 0 )
+	    s->tmap_segs_num = 0;
+	else
+	    s->tmap_segs_num = sunvox_time_map_find_line( dirty - 1, s ) - s->tmap_segs + 1;
+	if( s->tmap_segs_num == 0 )
+	{
+	    if( !s->tmap_segs ) s->tmap_segs = SMEM_ALLOC2( sunvox_time_map_seg, 32 );
+	    if( !s->tmap_segs ) { sunvox_time_map_reset( s ); return false; }
+	    sunvox_time_map_seg* seg = &s->tmap_segs[ 0 ];
+	    SMEM_CLEAR_STRUCT( *seg );
+	    seg->bpm = s->bpm;
+	    seg->tpl = s->speed;
+	    seg->frame_add = PSYNTH_TICK_SIZE( s->net->sampling_freq, seg->bpm ) * seg->tpl;
+	    s->tmap_segs_num = 1;
+	}
+	//Rescan:
+	int len = lines - dirty;
+	if( len > 0 )
+	{
+	    sunvox_time_map_item* map = SMEM_ZALLOC2( sunvox_time_map_item, len );
+	    if( !map ) { sunvox_time_map_reset( s ); return false; }
+	    sunvox_get_tempo_changes( map, dirty, len, s );
+	    for( int i = 0; i < len; i++ )
+	    {
+		sunvox_time_map_item v2 = map[ i ];
+		if( !v2.bpm && !v2.tpl ) continue;
+		sunvox_time_map_seg* seg = &s->tmap_segs[ s->tmap_segs_num - 1 ];
+		sunvox_time_map_seg seg2 = *seg;
+		if( v2.bpm ) seg2.bpm = v2.bpm;
+		if( v2.tpl ) seg2.tpl = v2.tpl;
+		if( seg2.bpm == seg->bpm && seg2.tpl == seg->tpl ) continue;
+		seg2.line = dirty + i;
+		seg2.frame = seg->frame + (uint64_t)( seg2.line - seg->line ) * seg->frame_add;
+		seg2.frame_add = PSYNTH_TICK_SIZE( s->net->sampling_freq, seg2.bpm ) * seg2.tpl;
+		if( seg2.line == seg->line )
+		{
+		    *seg = seg2; //tempo change on the first line of the segment
+		    continue;
+		}
+		if( (size_t)s->tmap_segs_num >= smem_get_size( s->tmap_segs ) / sizeof( sunvox_time_map_seg ) )
+		{
+		    sunvox_time_map_seg* segs = SMEM_RESIZE2( s->tmap_segs, sunvox_time_map_seg, s->tmap_segs_num * 2 );
+		    if( !segs ) { smem_free( map ); sunvox_time_map_reset( s ); return false; }
+		    s->tmap_segs = segs;
+		}
+		s->tmap_segs[ s->tmap_segs_num++ ] = seg2;
+	    }
+	    smem_free( map );
+	}
+    }
+    s->tmap_pats_changes = changes;
+    s->tmap_valid = true;
+    return true;
+}
+static uint64_t sunvox_get_time_map_nocache( sunvox_time_map_item* map, uint32_t* frame_map, int start_line, int len, sunvox_engine* s )
+{
+    smem_clear( map, sizeof( sunvox_time_map_item ) * len );
+    map[ 0 ].bpm = s->bpm;
+    map[ 0 ].tpl = s->speed;
+    sunvox_get_tempo_changes( map, start_line, len, s );
     uint64_t frame_cnt = 0;
     uint frame_add = 0;
     sunvox_time_map_item v = map[ 0 ];
@@ -94,6 +233,33 @@ uint sunvox_get_time_map( sunvox_time_map_item* map, uint32_t* frame_map, int st
     }
     return frame_cnt >> 8;
 }
+uint64_t sunvox_get_time_map( sunvox_time_map_item* map, uint32_t* frame_map, int start_line, int len, sunvox_engine* s )
+{
+    if( len <= 0 ) return 0;
+    uint64_t rv = 0;
+    smutex_lock( &s->tmap_mutex );
+    if( start_line == 0 && sunvox_time_map_update( s ) )
+    {
+	sunvox_time_map_seg* seg = s->tmap_segs;
+	sunvox_time_map_seg* seg_end = s->tmap_segs + s->tmap_segs_num;
+	sunvox_time_map_item v;
+	for( int i = 0; i < len; i++ )
+	{
+	    if( seg + 1 < seg_end && seg[ 1 ].line == i ) seg++;
+	    v.bpm = seg->bpm;
+	    v.tpl = seg->tpl;
+	    map[ i ] = v;
+	    if( frame_map ) frame_map[ i ] = ( seg->frame + (uint64_t)( i - seg->line ) * seg->frame_add ) >> 8;
+	}
+	rv = sunvox_time_map_frame( len, s ) >> 8;
+    }
+    else
+    {
+	rv = sunvox_get_time_map_nocache( map, frame_map, start_line, len, s );
+    }
+    smutex_unlock( &s->tmap_mutex );
+    return rv;
+}
 int sunvox_get_proj_lines( sunvox_engine* s )
 {
     int number_of_lines = 0;
@@ -109,19 +275,321 @@ int sunvox_get_proj_lines( sunvox_engine* s )
     }
     return number_of_lines;
 }
-uint32_t sunvox_get_proj_frames( int start_line, int line_cnt, sunvox_engine* s ) 
+uint64_t sunvox_get_proj_frames( int start_line, int line_cnt, sunvox_engine* s ) 
 {
     if( line_cnt == 0 )
     {
 	line_cnt = sunvox_get_proj_lines( s ) - start_line;
     }
     if( line_cnt <= 0 ) return 0;
-    uint32_t frame_cnt = 0;
+    if( start_line == 0 )
+    {
+	int64_t frame_cnt = sunvox_line_to_frame( line_cnt, s );
+	if( frame_cnt >= 0 ) return frame_cnt;
+    }
+    uint64_t frame_cnt = 0;
     sunvox_time_map_item* map = SMEM_ALLOC2( sunvox_time_map_item, line_cnt );
     if( map )
     {
-	frame_cnt = sunvox_get_time_map( map, NULL, start_line, line_cnt, s );
+	frame_cnt = sunvox_get_time_map_nocache( map, NULL, start_line, line_cnt, s );
 	smem_free( map );
     }
     return frame_cnt;
 }
+int64_t sunvox_line_to_frame( int line, sunvox_engine* s )
+{
+    if( line <= 0 ) return 0;
+    int64_t rv = -1;
+    smutex_lock( &s->tmap_mutex );
+    if( sunvox_time_map_update( s ) )
+	rv = sunvox_time_map_frame( line, s ) >> 8;
+    smutex_unlock( &s->tmap_mutex );
+    return rv;
+}
+int sunvox_frame_to_line( int64_t frame, sunvox_engine* s )
+{
+    if( frame < 0 ) return -1;
+    int rv = -1;
+    smutex_lock( &s->tmap_mutex );
+    if( sunvox_time_map_update( s ) )
+    {
+	//Last line with line_frame <= frame:
+	uint64_t f = ( (uint64_t)frame + 1 ) << 8;
+	int i1 = 0;
+	int i2 = s->tmap_segs_num - 1;
+	while( i1 < i2 )
+	{
+	    int i = ( i1 + i2 + 1 ) / 2;
+	    if( s->tmap_segs[ i ].frame < f ) i1 = i; else i2 = i - 1;
+	}
+	sunvox_time_map_seg* seg = &s->tmap_segs[ i1 ];
+	uint64_t l = 0;
+	if( seg->frame_add ) l = ( f - 1 - seg->frame ) / seg->frame_add;
+	if( l > 0x7FFFFFFF - (uint64_t)seg->line ) l = 0x7FFFFFFF - seg->line;
+	rv = seg->line + (int)l;
+    }
+    smutex_unlock( &s->tmap_mutex );
+    return rv;
+}
+static uint32_t sunvox_chase_signature( sunvox_engine* s )
+{
+    uint32_t sig = 2166136261;
+#define SIG_ADD( v ) { sig ^= (uint32_t)( v ); sig *= 16777619; }
+    SIG_ADD( s->pats_num );
+    SIG_ADD( s->pats_solo_mode );
+    SIG_ADD( s->proj_bpm );
+    SIG_ADD( s->proj_speed );
+    for( int p = 0; p < s->pats_num; p++ )
+    {
+	sunvox_pattern* pat = s->pats[ p ];
+	if( !pat ) continue;
+	sunvox_pattern_info* pat_info = &s->pats_info[ p ];
+	SIG_ADD( p );
+	SIG_ADD( pat->id );
+	SIG_ADD( pat->evt_changes );
+	SIG_ADD( pat_info->x );
+	SIG_ADD( pat->lines );
+	SIG_ADD( pat->channels );
+	SIG_ADD( pat_info->flags & ( SUNVOX_PATTERN_INFO_FLAG_MUTE | SUNVOX_PATTERN_INFO_FLAG_SOLO ) );
+    }
+#undef SIG_ADD
+    if( sig == 0 ) sig = 1;
+    return sig;
+}
+static void sunvox_chase_state_copy( sunvox_chase_state* dest, sunvox_chase_state* src )
+{
+    sunvox_chase_item* items = dest->items;
+    if( src->items_num )
+    {
+	if( !items || (size_t)src->items_num > smem_get_size( items ) / sizeof( sunvox_chase_item ) )
+	    items = SMEM_RESIZE2( items, sunvox_chase_item, src->items_num + 32 );
+	if( items ) smem_copy( items, src->items, src->items_num * sizeof( sunvox_chase_item ) );
+    }
+    *dest = *src;
+    dest->items = items;
+    if( !items ) dest->items_num = 0;
+}
+static void sunvox_chase_set_ctl( sunvox_chase_state* st, uint32_t key, uint16_t val, uint64_t t )
+{
+    int i1 = 0;
+    int i2 = st->items_num;
+    while( i1 < i2 )
+    {
+	int i = ( i1 + i2 ) / 2;
+	if( st->items[ i ].key < key ) i1 = i + 1; else i2 = i;
+    }
+    sunvox_chase_item* item = &st->items[ i1 ];
+    if( i1 < st->items_num && item->key == key )
+    {
+	if( t >= item->t ) { item->val = val; item->t = t; }
+	return;
+    }
+    if( !st->items || (size_t)st->items_num >= smem_get_size( st->items ) / sizeof( sunvox_chase_item ) )
+    {
+	sunvox_chase_item* items = SMEM_RESIZE2( st->items, sunvox_chase_item, st->items_num * 2 + 32 );
+	if( !items ) return;
+	st->items = items;
+    }
+    item = &st->items[ i1 ];
+    memmove( item + 1, item, ( st->items_num - i1 ) * sizeof( sunvox_chase_item ) );
+    item->key = key;
+    item->val = val;
+    item->t = t;
+    st->items_num++;
+}
+//Replay the state-changing events of the lines [ line1, line2 ) on top of st:
+static void sunvox_chase_scan( int line1, int line2, sunvox_chase_state* st, sunvox_engine* s )
+{
+    for( int sp = 0; sp < s->sorted_pats_num; sp++ )
+    {
+	int p = s->sorted_pats[ sp ];
+	sunvox_pattern* pat = s->pats[ p ];
+	if( !pat || !pat->data ) continue;
+	sunvox_pattern_info* pat_info = &s->pats_info[ p ];
+	if( pat_info->x >= line2 ) break;
+	if( pat_info->flags & SUNVOX_PATTERN_INFO_FLAG_MUTE ) continue;
+        if( s->pats_solo_mode && !( pat_info->flags & SUNVOX_PATTERN_INFO_FLAG_SOLO ) ) continue;
+	int pat_x = pat_info->x;
+	int pat_lines = pat->lines;
+	CROP_REGION( pat_x, pat_lines, line1, line2 - line1 );
+	if( pat_lines <= 0 ) continue;
+	uint32_t* evt_index = sunvox_pattern_get_evt_index( pat );
+	for( int ln = pat_x - pat_info->x; ln < pat_x - pat_info->x + pat_lines; ln++ )
+	{
+	    uint32_t tracks = 0xFFFFFFFF;
+	    if( evt_index )
+	    {
+		tracks = evt_index[ ln ];
+		if( !tracks ) continue;
+	    }
+	    sunvox_note* n = &pat->data[ ln * pat->data_xsize ];
+	    uint64_t t = (uint64_t)( (int64_t)( pat_info->x + ln ) + 0x80000000 ) << 32;
+	    for( int cn = 0; cn < pat->channels; cn++, n++ )
+	    {
+		if( evt_index && !( ( tracks >> cn ) & 1 ) ) continue;
+		int eff = n->ctl & 0xFF;
+		uint64_t t2 = t | ( (uint64_t)sp << 5 ) | cn;
+		if( eff == 0x0F || eff == 0x1F )
+		{
+		    if( eff == 0x0F && n->ctl_val < 32 )
+		    {
+			if( t2 >= st->tpl_t ) { st->tpl = n->ctl_val <= 1 ? 1 : n->ctl_val; st->tpl_t = t2; }
+		    }
+		    else if( !( eff == 0x0F && n->ctl_val >= 0xF000 && n->ctl_val <= 0xF1FF ) )
+		    {
+			int bpm = n->ctl_val;
+			if( bpm < 1 ) bpm = 1;
+			if( bpm > 16000 ) bpm = 16000;
+			if( t2 >= st->bpm_t ) { st->bpm = bpm; st->bpm_t = t2; }
+		    }
+		}
+		if( n->note == 0 && n->mod && ( n->ctl & 0xFF00 ) && eff != 0x22 && eff != 0x23 ) //global controller (not random)
+		{
+		    sunvox_chase_set_ctl( st, ( (uint32_t)( n->mod - 1 ) << 8 ) | ( n->ctl >> 8 ), n->ctl_val, t2 );
+		}
+	    }
+	}
+    }
+}
+//Initial state (before line 0): project tempo + initial values of the controllers changed by the timeline:
+static void sunvox_chase_init( sunvox_chase_state* st, sunvox_engine* s )
+{
+    sunvox_chase_item* items = st->items;
+    SMEM_CLEAR_STRUCT( *st );
+    st->items = items;
+    sunvox_chase_scan( 0, sunvox_get_proj_lines( s ), st, s ); //all controllers of the timeline
+    sunvox_chase_state* base = &s->chase_base;
+    int n = 0;
+    int b = 0;
+    for( int i = 0; i < st->items_num; i++ )
+    {
+	uint32_t key = st->items[ i ].key;
+	while( b < base->items_num && base->items[ b ].key < key ) b++;
+	if( b >= base->items_num ) break;
+	if( base->items[ b ].key != key ) continue; //no initial value (new module)
+	st->items[ n++ ] = base->items[ b ];
+    }
+    st->items_num = n;
+    st->bpm = s->proj_bpm;
+    st->tpl = s->proj_speed;
+    st->bpm_t = 0;
+    st->tpl_t = 0;
+}
+void sunvox_chase_save_base( sunvox_engine* s )
+{
+    psynth_net* net = s->net;
+    sunvox_chase_state* st = &s->chase_base;
+    int num = 0;
+    for( uint i = 0; i < net->mods_num; i++ )
+    {
+	psynth_module* m = &net->mods[ i ];
+	if( m->flags & PSYNTH_FLAG_EXISTS ) num += m->ctls_num;
+    }
+    st->items_num = 0;
+    if( num && ( !st->items || (size_t)num > smem_get_size( st->items ) / sizeof( sunvox_chase_item ) ) )
+    {
+	sunvox_chase_item* items = SMEM_RESIZE2( st->items, sunvox_chase_item, num );
+	if( !items ) return;
+	st->items = items;
+    }
+    for( uint i = 0; i < net->mods_num; i++ )
+    {
+	psynth_module* m = &net->mods[ i ];
+	if( !( m->flags & PSYNTH_FLAG_EXISTS ) ) continue;
+	for( uint c = 0; c < m->ctls_num && c < 255; c++ )
+	{
+	    sunvox_chase_item* item = &st->items[ st->items_num++ ];
+	    item->key = ( i << 8 ) | ( c + 1 ); //sorted by key
+	    item->val = svh_ctl_value_to_xxyy( &m->ctls[ c ], m->ctls[ c ].val[ 0 ], 0, true );
+	    item->t = 0;
+	}
+    }
+    sunvox_chase_reset( s ); //the checkpoints are based on the old initial state
+}
+void sunvox_chase_reset( sunvox_engine* s )
+{
+    for( int i = 0; i < s->chase_points_num; i++ )
+	smem_free( s->chase_points[ i ].items );
+    smem_free( s->chase_points );
+    s->chase_points = NULL;
+    s->chase_points_num = 0;
+    s->chase_points_sig = 0;
+}
+//Give the back buffer to the audio thread; the previous middle buffer becomes the back one
+//(the audio thread never sees the back buffer, so it can be resized here):
+static void sunvox_chase_publish( sunvox_engine* s )
+{
+    s->chase_back = atomic_exchange( &s->chase_middle, s->chase_back | SUNVOX_CHASE_NEW ) & 3;
+}
+void sunvox_chase_cancel( sunvox_engine* s )
+{
+    s->chase_result[ s->chase_back ].line = 0;
+    sunvox_chase_publish( s );
+}
+int sunvox_chase_prepare( int line, sunvox_engine* s )
+{
+    if( line < 0 ) line = 0;
+    uint32_t sig = sunvox_chase_signature( s );
+    if( sig != s->chase_points_sig ) sunvox_chase_reset( s );
+    s->chase_points_sig = sig;
+    int point = line / SUNVOX_CHASE_STEP;
+    if( point >= s->chase_points_num )
+    {
+	sunvox_chase_state* points = SMEM_ZRESIZE2( s->chase_points, sunvox_chase_state, point + 1 );
+	if( points )
+	{
+	    s->chase_points = points;
+	    if( s->chase_points_num == 0 )
+	    {
+		sunvox_chase_init( &points[ 0 ], s ); //point 0: initial state
+		s->chase_points_num = 1;
+	    }
+	    for( int i = s->chase_points_num; i <= point; i++ )
+	    {
+		sunvox_chase_state_copy( &points[ i ], &points[ i - 1 ] );
+		sunvox_chase_scan( ( i - 1 ) * SUNVOX_CHASE_STEP, i * SUNVOX_CHASE_STEP, &points[ i ], s );
+	    }
+	    s->chase_points_num = point + 1;
+	}
+    }
+    sunvox_chase_state* st = &s->chase_result[ s->chase_back ];
+    if( point < s->chase_points_num )
+    {
+	sunvox_chase_state_copy( st, &s->chase_points[ point ] );
+	sunvox_chase_scan( point * SUNVOX_CHASE_STEP, line, st, s );
+    }
+    else
+    {
+	//No checkpoints (not enough memory):
+	sunvox_chase_init( st, s );
+	sunvox_chase_scan( 0, line, st, s );
+    }
+    st->line = line + 1;
+    sunvox_chase_publish( s );
+    return 0;
+}
+void sunvox_chase_apply( int offset, sunvox_engine* s )
+{
+    if( !( atomic_load_explicit( &s->chase_middle, std::memory_order_acquire ) & SUNVOX_CHASE_NEW ) ) return;
+    s->chase_front = atomic_exchange( &s->chase_middle, s->chase_front ) & 3;
+    sunvox_chase_state* st = &s->chase_result[ s->chase_front ];
+    if( st->line == 0 ) return; //cancelled
+    if( st->line - 1 != s->line_counter + 1 ) return; //position has been changed after sunvox_chase_prepare()
+    if( st->bpm ) s->bpm = st->bpm;
+    if( st->tpl ) s->speed = st->tpl;
+    psynth_net* net = s->net;
+    for( int i = 0; i < st->items_num; i++ )
+    {
+	sunvox_chase_item* item = &st->items[ i ];
+	uint mod_num = item->key >> 8;
+	if( mod_num >= net->mods_num ) continue;
+	if( !( net->mods[ mod_num ].flags & PSYNTH_FLAG_EXISTS ) ) continue;
+	psynth_event evt;
+	SMEM_CLEAR_STRUCT( evt );
+	evt.command = PS_CMD_SET_GLOBAL_CONTROLLER;
+	evt.offset = offset;
+	evt.controller.ctl_num = ( item->key & 255 ) - 1;
+	evt.controller.ctl_val = item->val;
+	psynth_add_event( mod_num, &evt, net );
+    }
+}
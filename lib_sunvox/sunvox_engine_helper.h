@@ -71,13 +71,12 @@ inline int svh_get_module_ctl_value( sunvox_engine* s, int mod_num, int ctl_num,
     return 0;
 }
 
+//Controller value -> XXYY (0...0x8000) for the controller event;
 //scaled: 0 - real ctl value; 1 - scaled for XXYY; 2 - displayed;
-inline int svh_set_module_ctl_value( sunvox_engine* s, stime_ticks_t t, int mod_num, int ctl_num, int val, int scaled )
+//exact: XXYY is rounded up, so the module will get exactly the same value (psynth_set_ctl() truncates);
+//       otherwise it is truncated (as in sv_set_module_ctl_value());
+inline int svh_ctl_value_to_xxyy( psynth_ctl* c, int val, int scaled, bool exact )
 {
-    psynth_module* m = psynth_get_module( mod_num, s->net );
-    if( !m ) return -1;
-    psynth_ctl* c = psynth_get_ctl( m, ctl_num, s->net );
-    if( !c ) return -1;
     switch( scaled )
     {
         case 1:
@@ -91,7 +90,25 @@ inline int svh_set_module_ctl_value( sunvox_engine* s, stime_ticks_t t, int mod_
     if( val < c->min ) val = c->min;
     if( val > c->max ) val = c->max;
     if( c->type == 0 )
-        val = ( val - c->min ) * 0x8000 / ( c->max - c->min );
+    {
+        int range = c->max - c->min;
+        if( range <= 0 ) return 0;
+        if( exact )
+            val = ( ( val - c->min ) * 0x8000 + range - 1 ) / range;
+        else
+            val = ( val - c->min ) * 0x8000 / range;
+    }
+    return val;
+}
+
+//scaled: 0 - real ctl value; 1 - scaled for XXYY; 2 - displayed;
+inline int svh_set_module_ctl_value( sunvox_engine* s, stime_ticks_t t, int mod_num, int ctl_num, int val, int scaled )
+{
+    psynth_module* m = psynth_get_module( mod_num, s->net );
+    if( !m ) return -1;
+    psynth_ctl* c = psynth_get_ctl( m, ctl_num, s->net );
+    if( !c ) return -1;
+    val = svh_ctl_value_to_xxyy( c, val, scaled, false );
     svh_send_event( s, t, 0, 0, 0, mod_num + 1, ( ctl_num + 1 ) << 8, val );
     return 0;
 }
@@ -110,6 +110,7 @@ static void set_pattern_note( int pat_num, int line, int track, sunvox_note* n,
 	if( track >= pat->channels )
 	    sunvox_pattern_set_number_of_channels( pat_num, track + 1, s );
 	pat->data[ line * pat->data_xsize + track ] = *n;
+	SUNVOX_PATTERN_CHANGED( pat, s );
     }
 }
 static sunvox_note* get_pattern_note( int pat_num, int line, int track, sunvox_engine* s )
@@ -120,6 +121,7 @@ static sunvox_note* get_pattern_note( int pat_num, int line, int track, sunvox_e
     if( pat == 0 ) return 0;
     if( line >= pat->lines ) return 0;
     if( track >= pat->channels ) return 0;
+    SUNVOX_PATTERN_CHANGED( pat, s );
     return &pat->data[ line * pat->data_xsize + track ];
 }
 #define APPLY_MIDI_EVENT_OFFSET() \
@@ -267,6 +269,8 @@ int sunvox_load_proj_from_fd( sfs_file f, uint load_flags, sunvox_engine* s )
 	    if( xm->tempo == 0 ) xm->tempo = 6;
 	    s->bpm = xm->bpm;
 	    s->speed = xm->tempo;
+	    s->proj_bpm = s->bpm;
+	    s->proj_speed = s->speed;
 	    s->flags |= SUNVOX_FLAG_SUPERTRACKS;
 	}
 	int sunvox_instr[ 128 ]; 
@@ -628,6 +632,8 @@ int sunvox_load_proj_from_fd( sfs_file f, uint load_flags, sunvox_engine* s )
 	{
     	    s->bpm = 120;
     	    s->speed = s->midi_import_tpl;
+    	    s->proj_bpm = s->bpm;
+    	    s->proj_speed = s->speed;
     	}
         uint lines_per_beat = 4 * ( 6 / s->speed );
         uint bpm_map_size = 0;
@@ -1162,8 +1168,8 @@ int sunvox_load_proj_from_fd( sfs_file f, uint load_flags, sunvox_engine* s )
     		    continue;
     		    break;
     		case BID_SFGS: s->sync_flags = st->block_data_int; continue; break;
-    		case BID_BPM: s->bpm = st->block_data_int; if( s->bpm == 0 ) s->bpm = 125; continue; break;
-    		case BID_SPED: s->speed = st->block_data_int; if( s->speed == 0 ) s->speed = 6; continue; break;
+    		case BID_BPM: s->bpm = st->block_data_int; if( s->bpm == 0 ) s->bpm = 125; s->proj_bpm = s->bpm; continue; break;
+    		case BID_SPED: s->speed = st->block_data_int; if( s->speed == 0 ) s->speed = 6; s->proj_speed = s->speed; continue; break;
     		case BID_TGRD: s->tgrid = st->block_data_int; continue; break;
     		case BID_TGD2: s->tgrid2 = st->block_data_int; continue; break;
     		case BID_NAME:
@@ -1306,11 +1312,13 @@ int sunvox_load_proj_from_fd( sfs_file f, uint load_flags, sunvox_engine* s )
 			    pat->data = (sunvox_note*)pat_data;
 			    pat->name = pat_name;
 			    pat->flags = pat_parent_flags;
+			    s->pats_names_changes++;
 			    pat_data = NULL;
 			    pat_name = NULL;
 			    pat_parent_flags = 0;
 			    pat->data_xsize = pat_channels;
 			    pat->data_ysize = pat_lines;
+			    sunvox_pattern_evt_index_resize( pat, s );
 		    	    smem_copy( pat->icon, pat_icon, 32 );
 			    smem_copy( pat->fg, pat_fg, 3 );
 			    smem_copy( pat->bg, pat_bg, 3 );
@@ -1637,6 +1645,7 @@ int sunvox_load_proj_from_fd( sfs_file f, uint load_flags, sunvox_engine* s )
 		}
 	    }
 	}
+	s->pats_names_changes++;
 	sunvox_check_solo_mode( s );
     }
     if( load_modules )
@@ -1730,6 +1739,9 @@ sunvox_proj_load_end:
     }
     smem_free( s_links0 );
     smem_free( s_ctls );
+    sunvox_reserve_pattern_state( -1, s );
+    sunvox_update_pattern_names_index( s );
+    sunvox_chase_save_base( s );
     if( load_flags & SUNVOX_PROJ_LOAD_MAKE_TIMELINE_STATIC )
     {
         s->flags &= ~SUNVOX_FLAG_STATIC_TIMELINE;
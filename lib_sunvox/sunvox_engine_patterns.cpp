@@ -28,30 +28,217 @@ IN THE SOFTWARE.
 
 #include "sundog.h"
 #include "sunvox_engine.h"
-void sunvox_sort_patterns( sunvox_engine* s )
+void sunvox_set_pattern_state_size( int size, sunvox_engine* s )
 {
-    if( s->flags & SUNVOX_FLAG_STATIC_TIMELINE )
+    if( size > MAX_PLAYING_PATS_LIMIT ) size = MAX_PLAYING_PATS_LIMIT;
+    if( s->cur_playing_pats && size <= s->pat_state_size ) return;
+    int* cur_pats = SMEM_RESIZE2( s->cur_playing_pats, int, size + 1 );
+    if( !cur_pats ) return;
+    s->cur_playing_pats = cur_pats;
+    int* temp_pats = SMEM_RESIZE2( s->temp_pats, int, size + 1 );
+    if( !temp_pats ) return;
+    s->temp_pats = temp_pats;
+    uint32_t* handled = SMEM_RESIZE2( s->pat_state_handled, uint32_t, ( size + 31 ) / 32 + 1 );
+    if( !handled ) return;
+    s->pat_state_handled = handled;
+    if( size > s->pat_state_size )
     {
-	return;
+	sunvox_pattern_state* state = SMEM_ZRESIZE2( s->pat_state, sunvox_pattern_state, size );
+	if( !state ) return;
+	s->pat_state = state;
+	for( int i = s->pat_state_size; i < size; i++ )
+	    clean_pattern_state( &s->pat_state[ i ], s );
+	s->pat_state_size = size;
     }
-    s->proj_lines = 0;
-    if( s->pats && s->pats_num )
+}
+static void sunvox_sort_ints( int* a, int n )
+{
+    for( int gap = n / 2; gap > 0; gap /= 2 )
+    {
+	for( int i = gap; i < n; i++ )
+	{
+	    int v = a[ i ];
+	    int j = i;
+	    for( ; j >= gap && a[ j - gap ] > v; j -= gap ) a[ j ] = a[ j - gap ];
+	    a[ j ] = v;
+	}
+    }
+}
+//Max number of the patterns overlapping at some line within [ x0, x1 ):
+static int sunvox_get_max_overlap( int x0, int x1, sunvox_engine* s )
+{
+    int n = 0;
+    for( int i = 0; i < s->pats_num; i++ )
+    {
+	sunvox_pattern* pat = s->pats[ i ];
+	if( !pat || pat == (sunvox_pattern*)1 ) continue; //(sunvox_pattern*)1 - empty clone (not loaded yet)
+	int x = s->pats_info[ i ].x;
+	if( x < x1 && x + pat->lines > x0 ) n++;
+    }
+    if( n <= 1 ) return n;
+    int* starts = SMEM_ALLOC2( int, n * 2 );
+    if( !starts ) return n;
+    int* ends = starts + n;
+    n = 0;
+    for( int i = 0; i < s->pats_num; i++ )
+    {
+	sunvox_pattern* pat = s->pats[ i ];
+	if( !pat || pat == (sunvox_pattern*)1 ) continue;
+	int x = s->pats_info[ i ].x;
+	int x2 = x + pat->lines;
+	if( x < x1 && x2 > x0 )
+	{
+	    starts[ n ] = x < x0 ? x0 : x;
+	    ends[ n ] = x2 > x1 ? x1 : x2;
+	    n++;
+	}
+    }
+    sunvox_sort_ints( starts, n );
+    sunvox_sort_ints( ends, n );
+    int max = 0;
+    int cnt = 0;
+    for( int i = 0, j = 0; i < n; )
     {
-	if( !s->sorted_pats )
+	if( starts[ i ] < ends[ j ] )
 	{
-	    s->sorted_pats = SMEM_ALLOC2( int, s->pats_num );
+	    cnt++; i++;
+	    if( cnt > max ) max = cnt;
 	}
 	else
 	{
-	    if( s->pats_num > (int)( smem_get_size( s->sorted_pats ) / sizeof( int ) ) )
+	    cnt--; j++;
+	}
+    }
+    smem_free( starts );
+    return max;
+}
+static void sunvox_update_patterns_tree( sunvox_engine* s );
+void sunvox_reserve_pattern_state( int pat_num, sunvox_engine* s )
+{
+    //User thread only (the sound stream must be locked):
+    //sunvox_sort_patterns() and sunvox_select_current_playing_patterns() (also called by the audio thread) never reallocate these buffers
+    int cap = s->sorted_pats ? (int)( smem_get_size( s->sorted_pats ) / sizeof( int ) ) : 0;
+    if( s->pats_num > cap )
+    {
+	int* sorted_pats = SMEM_RESIZE2( s->sorted_pats, int, s->pats_num + 32 );
+	if( !sorted_pats ) return;
+	s->sorted_pats = sorted_pats;
+	int* slots = SMEM_RESIZE2( s->sorted_pats_slots, int, s->pats_num + 32 + 1 );
+	if( !slots ) return;
+	s->sorted_pats_slots = slots;
+	cap = s->pats_num + 32;
+    }
+    int leaves = 1;
+    while( leaves < cap ) leaves <<= 1;
+    if( !s->sorted_pats_tree || leaves * 2 > (int)( smem_get_size( s->sorted_pats_tree ) / sizeof( int ) ) )
+    {
+	int* tree = SMEM_RESIZE2( s->sorted_pats_tree, int, leaves * 2 );
+	if( !tree ) return;
+	s->sorted_pats_tree = tree;
+	s->sorted_pats_tree_leaves = 0; //full rebuild
+    }
+    s->pats_changes++; //new/moved/resized pattern
+    sunvox_update_patterns_tree( s ); //the pattern may be moved or resized before the next sorting: keep the max ends up to date
+    sunvox_pattern* pat = NULL;
+    if( pat_num >= 0 )
+    {
+	if( (unsigned)pat_num >= (unsigned)s->pats_num ) return;
+	pat = s->pats[ pat_num ];
+	if( !pat || pat == (sunvox_pattern*)1 ) return;
+    }
+    int size;
+    if( s->flags & SUNVOX_FLAG_SUPERTRACKS )
+    {
+	//Fixed number of supertracks; pat_state[] grows with the used supertracks only in the dynamic mode:
+	if( !( s->flags & SUNVOX_FLAG_DYNAMIC_PATTERN_STATE ) ) return;
+	size = 0;
+	for( int i = 0; i < s->pats_num; i++ )
+	{
+	    if( pat_num >= 0 ) i = pat_num;
+	    if( s->pats[ i ] )
 	    {
-		s->sorted_pats = SMEM_RESIZE2( s->sorted_pats, int, s->pats_num + 32 );
+		int state_ptr = ( s->pats_info[ i ].y + 16 ) / 32;
+		if( state_ptr + 1 > size ) size = state_ptr + 1;
 	    }
+	    if( pat_num >= 0 ) break;
 	}
+	if( size > MAX_PLAYING_PATS ) size = MAX_PLAYING_PATS;
+    }
+    else
+    {
+	if( pat )
+	    size = sunvox_get_max_overlap( s->pats_info[ pat_num ].x, s->pats_info[ pat_num ].x + pat->lines, s );
+	else
+	    size = sunvox_get_max_overlap( -0x7FFFFFFF, 0x7FFFFFFF, s );
+    }
+    sunvox_set_pattern_state_size( size, s );
+}
+//Update the interval tree after sorting (no memory allocation; only the changed leaves and their paths are updated):
+static void sunvox_update_patterns_tree( sunvox_engine* s )
+{
+    int leaves = 1;
+    while( leaves < s->sorted_pats_num ) leaves <<= 1;
+    int* tree = s->sorted_pats_tree;
+    if( !tree || leaves * 2 > (int)( smem_get_size( tree ) / sizeof( int ) ) )
+    {
+	s->sorted_pats_tree_leaves = 0; //linear search
+	return;
+    }
+    bool rebuild = leaves != s->sorted_pats_tree_leaves;
+    for( int i = 0; i < leaves; i++ )
+    {
+	int end = -0x7FFFFFFF; //empty leaf
+	if( i < s->sorted_pats_num )
+	{
+	    int n = s->sorted_pats[ i ];
+	    sunvox_pattern* pat = s->pats[ n ];
+	    if( pat && pat != (sunvox_pattern*)1 ) end = s->pats_info[ n ].x + pat->lines; //else: removed after the last sorting
+	}
+	int node = leaves + i;
+	if( rebuild )
+	{
+	    tree[ node ] = end;
+	    continue;
+	}
+	if( tree[ node ] == end ) continue;
+	tree[ node ] = end;
+	for( node /= 2; node > 0; node /= 2 )
+	{
+	    int end1 = tree[ node * 2 ];
+	    int end2 = tree[ node * 2 + 1 ];
+	    int max = end1 > end2 ? end1 : end2;
+	    if( tree[ node ] == max ) break;
+	    tree[ node ] = max;
+	}
+    }
+    if( rebuild )
+    {
+	for( int i = leaves - 1; i > 0; i-- )
+	{
+	    int end1 = tree[ i * 2 ];
+	    int end2 = tree[ i * 2 + 1 ];
+	    tree[ i ] = end1 > end2 ? end1 : end2;
+	}
+    }
+    s->sorted_pats_tree_leaves = leaves;
+}
+void sunvox_sort_patterns( sunvox_engine* s )
+{
+    if( s->flags & SUNVOX_FLAG_STATIC_TIMELINE )
+    {
+	return;
+    }
+    s->proj_lines = 0;
+    s->pats_changes++;
+    if( s->pats && s->pats_num )
+    {
+	//sorted_pats[] capacity is reserved by sunvox_reserve_pattern_state() (user thread):
+	int cap = s->sorted_pats ? (int)( smem_get_size( s->sorted_pats ) / sizeof( int ) ) : 0;
 	s->sorted_pats_num = 0;
 	for( int i = 0; i < s->pats_num; i++ )
 	{
 	    if( !s->pats[ i ] ) continue;
+	    if( s->sorted_pats_num >= cap ) break;
     	    s->sorted_pats[ s->sorted_pats_num ] = i;
 	    int max_x = s->pats_info[ i ].x + s->pats[ i ]->lines;
 	    if( max_x > s->proj_lines ) s->proj_lines = max_x;
@@ -79,35 +266,8 @@ void sunvox_sort_patterns( sunvox_engine* s )
     {
 	s->sorted_pats_num = 0;
     }
-    if( s->flags & SUNVOX_FLAG_DYNAMIC_PATTERN_STATE )
-    {
-	int pp = 0;
-        if( s->flags & SUNVOX_FLAG_SUPERTRACKS )
-        {
-	    for( int i = 0; i < s->pats_num; i++ )
-	    {
-		if( !s->pats[ i ] ) continue;
-		int state_ptr = ( s->pats_info[ i ].y + 16 ) / 32;
-		if( state_ptr + 1 > pp ) pp = state_ptr + 1;
-	    }
-        }
-        else
-        {
-	    pp = sunvox_get_mpp( s );
-	}
-	if( pp > MAX_PLAYING_PATS ) pp = MAX_PLAYING_PATS;
-	if( pp > s->pat_state_size )
-	{
-	    s->pat_state = SMEM_ZRESIZE2( s->pat_state, sunvox_pattern_state, pp );
-	    if( s->pat_state )
-	    {
-		for( int i = s->pat_state_size; i < pp; i++ )
-    		    clean_pattern_state( &s->pat_state[ i ], s );
-		s->pat_state_size = pp;
-	    }
-	}
-    }
-    if( s->sorted_pats_num )
+    sunvox_update_patterns_tree( s );
+    if( s->sorted_pats_num && s->pat_state_size )
     {
         if( s->flags & SUNVOX_FLAG_SUPERTRACKS )
         {
@@ -124,16 +284,19 @@ void sunvox_sort_patterns( sunvox_engine* s )
         }
         else
         {
-	    int pats[ MAX_PLAYING_PATS ]; 
+	    //Assign a state slot to each pattern; the number of slots = max number of overlapping patterns:
+	    int* pats = s->sorted_pats_slots;
+	    int slots_max = s->sorted_pats_num;
+	    if( slots_max > MAX_PLAYING_PATS_LIMIT ) slots_max = MAX_PLAYING_PATS_LIMIT;
 	    int pats_num = 0;
 	    pats[ 0 ] = -1;
     	    for( int p = 0; p < s->sorted_pats_num; p++ )
 	    {
     		int n = s->sorted_pats[ p ];
 		sunvox_pattern_info* pat_info = &s->pats_info[ n ];
-		int state_ptr = s->pat_state_size - 1;
+		int state_ptr = slots_max - 1;
 		int pats_num2 = pats_num + 1;
-	        if( pats_num2 > s->pat_state_size ) pats_num2 = s->pat_state_size;
+	        if( pats_num2 > slots_max ) pats_num2 = slots_max;
 		for( int i = 0; i < pats_num2; i++ )
     		{
     		    int n2 = pats[ i ];
@@ -156,89 +319,122 @@ void sunvox_sort_patterns( sunvox_engine* s )
     	        if( state_ptr >= pats_num )
     	        {
     	    	    pats_num = state_ptr + 1;
-    		    if( pats_num < s->pat_state_size ) pats[ pats_num ] = -1;
+    		    if( pats_num < slots_max ) pats[ pats_num ] = -1;
     		}
     	    }
+	    if( pats_num > s->pat_state_size )
+	    {
+		//pat_state[] is not reserved (or not enough memory): the last slot will be shared
+    		for( int p = 0; p < s->sorted_pats_num; p++ )
+		{
+		    sunvox_pattern_info* pat_info = &s->pats_info[ s->sorted_pats[ p ] ];
+		    if( pat_info->state_ptr >= s->pat_state_size ) pat_info->state_ptr = s->pat_state_size - 1;
+		}
+	    }
     	}
     }
 }
 int sunvox_get_mpp( sunvox_engine* s ) 
 {
-    int pats[ MAX_PLAYING_PATS ];
-    int pats_num = 0;
     int max = 0;
     int nn = 0;
-    for( int i = 0; i < MAX_PLAYING_PATS; i++ ) pats[ i ] = -1;
+    int* ends = SMEM_ALLOC2( int, s->sorted_pats_num + 1 ); //ends of the active patterns
+    if( !ends ) return 0;
     for( int p = 0; p < s->sorted_pats_num; p++ )
     {
     	int n = s->sorted_pats[ p ];
-	sunvox_pattern* pat = s->pats[ n ];
 	sunvox_pattern_info* pat_info = &s->pats_info[ n ];
-	for( int i = 0; i < MAX_PLAYING_PATS; i++ )
-        {
-            if( pats[ i ] == -1 )
-            {
-                pats[ i ] = n;
-                if( i >= pats_num ) pats_num = i + 1;
-                nn++;
-                break;
-            }
-        }
-	for( int i = 0; i < pats_num; i++ )
-        {
-    	    int n2 = pats[ i ];
-            if( n2 != -1 )
-            {
-		sunvox_pattern* pat2 = s->pats[ n2 ];
-        	sunvox_pattern_info* pat2_info = &s->pats_info[ n2 ];
-        	if( pat2_info->x + pat2->lines <= pat_info->x )
-        	{
-        	    pats[ i ] = -1;
-        	    nn--;
-        	}
-            }
-        }
+	int nn2 = 0;
+	for( int i = 0; i < nn; i++ )
+	{
+	    if( ends[ i ] > pat_info->x ) ends[ nn2++ ] = ends[ i ];
+	}
+	nn = nn2;
+	ends[ nn++ ] = pat_info->x + s->pats[ n ]->lines;
         if( nn > max ) {   max = nn; }
-        for( int i = pats_num - 1; i >= 0; i-- )
-        {
-    	    if( pats[ i ] == -1 )
-    		pats_num = i;
-    	    else
-    		break;
-        }
     }
+    smem_free( ends );
     return max;
 }
+//Find the patterns under the cursor in the subtree [ node_begin, node_end ) of the sorted_pats tree; retval: true if there is no more space in cur_playing_pats[]
+static bool sunvox_find_playing_patterns( int node, int node_begin, int node_end, int begin, int end, int* p, sunvox_engine* s )
+{
+    if( node_end <= begin || node_begin >= end ) return false;
+    if( s->sorted_pats_tree[ node ] <= s->line_counter ) return false;
+    if( node_end - node_begin == 1 )
+    {
+	int i = node_begin;
+	int pat_num = s->sorted_pats[ i ];
+	sunvox_pattern* pat = s->pats[ pat_num ];
+	sunvox_pattern_info* pat_info = &s->pats_info[ pat_num ];
+	if( s->line_counter >= pat_info->x &&
+	    s->line_counter < pat_info->x + pat->lines )
+	{
+	    int state_ptr = pat_info->state_ptr;
+	    if( !s->pat_state[ state_ptr ].busy )
+	    {
+		clean_pattern_state( &s->pat_state[ state_ptr ], s );
+	        s->pat_state[ state_ptr ].busy = true;
+	    }
+	    s->cur_playing_pats[ *p ] = i; 
+	    ( *p )++;
+	    if( *p >= s->pat_state_size )
+	    {
+		s->last_sort_pat = i - 1;
+		return true;
+	    }
+	}
+	return false;
+    }
+    int node_center = ( node_begin + node_end ) / 2;
+    if( sunvox_find_playing_patterns( node * 2, node_begin, node_center, begin, end, p, s ) ) return true;
+    return sunvox_find_playing_patterns( node * 2 + 1, node_center, node_end, begin, end, p, s );
+}
 void sunvox_select_current_playing_patterns( int first_sorted_pat, sunvox_engine* s )
 {
     if( first_sorted_pat < 0 ) first_sorted_pat = 0;
     s->cur_playing_pats[ 0 ] = -1;
     s->last_sort_pat = -1;
-    if( s->sorted_pats_num )
+    if( s->sorted_pats_num && s->pat_state_size )
     {
+	//Binary search: the first pattern that begins after the cursor:
+	int end_pat = s->sorted_pats_num;
+	int i1 = first_sorted_pat;
+	while( i1 < end_pat )
+	{
+	    int i = ( i1 + end_pat ) / 2;
+	    if( s->pats_info[ s->sorted_pats[ i ] ].x > s->line_counter )
+		end_pat = i;
+	    else
+		i1 = i + 1;
+	}
+	if( end_pat <= first_sorted_pat ) return;
+	s->last_sort_pat = end_pat - 1;
 	int p = 0;
-	for( int i = first_sorted_pat; i < s->sorted_pats_num; i++ )
+	if( s->sorted_pats_tree_leaves >= s->sorted_pats_num )
+	{
+	    //O( log N + K ):
+	    sunvox_find_playing_patterns( 1, 0, s->sorted_pats_tree_leaves, first_sorted_pat, end_pat, &p, s );
+	}
+	else
 	{
-	    int pat_num = s->sorted_pats[ i ];
-	    sunvox_pattern* pat = s->pats[ pat_num ];
-	    sunvox_pattern_info* pat_info = &s->pats_info[ pat_num ];
-	    if( s->line_counter >= pat_info->x &&
-		s->line_counter < pat_info->x + pat->lines )
+	    for( int i = first_sorted_pat; i < end_pat; i++ )
 	    {
-		int state_ptr = pat_info->state_ptr;
-		if( !s->pat_state[ state_ptr ].busy )
+		int pat_num = s->sorted_pats[ i ];
+		sunvox_pattern* pat = s->pats[ pat_num ];
+		sunvox_pattern_info* pat_info = &s->pats_info[ pat_num ];
+		if( s->line_counter < pat_info->x + pat->lines )
 		{
-		    clean_pattern_state( &s->pat_state[ state_ptr ], s );
-	    	    s->pat_state[ state_ptr ].busy = true;
+		    int state_ptr = pat_info->state_ptr;
+		    if( !s->pat_state[ state_ptr ].busy )
+		    {
+			clean_pattern_state( &s->pat_state[ state_ptr ], s );
+	    		s->pat_state[ state_ptr ].busy = true;
+		    }
+		    s->cur_playing_pats[ p ] = i; 
+		    p++; if( p >= s->pat_state_size ) { s->last_sort_pat = i - 1; break; }
 		}
-		s->cur_playing_pats[ p ] = i; 
-		p++; if( p >= s->pat_state_size ) break;
 	    }
-	    if( pat_info->x > s->line_counter )
-	    {
-		break;
-	    }
-	    s->last_sort_pat = i;
 	}
 	if( p < s->pat_state_size ) s->cur_playing_pats[ p ] = -1;
     }
@@ -347,7 +543,15 @@ void sunvox_new_pattern_with_num( int pat_num, int lines, int channels, int x, i
     pat->bg[ 2 ] = 255;
     pat->icon_num = -1; 
     pat->name = NULL;
+    pat->evt_index = NULL;
+    pat->evt_changes = 1;
+    pat->evt_index_changes = 0;
+    pat->evt_index_user = false;
+    sunvox_pattern_evt_index_resize( pat, s );
     pat_info->state_ptr = 0;
+    s->pats_names_changes++;
+    s->pats_changes++;
+    sunvox_reserve_pattern_state( pat_num, s );
 }
 int sunvox_new_pattern( int lines, int channels, int x, int y, uint icon_seed, sunvox_engine* s )
 {
@@ -359,6 +563,8 @@ int sunvox_new_pattern_empty_clone( int parent, int x, int y, sunvox_engine* s )
 {
     int pat_num = sunvox_get_free_pattern_num( s );
     s->pats[ pat_num ] = (sunvox_pattern*)1;
+    s->pats_names_changes++;
+    s->pats_changes++;
     sunvox_pattern_info* pat_info = &s->pats_info[ pat_num ];
     smem_clear( pat_info, sizeof( sunvox_pattern_info ) );
     pat_info->x = x;
@@ -399,6 +605,9 @@ int sunvox_new_pattern_clone( int pat_num, int x, int y, sunvox_engine *s )
 	s->pats_info[ p ].flags = SUNVOX_PATTERN_INFO_FLAG_CLONE | ( prev_flags & ( SUNVOX_PATTERN_INFO_FLAG_MUTE | SUNVOX_PATTERN_INFO_FLAG_SOLO ) );
 	s->pats_info[ p ].parent_num = pat_num;
 	s->pats_info[ p ].state_ptr = 0;
+	s->pats_names_changes++;
+	s->pats_changes++;
+	sunvox_reserve_pattern_state( p, s );
 	return p;
     }
     return -1;
@@ -413,6 +622,7 @@ void sunvox_detach_clone( int pat_num, sunvox_engine* s )
     sunvox_pattern* pat2 = (sunvox_pattern*)SMEM_CLONE( pat );
     pat2->data = (sunvox_note*)SMEM_CLONE( pat->data );
     pat2->name = (char*)SMEM_CLONE( pat->name );
+    pat2->evt_index = (uint32_t*)SMEM_CLONE( pat->evt_index );
     pat2->icon_num = -1; 
     pat2->id = s->pat_id_counter; s->pat_id_counter++;
     s->pats[ pat_num ] = pat2;
@@ -429,6 +639,8 @@ void sunvox_convert_to_clone( int pat_num, int parent, sunvox_engine* s )
     pat_info->flags |= SUNVOX_PATTERN_INFO_FLAG_CLONE;
     pat_info->parent_num = parent;
     s->pats[ pat_num ] = parent_pat;
+    s->pats_names_changes++;
+    s->pats_changes++;
 }
 void sunvox_remove_pattern( int pat_num, sunvox_engine* s )
 {
@@ -437,6 +649,8 @@ void sunvox_remove_pattern( int pat_num, sunvox_engine* s )
 	sunvox_pattern* pat = s->pats[ pat_num ];
 	if( pat )
 	{
+	    s->pats_names_changes++;
+	    s->pats_changes++;
 	    if( s->pats_info[ pat_num ].flags & SUNVOX_PATTERN_INFO_FLAG_CLONE )
 	    {
 		s->pats[ pat_num ] = NULL;
@@ -445,6 +659,7 @@ void sunvox_remove_pattern( int pat_num, sunvox_engine* s )
 	    {
 		if( pat->data ) smem_free( pat->data );
 		if( pat->name ) smem_free( pat->name );
+		smem_free( pat->evt_index );
 		sunvox_remove_icon( pat->icon_num, s );
 		smem_free( pat );
 		s->pats[ pat_num ] = NULL;
@@ -485,10 +700,57 @@ void sunvox_rename_pattern( int pat_num, const char* name, sunvox_engine* s )
     if( !pat ) return;
     smem_free( pat->name );
     pat->name = SMEM_STRDUP( name );
+    s->pats_names_changes++;
+}
+static void sunvox_build_pattern_names_index( sunvox_engine* s )
+{
+    int size_level = 0;
+    while( size_level < SSYMTAB_TABSIZE_NUM - 1 && g_ssymtab_tabsize[ size_level ] < s->pats_num ) size_level++;
+    ssymtab* st = s->pats_names;
+    if( st && st->size != g_ssymtab_tabsize[ size_level ] ) { ssymtab_delete( st ); st = NULL; }
+    if( st )
+	ssymtab_deinit( st );
+    else
+	st = SMEM_ZALLOC2( ssymtab, 1 );
+    s->pats_names = st;
+    if( !st ) return;
+    if( ssymtab_init( st, size_level ) ) { smem_free( st ); s->pats_names = NULL; return; }
+    for( int i = 0; i < s->pats_num; i++ )
+    {
+	sunvox_pattern* pat = s->pats[ i ];
+	if( !pat || !pat->name ) continue;
+	SSYMTAB_VAL v;
+	v.i = i;
+	bool created = false;
+	ssymtab_item* sym = ssymtab_lookup( pat->name, -1, true, 0, v, &created, st );
+	if( sym && created ) sym->val.i = i; //first pattern with this name
+    }
+    s->pats_names_index_changes = s->pats_names_changes;
+}
+void sunvox_update_pattern_names_index( sunvox_engine* s )
+{
+    if( s->pats_names && s->pats_names_index_changes == s->pats_names_changes ) return;
+    smutex_lock( &s->pats_names_mutex );
+    sunvox_build_pattern_names_index( s );
+    smutex_unlock( &s->pats_names_mutex );
 }
+//Can be called from the audio thread: the index is never rebuilt here;
+//if it is out of date or busy (rebuilding in the user thread), the patterns are scanned linearly:
 int sunvox_get_pattern_num_by_name( const char* name, sunvox_engine* s )
 {
     if( !name ) return -1;
+    if( s->pats_names && s->pats_names_index_changes == s->pats_names_changes && smutex_trylock( &s->pats_names_mutex ) == 0 )
+    {
+	int i = -2;
+	if( s->pats_names && s->pats_names_index_changes == s->pats_names_changes )
+	{
+	    i = ssymtab_iget( name, -1, s->pats_names );
+	    if( i >= 0 && !( i < s->pats_num && s->pats[ i ] && s->pats[ i ]->name && strcmp( s->pats[ i ]->name, name ) == 0 ) )
+		i = -2; //not a real match: scan
+	}
+	smutex_unlock( &s->pats_names_mutex );
+	if( i != -2 ) return i;
+    }
     for( int i = 0; i < s->pats_num; i++ )
     {
 	sunvox_pattern* pat = s->pats[ i ];
@@ -514,6 +776,51 @@ sunvox_note* sunvox_get_pattern_event( int pat_num, int track, int line, sunvox_
     }
     return NULL;
 }
+static uint32_t get_line_tracks( sunvox_pattern* pat, int line )
+{
+    uint32_t tracks = 0;
+    sunvox_note* n = &pat->data[ line * pat->data_xsize ];
+    for( int x = 0; x < pat->channels; x++, n++ )
+    {
+	if( n->note | n->vel | n->mod | n->ctl | n->ctl_val ) tracks |= 1u << x;
+    }
+    return tracks;
+}
+void sunvox_pattern_evt_index_resize( sunvox_pattern* pat, sunvox_engine* s )
+{
+    if( !pat->evt_index || pat->data_ysize > (int)( smem_get_size( pat->evt_index ) / sizeof( uint32_t ) ) )
+    {
+	pat->evt_index = SMEM_RESIZE2( pat->evt_index, uint32_t, pat->data_ysize );
+    }
+    SUNVOX_PATTERN_CHANGED( pat, s );
+}
+uint32_t* sunvox_pattern_get_evt_index( sunvox_pattern* pat )
+{
+    uint32_t* index = pat->evt_index;
+    if( !index ) return NULL;
+    uint32_t changes = pat->evt_changes;
+    if( pat->evt_index_changes == changes ) return index;
+    if( pat->channels > MAX_PATTERN_TRACKS || pat->lines > (int)( smem_get_size( index ) / sizeof( uint32_t ) ) ) return NULL;
+    //Rebuild without reallocation: the index may be read by another thread (time map):
+    for( int y = 0; y < pat->lines; y++ )
+    {
+	index[ y ] = get_line_tracks( pat, y );
+    }
+    pat->evt_index_changes = changes;
+    return index;
+}
+void sunvox_pattern_evt_changed( sunvox_pattern* pat, int line, sunvox_engine* s )
+{
+    if( pat->evt_index_changes != pat->evt_changes || (unsigned)line >= (unsigned)pat->lines )
+    {
+	SUNVOX_PATTERN_CHANGED( pat, s );
+	return;
+    }
+    pat->evt_index[ line ] = get_line_tracks( pat, line );
+    pat->evt_changes++; //content has been changed, but the index is still valid
+    pat->evt_index_changes++;
+    s->pats_changes++;
+}
 int sunvox_get_free_icon_number( sunvox_engine *s )
 {
     if( s->flags & SUNVOX_FLAG_NO_GUI ) return 0;
@@ -644,6 +951,7 @@ void sunvox_pattern_set_number_of_channels( int pat_num, int cnum, sunvox_engine
 	    }
 	}
 	pat->channels = cnum;
+	SUNVOX_PATTERN_CHANGED( pat, s );
     }
 }
 int sunvox_pattern_set_number_of_lines( int pat_num, int lnum, bool rescale_content, sunvox_engine* s )
@@ -659,6 +967,7 @@ int sunvox_pattern_set_number_of_lines( int pat_num, int lnum, bool rescale_cont
         {
     	    pat->data = new_data;
     	    pat->data_ysize = lnum;
+    	    sunvox_pattern_evt_index_resize( pat, s );
 	}
 	else
 	{
@@ -708,11 +1017,14 @@ int sunvox_pattern_set_number_of_lines( int pat_num, int lnum, bool rescale_cont
 	break;
     }
     pat->lines = lnum;
+    SUNVOX_PATTERN_CHANGED( pat, s );
+    sunvox_reserve_pattern_state( pat_num, s );
     return 0;
 }
 void sunvox_check_solo_mode( sunvox_engine* s )
 {
     s->pats_solo_mode = 0;
+    s->pats_changes++;
     for( int i = 0; i < s->pats_num; i++ )
     {
         if( s->pats[ i ] && ( s->pats_info[ i ].flags & SUNVOX_PATTERN_INFO_FLAG_SOLO ) )
@@ -762,6 +1074,7 @@ int sunvox_pattern_shift( int pat_num, int track, int line, int lines, int cnt,
         }
         cnt -= cnt2;
     }
+    SUNVOX_PATTERN_CHANGED( pat, s );
     return 0;
 }
 int sunvox_check_pattern_evts( int pat_num, int x, int y, int xsize, int ysize, sunvox_engine* sv )
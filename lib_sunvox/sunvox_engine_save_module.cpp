@@ -249,7 +249,15 @@ int sunvox_save_module_to_fd( int mod_num, sfs_file f, uint save_flags, sunvox_e
         	{
     		    if( !( c->flags & PS_CHUNK_FLAG_DONT_SAVE ) )
             	    {
-            	        if( save_block( BID_CHNM, 4, &cn, st ) ) break;
+            	        uint cnm[ 3 ] = { cn, 0, 0 };
+            	        size_t cnm_size = 4;
+            	        if( smem_get_size( c->data ) >= SMEM_MAP_MIN_SIZE )
+            	        {
+            	            //Pad CHNM (only the first 4 bytes are read) so the CHDT data is 8-byte aligned in the file and can be mapped by the loader;
+            	            //CHNM header + number + CHDT header = 20 bytes:
+            	            cnm_size += (size_t)( 8 - ( ( sfs_tell( st->f ) + 20 ) & 7 ) ) & 7;
+            	        }
+            	        if( save_block( BID_CHNM, cnm_size, cnm, st ) ) break;
             		if( save_block( BID_CHDT, smem_get_size( c->data ), c->data, st ) ) break;
             		if( c->flags ) { if( save_block( BID_CHFF, 4, &c->flags, st ) ) break; }
             		if( c->freq ) { if( save_block( BID_CHFR, 4, &c->freq, st ) ) break; }
@@ -13,6 +13,7 @@ public class SunVoxLib
 	public static final int SV_INIT_FLAG_AUDIO_INT16 = 1 << 2;
 	public static final int SV_INIT_FLAG_AUDIO_FLOAT32 = 1 << 3;
 	public static final int SV_INIT_FLAG_ONE_THREAD = 1 << 4;
+	public static final int SV_INIT_FLAG_MAP_FILES = 1 << 5;
 
 	public static final int SV_MODULE_FLAG_EXISTS = 1 << 0;
 	public static final int SV_MODULE_FLAG_GENERATOR = 1 << 1;
@@ -0,0 +1,369 @@
+//
+// Synthetic SunVox projects for the benchmarks and regression tests.
+// Everything is generated with the library API, so no external files are needed.
+// Each builder fills an empty (just opened) slot.
+//
+
+#ifndef BENCH_PROJECTS_H
+#define BENCH_PROJECTS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define BENCH_SR 44100
+
+typedef int (*bench_build_fn)( int slot, const char* mod_type, int par );
+
+typedef struct
+{
+    const char* name;
+    bench_build_fn build;
+    const char* mod_type; //module type (for single module projects)
+    int par; //project specific parameter
+} bench_project;
+
+static unsigned int bench_rand_seed = 1;
+static int bench_rand( void )
+{
+    bench_rand_seed = bench_rand_seed * 1103515245 + 12345;
+    return ( bench_rand_seed >> 16 ) & 0x7FFF;
+}
+
+//Simple chord sequence: tracks x lines; one note per track every "step" lines
+static int bench_fill_notes( int slot, int pat, int tracks, int lines, int step, int mod_num )
+{
+    static const int chord[ 8 ] = { 0, 4, 7, 12, 16, 19, 24, 28 };
+    for( int l = 0; l < lines; l += step )
+    {
+        int base = 37 + ( ( l / 16 ) % 4 ) * 5;
+        for( int t = 0; t < tracks; t++ )
+        {
+            int note = base + chord[ t % 8 ] + ( t / 8 ) * 12;
+            if( note > 120 ) note = 120;
+            sv_set_pattern_event( slot, pat, t, l, note, 129, mod_num + 1, 0, 0 );
+        }
+    }
+    return 0;
+}
+
+//Mono 16-bit WAV: decaying saw + noise; the caller must free() it
+static void* bench_make_wav( int frames, unsigned int* size )
+{
+    unsigned int data_size = frames * 2;
+    unsigned char* wav = (unsigned char*)malloc( 44 + data_size );
+    if( !wav ) return NULL;
+    unsigned int v;
+    memcpy( wav, "RIFF", 4 ); v = 36 + data_size; memcpy( wav + 4, &v, 4 );
+    memcpy( wav + 8, "WAVEfmt ", 8 ); v = 16; memcpy( wav + 16, &v, 4 );
+    unsigned short fmt[ 2 ] = { 1, 1 }; memcpy( wav + 20, fmt, 4 ); //PCM, mono
+    v = BENCH_SR; memcpy( wav + 24, &v, 4 );
+    v = BENCH_SR * 2; memcpy( wav + 28, &v, 4 );
+    unsigned short blk[ 2 ] = { 2, 16 }; memcpy( wav + 32, blk, 4 );
+    memcpy( wav + 36, "data", 4 ); memcpy( wav + 40, &data_size, 4 );
+    short* s = (short*)( wav + 44 );
+    bench_rand_seed = 1;
+    //Integer arithmetic only, so the fixture doesn't depend on libm and the compiler flags (-ffast-math):
+    unsigned int phase = 0; //saw: 261.63 Hz; 32.32 fixed point
+    long long env = 1 << 30; //exp( -t * 3 ); 2.30 fixed point
+    for( int i = 0; i < frames; i++ )
+    {
+        int saw = (int)( phase >> 16 ) - 32768;
+        int noise = bench_rand() - 16384;
+        long long v = (long long)( saw * 4 / 5 + noise / 5 ) * 20000 * env; //( saw * 0.8 + noise * 0.1 ) * 20000 * env
+        s[ i ] = (short)( v / ( 1LL << 45 ) );
+        phase += 25480551; //261.63 * 2^32 / 44100
+        env = ( env * 1073668783 ) >> 30; //exp( -3 / 44100 ) * 2^30
+    }
+    *size = 44 + data_size;
+    return wav;
+}
+
+//Generator -> Output
+static int bench_build_generator( int slot, const char* mod_type, int par )
+{
+    sv_lock_slot( slot );
+    int mod = sv_new_module( slot, mod_type, mod_type, 256, 0, 0 );
+    if( mod < 0 ) { sv_unlock_slot( slot ); return -1; }
+    sv_connect_module( slot, mod, 0 );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 8, 64, 0, "notes" );
+    sv_unlock_slot( slot );
+    bench_fill_notes( slot, pat, 8, 64, 8, mod );
+    return 0;
+}
+
+//Analog generator -> Effect -> Output; par = 1: Analog generator -> Output too (for the analyzers)
+static int bench_build_effect( int slot, const char* mod_type, int par )
+{
+    sv_lock_slot( slot );
+    int src = sv_new_module( slot, "Analog generator", "src", 128, 0, 0 );
+    int mod = sv_new_module( slot, mod_type, mod_type, 256, 0, 0 );
+    if( src < 0 || mod < 0 ) { sv_unlock_slot( slot ); return -1; }
+    sv_connect_module( slot, src, mod );
+    sv_connect_module( slot, mod, 0 );
+    if( par ) sv_connect_module( slot, src, 0 );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 4, 64, 0, "notes" );
+    sv_unlock_slot( slot );
+    bench_fill_notes( slot, pat, 4, 64, 4, src );
+    return 0;
+}
+
+//Analog generator -> Compressor (look-ahead limiter; -12 dB) -> Output; par = compressor mode
+static int bench_build_limiter( int slot, const char* mod_type, int par )
+{
+    if( bench_build_effect( slot, "Compressor", 0 ) ) return -1;
+    int mod = sv_find_module( slot, "Compressor" );
+    sv_set_module_ctl_value( slot, 1, 0, 256, 0 ); //source volume
+    sv_set_module_ctl_value( slot, mod, 1, 64, 0 ); //threshold
+    sv_set_module_ctl_value( slot, mod, 5, par, 0 ); //mode
+    return 0;
+}
+
+//Analog generator -> Pitch Detector -> Analog generator (follower) -> Output; par = detection algorithm
+//The follower plays the detected notes; its volume is controlled by the detector confidence.
+static int bench_build_pitch_detector( int slot, const char* mod_type, int par )
+{
+    sv_lock_slot( slot );
+    int src = sv_new_module( slot, "Analog generator", "src", 128, 0, 0 );
+    int mod = sv_new_module( slot, "Pitch Detector", "Pitch Detector", 256, 0, 0 );
+    int dest = sv_new_module( slot, "Analog generator", "follower", 384, 0, 0 );
+    if( src < 0 || mod < 0 || dest < 0 ) { sv_unlock_slot( slot ); return -1; }
+    sv_connect_module( slot, src, mod );
+    sv_connect_module( slot, mod, dest );
+    sv_connect_module( slot, dest, 0 );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 4, 64, 0, "notes" );
+    sv_unlock_slot( slot );
+    bench_fill_notes( slot, pat, 1, 64, 4, src );
+    sv_set_module_ctl_value( slot, mod, 0, par, 0 ); //algorithm
+    sv_set_module_ctl_value( slot, mod, 13, 1, 0 ); //confidence -> follower volume
+    return 0;
+}
+
+//Sampler with a generated sample; par = number of tracks (voices)
+static int bench_build_sampler_poly( int slot, const char* mod_type, int par )
+{
+    sv_lock_slot( slot );
+    int mod = sv_new_module( slot, "Sampler", "sampler", 256, 0, 0 );
+    if( mod < 0 ) { sv_unlock_slot( slot ); return -1; }
+    sv_connect_module( slot, mod, 0 );
+    int pat = sv_new_pattern( slot, -1, 0, 0, par, 64, 0, "notes" );
+    sv_unlock_slot( slot );
+    unsigned int wav_size = 0;
+    void* wav = bench_make_wav( BENCH_SR * 2, &wav_size );
+    if( !wav ) return -1;
+    sv_sampler_load_from_memory( slot, mod, wav, wav_size, -1 );
+    free( wav );
+    sv_sampler_par( slot, mod, 0, 2, 1, 1 ); //forward loop
+    sv_set_module_ctl_value( slot, mod, 4, 32, 0 ); //max polyphony
+    bench_fill_notes( slot, pat, par, 64, 2, mod );
+    return 0;
+}
+
+//Same as sampler_poly, but with the packed sample (sv_sampler_par() 9)
+static int bench_build_sampler_packed( int slot, const char* mod_type, int par )
+{
+    if( bench_build_sampler_poly( slot, mod_type, par ) ) return -1;
+    int mod = sv_find_module( slot, "sampler" );
+    if( mod < 0 ) return -1;
+    if( sv_sampler_par( slot, mod, 0, 9, 1, 1 ) != 0 || sv_sampler_par( slot, mod, 0, 9, 0, 0 ) != 1 ) return -1;
+    return 0;
+}
+
+//Same as sampler_poly (32 tracks), but with the loop inside the sample; par: 1 - forward (long loop); 2 - ping-pong (short loop, sinc 32)
+static int bench_build_sampler_loop( int slot, const char* mod_type, int par )
+{
+    if( bench_build_sampler_poly( slot, mod_type, 32 ) ) return -1;
+    int mod = sv_find_module( slot, "sampler" );
+    if( mod < 0 ) return -1;
+    if( par == 1 )
+    {
+        sv_sampler_par( slot, mod, 0, 0, 2000, 1 ); //loop start
+        sv_sampler_par( slot, mod, 0, 1, 3000, 1 ); //loop length
+    }
+    else
+    {
+        sv_sampler_par( slot, mod, 0, 0, 3000, 1 );
+        sv_sampler_par( slot, mod, 0, 1, 50, 1 );
+        sv_set_module_ctl_value( slot, mod, 2, 5, 0 ); //sample interpolation: sinc 32
+    }
+    sv_sampler_par( slot, mod, 0, 2, par, 1 ); //loop type
+    return 0;
+}
+
+//Same as sampler_loop, but with the packed sample
+static int bench_build_sampler_loop_packed( int slot, const char* mod_type, int par )
+{
+    if( bench_build_sampler_loop( slot, mod_type, par ) ) return -1;
+    int mod = sv_find_module( slot, "sampler" );
+    if( mod < 0 ) return -1;
+    if( sv_sampler_par( slot, mod, 0, 9, 1, 1 ) != 0 || sv_sampler_par( slot, mod, 0, 9, 0, 0 ) != 1 ) return -1;
+    return 0;
+}
+
+//Analog generator -> Filter -> Output; par = number of tracks setting the filter frequency on every line (controller flood)
+static int bench_build_ctl_flood( int slot, const char* mod_type, int par )
+{
+    sv_lock_slot( slot );
+    int src = sv_new_module( slot, "Analog generator", "src", 128, 0, 0 );
+    int mod = sv_new_module( slot, "Filter", "Filter", 256, 0, 0 );
+    if( src < 0 || mod < 0 ) { sv_unlock_slot( slot ); return -1; }
+    sv_connect_module( slot, src, mod );
+    sv_connect_module( slot, mod, 0 );
+    int pat = sv_new_pattern( slot, -1, 0, 0, par + 1, 64, 0, "ctls" );
+    sv_unlock_slot( slot );
+    bench_fill_notes( slot, pat, 1, 64, 4, src );
+    bench_rand_seed = 3;
+    for( int l = 0; l < 64; l++ )
+        for( int t = 1; t <= par; t++ )
+            sv_set_pattern_event( slot, pat, t, l, 0, 0, mod + 1, 0x0200, bench_rand() ); //frequency
+    return 0;
+}
+
+//ADSR (generator) -> Output; the envelope is restarted every par lines by writing State = 0 and State = 1 at the same time (two tracks)
+static int bench_build_ctl_retrigger( int slot, const char* mod_type, int par )
+{
+    sv_lock_slot( slot );
+    int mod = sv_new_module( slot, "ADSR", "ADSR", 256, 0, 0 );
+    if( mod < 0 ) { sv_unlock_slot( slot ); return -1; }
+    sv_connect_module( slot, mod, 0 );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 2, 64, 0, "ctls" );
+    sv_unlock_slot( slot );
+    sv_set_module_ctl_value( slot, mod, 1, 100, 2 ); //attack (ms)
+    sv_set_module_ctl_value( slot, mod, 2, 200, 2 ); //decay (ms)
+    sv_set_module_ctl_value( slot, mod, 3, 8192, 0 ); //sustain level
+    for( int l = 0; l < 64; l += par )
+    {
+        sv_set_pattern_event( slot, pat, 0, l, 0, 0, mod + 1, 0x0B00, 0 ); //State = stop
+        sv_set_pattern_event( slot, pat, 1, l, 0, 0, mod + 1, 0x0B00, 1 ); //State = start
+    }
+    return 0;
+}
+
+//Same as sampler_poly, but with the windowed-sinc interpolation; par = interpolation mode (3..5)
+static int bench_build_sampler_sinc( int slot, const char* mod_type, int par )
+{
+    if( bench_build_sampler_poly( slot, mod_type, 32 ) ) return -1;
+    int mod = sv_find_module( slot, "sampler" );
+    if( mod < 0 ) return -1;
+    sv_set_module_ctl_value( slot, mod, 2, par, 0 ); //sample interpolation
+    return 0;
+}
+
+//MetaModule nesting; par = depth
+static int bench_build_metamodule( int slot, const char* mod_type, int par )
+{
+    //Level 0 (in the temporary slot): Analog generator -> Reverb -> Output
+    int tmp_slot = slot + 1;
+    sv_open_slot( tmp_slot );
+    sv_lock_slot( tmp_slot );
+    int gen = sv_new_module( tmp_slot, "Analog generator", "gen", 128, 0, 0 );
+    int rev = sv_new_module( tmp_slot, "Reverb", "rev", 256, 0, 0 );
+    sv_connect_module( tmp_slot, gen, rev );
+    sv_connect_module( tmp_slot, rev, 0 );
+    sv_unlock_slot( tmp_slot );
+    size_t size = 0;
+    void* data = sv_save_to_memory( tmp_slot, &size );
+    sv_close_slot( tmp_slot );
+    //Level 1...depth: MetaModule(previous level) -> Output
+    for( int level = 1; level <= par && data; level++ )
+    {
+        int s = level == par ? slot : tmp_slot;
+        if( s == tmp_slot ) sv_open_slot( s );
+        sv_lock_slot( s );
+        int mm = sv_new_module( s, "MetaModule", "meta", 256, 0, 0 );
+        sv_connect_module( s, mm, 0 );
+        sv_unlock_slot( s );
+        sv_metamodule_load_from_memory( s, mm, data, (uint32_t)size );
+        free( data );
+        data = NULL;
+        if( s == tmp_slot )
+        {
+            data = sv_save_to_memory( s, &size );
+            sv_close_slot( s );
+        }
+        else
+        {
+            sv_lock_slot( s );
+            int pat = sv_new_pattern( s, -1, 0, 0, 8, 64, 0, "notes" );
+            sv_unlock_slot( s );
+            bench_fill_notes( s, pat, 8, 64, 8, mm );
+        }
+    }
+    free( data );
+    return 0;
+}
+
+//Big arrangement: par patterns (16 tracks x 32 lines) on the timeline, many of them overlapping
+static int bench_build_arrangement( int slot, const char* mod_type, int par )
+{
+    sv_lock_slot( slot );
+    int mods[ 4 ];
+    for( int i = 0; i < 4; i++ )
+    {
+        mods[ i ] = sv_new_module( slot, i & 1 ? "FM" : "Generator", "gen", 128 + i * 64, 0, 0 );
+        sv_connect_module( slot, mods[ i ], 0 );
+    }
+    int pats[ 8 ];
+    for( int i = 0; i < 8; i++ )
+        pats[ i ] = sv_new_pattern( slot, -1, 0, i * 32, 16, 32, i, "src" );
+    bench_rand_seed = 2;
+    for( int i = 8; i < par; i++ )
+    {
+        //Clones of the source patterns:
+        sv_new_pattern( slot, pats[ i % 8 ], ( i / 8 ) * 16 + bench_rand() % 16, ( i % 64 ) * 32, 16, 32, 0, NULL );
+    }
+    sv_unlock_slot( slot );
+    for( int i = 0; i < 8; i++ )
+    {
+        bench_fill_notes( slot, pats[ i ], 4, 32, 4 + ( i & 3 ), mods[ i & 3 ] );
+        sv_set_pattern_event( slot, pats[ i ], 15, 16, 0, 0, mods[ i & 3 ] + 1, 0x0100, 0x4000 ); //controller
+    }
+    return 0;
+}
+
+static const bench_project g_bench_projects[] =
+{
+    { "gen_generator", bench_build_generator, "Generator", 0 },
+    { "gen_analog_generator", bench_build_generator, "Analog generator", 0 },
+    { "gen_fm", bench_build_generator, "FM", 0 },
+    { "gen_fmx", bench_build_generator, "FMX", 0 },
+    { "gen_drumsynth", bench_build_generator, "DrumSynth", 0 },
+    { "gen_kicker", bench_build_generator, "Kicker", 0 },
+    { "gen_spectravoice", bench_build_generator, "SpectraVoice", 0 },
+    { "fx_amplifier", bench_build_effect, "Amplifier", 0 },
+    { "fx_compressor", bench_build_effect, "Compressor", 0 },
+    { "fx_dc_blocker", bench_build_effect, "DC Blocker", 0 },
+    { "fx_delay", bench_build_effect, "Delay", 0 },
+    { "fx_distortion", bench_build_effect, "Distortion", 0 },
+    { "fx_echo", bench_build_effect, "Echo", 0 },
+    { "fx_eq", bench_build_effect, "EQ", 0 },
+    { "fx_filter", bench_build_effect, "Filter", 0 },
+    { "fx_filter_pro", bench_build_effect, "Filter Pro", 0 },
+    { "fx_flanger", bench_build_effect, "Flanger", 0 },
+    { "fx_loop", bench_build_effect, "Loop", 0 },
+    { "fx_modulator", bench_build_effect, "Modulator", 0 },
+    { "fx_pitch_shifter", bench_build_effect, "Pitch shifter", 0 },
+    { "fx_reverb", bench_build_effect, "Reverb", 0 },
+    { "fx_vibrato", bench_build_effect, "Vibrato", 0 },
+    { "fx_vocal_filter", bench_build_effect, "Vocal filter", 0 },
+    { "fx_waveshaper", bench_build_effect, "WaveShaper", 0 },
+    { "fx_pitch_detector", bench_build_pitch_detector, NULL, 1 },
+    { "fx_pitch_detector_mpm", bench_build_pitch_detector, NULL, 4 },
+    { "fx_limiter", bench_build_limiter, NULL, 3 },
+    { "fx_limiter_true_peak", bench_build_limiter, NULL, 4 },
+    { "sampler_poly32", bench_build_sampler_poly, NULL, 32 },
+    { "sampler_packed_poly32", bench_build_sampler_packed, NULL, 32 },
+    { "sampler_sinc16_poly32", bench_build_sampler_sinc, NULL, 4 },
+    { "sampler_loop_poly32", bench_build_sampler_loop, NULL, 1 },
+    { "sampler_packed_loop_poly32", bench_build_sampler_loop_packed, NULL, 1 },
+    { "sampler_pingpong_poly32", bench_build_sampler_loop, NULL, 2 },
+    { "sampler_packed_pingpong_poly32", bench_build_sampler_loop_packed, NULL, 2 },
+    { "ctl_flood32", bench_build_ctl_flood, NULL, 32 },
+    { "ctl_retrigger8", bench_build_ctl_retrigger, NULL, 8 },
+    { "metamodule_nest4", bench_build_metamodule, NULL, 4 },
+    { "arrangement_2000", bench_build_arrangement, NULL, 2000 },
+};
+#define BENCH_PROJECTS_NUM ( (int)( sizeof( g_bench_projects ) / sizeof( bench_project ) ) )
+
+#endif
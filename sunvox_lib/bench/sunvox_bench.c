@@ -0,0 +1,247 @@
+//
+// sunvox_bench - headless offline rendering benchmark
+//
+// Renders the synthetic projects from bench_projects.h (or the specified *.sunvox files)
+// *.ogg files: Vorbis player decoding benchmark (4 voices; build option MAKE_WITH_LIBVORBIS_DECODER selects the decoder)
+// and prints one JSON object per project (JSON Lines):
+//   name, frames, seconds (wall time), fps (rendered frames per second), rtf (realtime factor),
+//   chunk_p50_us, chunk_p99_us, chunk_max_us (render time of one audio buffer),
+//   peak_rss_kb (peak memory; each project is rendered in a separate child process, so it's the peak of this project only;
+//   Windows: peak of the whole run),
+//   rms (output level; zero = something is wrong with the project)
+//
+// Usage: sunvox_bench [-t seconds] [-b buffer_frames] [-f name_filter] [-l (list)] [file.sunvox|file.ogg ...]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <time.h>
+    #include <sys/resource.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+#define SUNVOX_STATIC_LIB
+#include "../headers/sunvox.h"
+#include "bench_projects.h"
+
+static double bench_time_us( void )
+{
+#ifdef _WIN32
+    LARGE_INTEGER f, c;
+    QueryPerformanceFrequency( &f );
+    QueryPerformanceCounter( &c );
+    return (double)c.QuadPart * 1000000.0 / (double)f.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (double)ts.tv_sec * 1000000.0 + (double)ts.tv_nsec / 1000.0;
+#endif
+}
+
+static long bench_peak_rss_kb( void )
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if( GetProcessMemoryInfo( GetCurrentProcess(), &pmc, sizeof( pmc ) ) ) return (long)( pmc.PeakWorkingSetSize / 1024 );
+    return 0;
+#else
+    struct rusage ru;
+    if( getrusage( RUSAGE_SELF, &ru ) ) return 0;
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1024; //bytes
+#else
+    return ru.ru_maxrss; //kilobytes
+#endif
+#endif
+}
+
+static int bench_cmp_double( const void* a, const void* b )
+{
+    double v1 = *(const double*)a;
+    double v2 = *(const double*)b;
+    return ( v1 > v2 ) - ( v1 < v2 );
+}
+
+static void bench_json_str( const char* s )
+{
+    putchar( '"' );
+    for( ; *s; s++ )
+    {
+        if( *s == '"' || *s == '\\' ) putchar( '\\' );
+        putchar( *s );
+    }
+    putchar( '"' );
+}
+
+static int bench_is_ogg( const char* name )
+{
+    size_t len = strlen( name );
+    if( len < 4 ) return 0;
+    const char* ext = name + len - 4;
+    return ext[ 0 ] == '.' && ( ext[ 1 ] | 0x20 ) == 'o' && ( ext[ 2 ] | 0x20 ) == 'g' && ( ext[ 3 ] | 0x20 ) == 'g';
+}
+
+//Vorbis player with the specified file: 4 voices, original speed, repeat
+static int bench_build_vplayer( int slot, const char* path )
+{
+    sv_lock_slot( slot );
+    int mod = sv_new_module( slot, "Vorbis player", "vplayer", 256, 0, 0 );
+    if( mod < 0 ) { sv_unlock_slot( slot ); return -1; }
+    sv_connect_module( slot, mod, 0 );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 4, 64, 0, "notes" );
+    sv_unlock_slot( slot );
+    if( sv_vplayer_load( slot, mod, path ) ) return -1;
+    sv_set_module_ctl_value( slot, mod, 5, 4, 0 ); //polyphony
+    sv_set_module_ctl_value( slot, mod, 6, 1, 0 ); //repeat
+    bench_fill_notes( slot, pat, 4, 64, 16, mod );
+    return 0;
+}
+
+//Render "seconds" of the project in the slot and print the results:
+static int bench_run( int slot, const char* name, int seconds, int buf_frames )
+{
+    int frames = BENCH_SR * seconds;
+    int chunks = ( frames + buf_frames - 1 ) / buf_frames;
+    float* buf = (float*)malloc( buf_frames * 2 * sizeof( float ) );
+    double* chunk_t = (double*)malloc( chunks * sizeof( double ) );
+    if( !buf || !chunk_t ) { free( buf ); free( chunk_t ); return -1; }
+    sv_set_autostop( slot, 0 );
+    sv_play_from_beginning( slot );
+    double t_start = bench_time_us();
+    int rendered = 0;
+    double sum = 0;
+    for( int i = 0; i < chunks; i++ )
+    {
+        int n = frames - rendered;
+        if( n > buf_frames ) n = buf_frames;
+        double t1 = bench_time_us();
+        sv_audio_callback( buf, n, 0, sv_get_ticks() );
+        chunk_t[ i ] = bench_time_us() - t1;
+        for( int s = 0; s < n * 2; s++ ) sum += buf[ s ] * buf[ s ];
+        rendered += n;
+    }
+    double total_us = bench_time_us() - t_start;
+    sv_stop( slot );
+    qsort( chunk_t, chunks, sizeof( double ), bench_cmp_double );
+    double p50 = chunk_t[ chunks / 2 ];
+    double p99 = chunk_t[ ( chunks * 99 ) / 100 < chunks ? ( chunks * 99 ) / 100 : chunks - 1 ];
+    double max = chunk_t[ chunks - 1 ];
+    double secs = total_us / 1000000.0;
+    if( secs <= 0 ) secs = 1e-9;
+    printf( "{\"name\":" );
+    bench_json_str( name );
+    printf( ",\"frames\":%d,\"buffer\":%d,\"seconds\":%.6f,\"fps\":%.1f,\"rtf\":%.3f,\"chunk_p50_us\":%.2f,\"chunk_p99_us\":%.2f,\"chunk_max_us\":%.2f,\"peak_rss_kb\":%ld,\"rms\":%.6f}\n",
+        rendered, buf_frames, secs, (double)rendered / secs, ( (double)rendered / BENCH_SR ) / secs, p50, p99, max, bench_peak_rss_kb(), sqrt( sum / ( rendered * 2 ) ) );
+    fflush( stdout );
+    free( buf );
+    free( chunk_t );
+    return 0;
+}
+
+//Build and render one project: synthetic project p or the file (*.sunvox, *.ogg):
+static int bench_project_run( const bench_project* p, const char* file, int seconds, int buf_frames )
+{
+    int flags = SV_INIT_FLAG_USER_AUDIO_CALLBACK | SV_INIT_FLAG_AUDIO_FLOAT32 | SV_INIT_FLAG_ONE_THREAD | SV_INIT_FLAG_NO_DEBUG_OUTPUT;
+    if( sv_init( 0, BENCH_SR, 2, flags ) < 0 )
+    {
+        fprintf( stderr, "sv_init() error\n" );
+        return 1;
+    }
+    int rv = 0;
+    sv_open_slot( 0 );
+    if( file )
+    {
+        if( ( bench_is_ogg( file ) ? bench_build_vplayer( 0, file ) : sv_load( 0, file ) ) == 0 )
+            bench_run( 0, file, seconds, buf_frames );
+        else
+        {
+            fprintf( stderr, "Can't load %s\n", file );
+            rv = 1;
+        }
+    }
+    else
+    {
+        if( p->build( 0, p->mod_type, p->par ) == 0 )
+            bench_run( 0, p->name, seconds, buf_frames );
+        else
+        {
+            fprintf( stderr, "Can't build %s\n", p->name );
+            rv = 1;
+        }
+    }
+    sv_close_slot( 0 );
+    sv_deinit();
+    return rv;
+}
+
+//Run the project in a child process: getrusage() peak RSS never goes down, so it must be measured per process
+static int bench_project_isolated( const bench_project* p, const char* file, int seconds, int buf_frames )
+{
+#ifdef _WIN32
+    return bench_project_run( p, file, seconds, buf_frames );
+#else
+    fflush( stdout );
+    pid_t pid = fork();
+    if( pid < 0 ) return bench_project_run( p, file, seconds, buf_frames );
+    if( pid == 0 ) _exit( bench_project_run( p, file, seconds, buf_frames ) );
+    int status = 0;
+    if( waitpid( pid, &status, 0 ) < 0 ) return 1;
+    if( !WIFEXITED( status ) )
+    {
+        fprintf( stderr, "%s: the child process has crashed\n", file ? file : p->name );
+        return 1;
+    }
+    return WEXITSTATUS( status );
+#endif
+}
+
+int main( int argc, char* argv[] )
+{
+    int seconds = 10;
+    int buf_frames = 1024;
+    const char* filter = NULL;
+    int list = 0;
+    int files = 0;
+    for( int i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[ i ], "-t" ) == 0 && i + 1 < argc ) seconds = atoi( argv[ ++i ] );
+        else if( strcmp( argv[ i ], "-b" ) == 0 && i + 1 < argc ) buf_frames = atoi( argv[ ++i ] );
+        else if( strcmp( argv[ i ], "-f" ) == 0 && i + 1 < argc ) filter = argv[ ++i ];
+        else if( strcmp( argv[ i ], "-l" ) == 0 ) list = 1;
+        else if( argv[ i ][ 0 ] == '-' ) { fprintf( stderr, "Usage: %s [-t seconds] [-b buffer_frames] [-f name_filter] [-l] [file.sunvox|file.ogg ...]\n", argv[ 0 ] ); return 1; }
+        else files++;
+    }
+    if( list )
+    {
+        for( int i = 0; i < BENCH_PROJECTS_NUM; i++ ) printf( "%s\n", g_bench_projects[ i ].name );
+        return 0;
+    }
+    if( seconds < 1 ) seconds = 1;
+    if( buf_frames < 16 ) buf_frames = 16;
+
+    int rv = 0;
+    if( files )
+    {
+        for( int i = 1; i < argc; i++ )
+        {
+            if( argv[ i ][ 0 ] == '-' ) { if( strcmp( argv[ i ], "-l" ) ) i++; continue; }
+            if( bench_project_isolated( NULL, argv[ i ], seconds, buf_frames ) ) rv = 1;
+        }
+    }
+    else
+    {
+        for( int i = 0; i < BENCH_PROJECTS_NUM; i++ )
+        {
+            const bench_project* p = &g_bench_projects[ i ];
+            if( filter && !strstr( p->name, filter ) ) continue;
+            if( bench_project_isolated( p, NULL, seconds, buf_frames ) ) rv = 1;
+        }
+    }
+    return rv;
+}
@@ -47,6 +47,10 @@ typedef struct
 							   /* The actual sample type may be different, if SV_INIT_FLAG_USER_AUDIO_CALLBACK is not set */
 #define SV_INIT_FLAG_ONE_THREAD			( 1 << 4 ) /* Audio callback and song modification are in single thread */
 							   /* Use it with SV_INIT_FLAG_USER_AUDIO_CALLBACK only */
+#define SV_INIT_FLAG_MAP_FILES			( 1 << 5 ) /* sv_load(), sv_load_module(): large sample chunks (64 KB+) are not copied, */
+							   /* but mapped from the file (copy-on-write; Linux/macOS/Android; ignored for the memory buffers); */
+							   /* the file must not be truncated or rewritten in place by other programs while the project is loaded; */
+							   /* the 8-byte alignment of the chunk data is required: it's provided by the files saved by this version */
 
 /* Flags for sv_get_time_map(): */
 #define SV_TIME_MAP_SPEED	0
@@ -124,6 +128,15 @@ extern "C" {
    Parameters:
      config - string with additional configuration in the following format: "option_name=value|option_name=value";
               example: "buffer=1024|audiodriver=alsa|audiodevice=hw:0,0";
+              "quantum=N" - max internal render quantum in frames (16...4096; default = 20ms);
+              "seed=N" - fixed seed (N >= 0) for the random generators of the modules and patterns (reproducible output for the tests);
+              "sinc_taps=N" - (8, 16 or 32) windowed-sinc interpolation in the internal resamplers and in the Sampler (spline/sinc modes);
+                              high quality for the offline rendering; default = 0 (off);
+              "render_ahead=N" - render the sound in a separate thread N ms (10...2000) ahead of the audio device;
+                                 the device callback only copies the ready frames, so short CPU spikes (or long sv_lock_slot() sections)
+                                 don't cause dropouts; the events (sv_send_event(), etc.) will be delayed by N ms;
+                                 playback only: when the audio input is enabled, the sound is rendered in the device callback as usual;
+                                 ignored with SV_INIT_FLAG_USER_AUDIO_CALLBACK and SV_INIT_FLAG_ONE_THREAD;
               use NULL for automatic configuration;
      freq - desired sample rate (Hz); min - 44100;
             the actual rate may be different, if SV_INIT_FLAG_USER_AUDIO_CALLBACK is not set;
@@ -182,6 +195,20 @@ int sv_audio_callback( void* buf, int frames, int latency, uint32_t out_time ) S
 */
 int sv_audio_callback2( void* buf, int frames, int latency, uint32_t out_time, int in_type, int in_channels, void* in_buf ) SUNVOX_FN_ATTR;
 
+/*
+   sv_audio_callback_planar() - get the next piece of the slot output as planar float32 data (one buffer per channel);
+   only the specified slot is rendered: it goes directly to the user buffers without the slot mixer, interleaving and conversion;
+   for the hosts with one slot per output (channel strip); SV_INIT_FLAG_USER_AUDIO_CALLBACK only;
+   don't use it for the slot rendered by sv_audio_callback();
+   Parameters:
+     slot;
+     bufs - array of the channel buffers (frames * float each);
+     channels - number of buffers;
+     frames, latency, out_time - see sv_audio_callback();
+   Return values: 0 - silence; 1 - the output buffers are filled; negative - error.
+*/
+int sv_audio_callback_planar( int slot, float** bufs, int channels, int frames, int latency, uint32_t out_time ) SUNVOX_FN_ATTR;
+
 /*
    sv_open_slot(), sv_close_slot(), sv_lock_slot(), sv_unlock_slot() - 
    open/close/lock/unlock sound slot for SunVox.
@@ -228,6 +255,30 @@ int sv_load_from_memory( int slot, void* data, uint32_t data_size ) SUNVOX_FN_AT
 int sv_save( int slot, const char* name ) SUNVOX_FN_ATTR;
 void* sv_save_to_memory( int slot, size_t* size ) SUNVOX_FN_ATTR;
 
+/*
+   sv_render_stems() - render the next "frames" of the slot (single pass) with the outputs of the selected modules (stems);
+   sv_export_stems() - the same, but the stems are saved to the WAV files;
+   Parameters:
+     slot;
+     frames - number of frames to render; call it several times to render the long project in pieces;
+     mods - array of module numbers; use sv_get_module_inputs( slot, 0 ) to get the modules connected directly to the Output;
+            0 (Output) = master output;
+     mods_num - number of modules;
+     buf - master output buffer or NULL;
+     stem_bufs - buffers for the module outputs (one for each module);
+     filenames - WAV file names (one for each module);
+     the buffer format (sample type, channels) is the same as in sv_audio_callback();
+   stems are the module outputs as they are (before the link volumes and the Output volume);
+   a module without the audio outputs gives a silent stem;
+   the slot is locked for each piece of 1024 frames (not for the whole call);
+   the engine is rendered directly (not through the audio stream), so these functions should be used for the offline rendering only
+   (SV_INIT_FLAG_USER_AUDIO_CALLBACK), as a replacement for sv_audio_callback();
+   use sv_play_from_beginning() before the first call;
+   return value: 0 (success) or negative error code.
+*/
+int sv_render_stems( int slot, int frames, const int* mods, int mods_num, void* buf, void** stem_bufs ) SUNVOX_FN_ATTR;
+int sv_export_stems( int slot, int frames, const int* mods, int mods_num, const char* const* filenames ) SUNVOX_FN_ATTR;
+
 /*
    sv_play() - play from the current position;
    sv_play_from_beginning() - play from the beginning (line 0);
@@ -257,8 +308,17 @@ int sv_get_autostop( int slot ) SUNVOX_FN_ATTR;
 int sv_end_of_song( int slot ) SUNVOX_FN_ATTR;
 
 /*
+   sv_rewind() - jump to the specified line (position) of the project;
+   sv_rewind_chase() - enable (1) or disable (0) the controller chase for sv_rewind():
+     when enabled, the tempo and the global controller values (set by the pattern events before the new position)
+     are restored at the start of playback from the new position;
+     the controllers without such events (before the new position) get their initial values - the values at the moment
+     of the project loading or of the last sv_rewind_chase( slot, 1 ) call; the tempo gets the project tempo;
+     negative values are ignored;
+     return value: previous state;
 */
 int sv_rewind( int slot, int line_num ) SUNVOX_FN_ATTR;
+int sv_rewind_chase( int slot, int chase ) SUNVOX_FN_ATTR;
 
 /*
    sv_volume() - set volume from 0 (min) to 256 (max 100%);
@@ -267,6 +327,16 @@ int sv_rewind( int slot, int line_num ) SUNVOX_FN_ATTR;
 */
 int sv_volume( int slot, int vol ) SUNVOX_FN_ATTR;
 
+/*
+   sv_render_quantum() - set the internal render quantum of the slot (in frames);
+   the audio buffer is rendered in pieces of this size, so events and controller changes are quantized to its boundaries;
+   small values - lower modulation latency; large values - less overhead (offline rendering);
+   min 16; max - value of the "quantum" option from sv_init() config (default = 20ms);
+   zero or negative values are ignored;
+   return value: previous quantum;
+*/
+int sv_render_quantum( int slot, int frames ) SUNVOX_FN_ATTR;
+
 /*
    sv_set_event_t() - set the timestamp of events to be sent by sv_send_event()
    Parameters:
@@ -310,6 +380,8 @@ int sv_get_song_tpl( int slot ) SUNVOX_FN_ATTR;
    sv_get_song_length_frames(), sv_get_song_length_lines() -
    get the project length.
    Frame is one discrete of the sound. Sample rate 44100 Hz means, that you hear 44100 frames per second.
+   sv_get_song_length_frames() saturates at 0xFFFFFFFF;
+   use sv_line_to_frame( slot, sv_get_song_length_lines( slot ) ) to get the full 64-bit length.
 */
 uint32_t sv_get_song_length_frames( int slot ) SUNVOX_FN_ATTR;
 uint32_t sv_get_song_length_lines( int slot ) SUNVOX_FN_ATTR;
@@ -328,6 +400,17 @@ uint32_t sv_get_song_length_lines( int slot ) SUNVOX_FN_ATTR;
 */
 int sv_get_time_map( int slot, int start_line, int len, uint32_t* dest, int flags ) SUNVOX_FN_ATTR;
 
+/*
+   sv_line_to_frame() - get the frame counter at the beginning of the line (64-bit; project starts at line 0);
+   sv_frame_to_line() - get the line played at the specified frame;
+   sv_line_to_frame( slot, sv_get_song_length_lines( slot ) ) = song length in frames (64-bit);
+   the tempo map (from the current tempo, as sv_get_time_map()) is cached and updated only after the project
+   or the current tempo changes, so these calls are fast (O(log n));
+   Return value: frame/line number, or negative value in case of some error.
+*/
+int64_t sv_line_to_frame( int slot, int line ) SUNVOX_FN_ATTR;
+int sv_frame_to_line( int slot, int64_t frame ) SUNVOX_FN_ATTR;
+
 /*
    sv_new_module() - create a new module;
    sv_remove_module() - remove selected module;
@@ -360,6 +443,9 @@ int sv_load_module_from_memory( int slot, void* data, uint32_t data_size, int x,
      6 - Finetune: -128 ... 0 ... +127 (higher value = higher pitch);
      7 - Relative note: -128 ... 0 ... +127 (higher value = higher pitch);
      8 - Start position: 0 ... (sample_length - 1);
+     9 - Storage: 0 - PCM; 1 - packed (lossless compression in RAM; decoded block by block during playback);
+         the sample is packed only if it saves memory (including the decode cache of the module);
+         the packed state is not saved: the sample is saved as PCM, so set this parameter again after loading the project/module;
 */
 int sv_sampler_load( int slot, int mod_num, const char* file_name, int sample_slot ) SUNVOX_FN_ATTR;
 int sv_sampler_load_from_memory( int slot, int mod_num, void* data, uint32_t data_size, int sample_slot ) SUNVOX_FN_ATTR;
@@ -517,6 +603,30 @@ int sv_get_module_ctl_offset( int slot, int mod_num, int ctl_num ) SUNVOX_FN_ATT
 int sv_get_module_ctl_type( int slot, int mod_num, int ctl_num ) SUNVOX_FN_ATTR; /* 0 - normal (scaled); 1 - selector (enum); */
 int sv_get_module_ctl_group( int slot, int mod_num, int ctl_num ) SUNVOX_FN_ATTR;
 
+/*
+   sv_get_module_ctls(), sv_set_module_ctls() - get/set a range of module controllers (first_ctl ... first_ctl+num-1);
+   scaled - see sv_get_module_ctl_value();
+   sv_set_module_ctls() sends all the values to the engine as a single command,
+   so they will be applied together at the time set by sv_set_event_t() (or immediately);
+   the values are converted in the same way as in sv_set_module_ctl_value();
+   return value: number of controllers read (sv_get_module_ctls()); 0 (success) or negative error code.
+*/
+int sv_get_module_ctls( int slot, int mod_num, int first_ctl, int num, int* vals, int scaled ) SUNVOX_FN_ATTR;
+int sv_set_module_ctls( int slot, int mod_num, int first_ctl, int num, const int* vals, int scaled ) SUNVOX_FN_ATTR;
+
+/*
+   sv_ctls_snapshot() - save the controller values of all modules to memory;
+     return value: memory block allocated with malloc(); use free() to release it;
+   sv_ctls_restore() - restore the controller values from the snapshot;
+     all values will be applied atomically (in one audio buffer, one sample-accurate command)
+     at the time set by sv_set_event_t() (or immediately);
+     the snapshot must be from the same project (same module/controller numbers);
+     large projects: the data must fit into the engine's controller buffer (128 KB, ~20000 controllers);
+     return value: 0 (success) or negative error code.
+*/
+void* sv_ctls_snapshot( int slot, size_t* size ) SUNVOX_FN_ATTR;
+int sv_ctls_restore( int slot, const void* data, size_t size ) SUNVOX_FN_ATTR;
+
 /*
    sv_new_pattern() - create a new pattern;
    sv_remove_pattern() - remove selected pattern;
@@ -586,9 +696,28 @@ int sv_set_pattern_name( int slot, int pat_num, const char* name ) SUNVOX_FN_ATT
      sunvox_note* data = sv_get_pattern_data( slot, pat_num ); //get the buffer with all the pattern events (notes)
      sunvox_note* n = &data[ line_number * pat_tracks + track_number ];
      ... and then do someting with note n ...
+   Note: the player keeps a sparse event index of the pattern; it is rebuilt after this call and after sv_unlock_slot(),
+   so write to this buffer within the sv_lock_slot() / sv_unlock_slot() block (or call sv_get_pattern_data() again after writing);
+   use sv_set_pattern_event() if you only need to write a few events.
 */
 sunvox_note* sv_get_pattern_data( int slot, int pat_num ) SUNVOX_FN_ATTR;
 
+/*
+   sv_set_pattern_data() - replace the pattern events with the events from the data buffer (same layout as in sv_get_pattern_data());
+     data_size - buffer size in bytes (number of lines * sv_get_pattern_tracks() * sizeof(sunvox_note));
+   sv_set_pattern_region(), sv_get_pattern_region() - write/read a rectangular block of events:
+     track, line - top left corner of the block in the pattern;
+     tracks, lines - block size (it will be clipped by the pattern size);
+     data - buffer with the events: line 0 (tracks), line 1 (tracks), ...
+     data_tracks - number of events per line in the data buffer (0 = tracks);
+   These functions lock the slot by themselves (a single lock for the whole block),
+   so they are much faster than sv_set_pattern_event() for large blocks; the player will see all changes at once.
+   Return value: 0 (sucess) or negative error code.
+*/
+int sv_set_pattern_data( int slot, int pat_num, const sunvox_note* data, uint32_t data_size ) SUNVOX_FN_ATTR;
+int sv_set_pattern_region( int slot, int pat_num, int track, int line, int tracks, int lines, const sunvox_note* data, int data_tracks ) SUNVOX_FN_ATTR;
+int sv_get_pattern_region( int slot, int pat_num, int track, int line, int tracks, int lines, sunvox_note* data, int data_tracks ) SUNVOX_FN_ATTR;
+
 /*
    sv_set_pattern_event() - write the pattern event to the cell at the specified line and track
    nn,vv,mm,ccee,xxyy are the same as the fields of sunvox_note structure.
@@ -643,6 +772,7 @@ const char* sv_get_log( int size ) SUNVOX_FN_ATTR;
 
 typedef int (SUNVOX_FN_ATTR *tsv_audio_callback)( void* buf, int frames, int latency, uint32_t out_time );
 typedef int (SUNVOX_FN_ATTR *tsv_audio_callback2)( void* buf, int frames, int latency, uint32_t out_time, int in_type, int in_channels, void* in_buf );
+typedef int (SUNVOX_FN_ATTR *tsv_audio_callback_planar)( int slot, float** bufs, int channels, int frames, int latency, uint32_t out_time );
 typedef int (SUNVOX_FN_ATTR *tsv_open_slot)( int slot );
 typedef int (SUNVOX_FN_ATTR *tsv_close_slot)( int slot );
 typedef int (SUNVOX_FN_ATTR *tsv_lock_slot)( int slot );
@@ -655,6 +785,8 @@ typedef int (SUNVOX_FN_ATTR *tsv_load)( int slot, const char* name );
 typedef int (SUNVOX_FN_ATTR *tsv_load_from_memory)( int slot, void* data, uint32_t data_size );
 typedef int (SUNVOX_FN_ATTR *tsv_save)( int slot, const char* name );
 typedef void* (SUNVOX_FN_ATTR *tsv_save_to_memory)( int slot, size_t* size );
+typedef int (SUNVOX_FN_ATTR *tsv_render_stems)( int slot, int frames, const int* mods, int mods_num, void* buf, void** stem_bufs );
+typedef int (SUNVOX_FN_ATTR *tsv_export_stems)( int slot, int frames, const int* mods, int mods_num, const char* const* filenames );
 typedef int (SUNVOX_FN_ATTR *tsv_play)( int slot );
 typedef int (SUNVOX_FN_ATTR *tsv_play_from_beginning)( int slot );
 typedef int (SUNVOX_FN_ATTR *tsv_stop)( int slot );
@@ -665,7 +797,9 @@ typedef int (SUNVOX_FN_ATTR *tsv_set_autostop)( int slot, int autostop );
 typedef int (SUNVOX_FN_ATTR *tsv_get_autostop)( int slot );
 typedef int (SUNVOX_FN_ATTR *tsv_end_of_song)( int slot );
 typedef int (SUNVOX_FN_ATTR *tsv_rewind)( int slot, int t );
+typedef int (SUNVOX_FN_ATTR *tsv_rewind_chase)( int slot, int chase );
 typedef int (SUNVOX_FN_ATTR *tsv_volume)( int slot, int vol );
+typedef int (SUNVOX_FN_ATTR *tsv_render_quantum)( int slot, int frames );
 typedef int (SUNVOX_FN_ATTR *tsv_set_event_t)( int slot, int set, int t );
 typedef int (SUNVOX_FN_ATTR *tsv_send_event)( int slot, int track_num, int note, int vel, int module, int ctl, int ctl_val );
 typedef int (SUNVOX_FN_ATTR *tsv_get_current_line)( int slot );
@@ -679,6 +813,8 @@ typedef int (SUNVOX_FN_ATTR *tsv_get_song_tpl)( int slot );
 typedef uint32_t (SUNVOX_FN_ATTR *tsv_get_song_length_frames)( int slot );
 typedef uint32_t (SUNVOX_FN_ATTR *tsv_get_song_length_lines)( int slot );
 typedef int (SUNVOX_FN_ATTR *tsv_get_time_map)( int slot, int start_line, int len, uint32_t* dest, int flags );
+typedef int64_t (SUNVOX_FN_ATTR *tsv_line_to_frame)( int slot, int line );
+typedef int (SUNVOX_FN_ATTR *tsv_frame_to_line)( int slot, int64_t frame );
 typedef int (SUNVOX_FN_ATTR *tsv_new_module)( int slot, const char* type, const char* name, int x, int y, int z );
 typedef int (SUNVOX_FN_ATTR *tsv_remove_module)( int slot, int mod_num );
 typedef int (SUNVOX_FN_ATTR *tsv_connect_module)( int slot, int source, int destination );
@@ -718,6 +854,10 @@ typedef int (SUNVOX_FN_ATTR *tsv_get_module_ctl_max)( int slot, int mod_num, int
 typedef int (SUNVOX_FN_ATTR *tsv_get_module_ctl_offset)( int slot, int mod_num, int ctl_num );
 typedef int (SUNVOX_FN_ATTR *tsv_get_module_ctl_type)( int slot, int mod_num, int ctl_num );
 typedef int (SUNVOX_FN_ATTR *tsv_get_module_ctl_group)( int slot, int mod_num, int ctl_num );
+typedef int (SUNVOX_FN_ATTR *tsv_get_module_ctls)( int slot, int mod_num, int first_ctl, int num, int* vals, int scaled );
+typedef int (SUNVOX_FN_ATTR *tsv_set_module_ctls)( int slot, int mod_num, int first_ctl, int num, const int* vals, int scaled );
+typedef void* (SUNVOX_FN_ATTR *tsv_ctls_snapshot)( int slot, size_t* size );
+typedef int (SUNVOX_FN_ATTR *tsv_ctls_restore)( int slot, const void* data, size_t size );
 typedef int (SUNVOX_FN_ATTR *tsv_new_pattern)( int slot, int clone, int x, int y, int tracks, int lines, int icon_seed, const char* name );
 typedef int (SUNVOX_FN_ATTR *tsv_remove_pattern)( int slot, int pat_num );
 typedef int (SUNVOX_FN_ATTR *tsv_get_number_of_patterns)( int slot );
@@ -731,6 +871,9 @@ typedef int (SUNVOX_FN_ATTR *tsv_set_pattern_size)( int slot, int pat_num, int t
 typedef const char* (SUNVOX_FN_ATTR *tsv_get_pattern_name)( int slot, int pat_num );
 typedef int (SUNVOX_FN_ATTR *tsv_set_pattern_name)( int slot, int pat_num, const char* name );
 typedef sunvox_note* (SUNVOX_FN_ATTR *tsv_get_pattern_data)( int slot, int pat_num );
+typedef int (SUNVOX_FN_ATTR *tsv_set_pattern_data)( int slot, int pat_num, const sunvox_note* data, uint32_t data_size );
+typedef int (SUNVOX_FN_ATTR *tsv_set_pattern_region)( int slot, int pat_num, int track, int line, int tracks, int lines, const sunvox_note* data, int data_tracks );
+typedef int (SUNVOX_FN_ATTR *tsv_get_pattern_region)( int slot, int pat_num, int track, int line, int tracks, int lines, sunvox_note* data, int data_tracks );
 typedef int (SUNVOX_FN_ATTR *tsv_set_pattern_event)( int slot, int pat_num, int track, int line, int nn, int vv, int mm, int ccee, int xxyy );
 typedef int (SUNVOX_FN_ATTR *tsv_get_pattern_event)( int slot, int pat_num, int track, int line, int column );
 typedef int (SUNVOX_FN_ATTR *tsv_pattern_mute)( int slot, int pat_num, int mute );
@@ -748,6 +891,7 @@ typedef const char* (SUNVOX_FN_ATTR *tsv_get_log)( int size );
 
 SV_FN_DECL tsv_audio_callback sv_audio_callback SV_FN_DECL2;
 SV_FN_DECL tsv_audio_callback2 sv_audio_callback2 SV_FN_DECL2;
+SV_FN_DECL tsv_audio_callback_planar sv_audio_callback_planar SV_FN_DECL2;
 SV_FN_DECL tsv_open_slot sv_open_slot SV_FN_DECL2;
 SV_FN_DECL tsv_close_slot sv_close_slot SV_FN_DECL2;
 SV_FN_DECL tsv_lock_slot sv_lock_slot SV_FN_DECL2;
@@ -760,6 +904,8 @@ SV_FN_DECL tsv_load sv_load SV_FN_DECL2;
 SV_FN_DECL tsv_load_from_memory sv_load_from_memory SV_FN_DECL2;
 SV_FN_DECL tsv_save sv_save SV_FN_DECL2;
 SV_FN_DECL tsv_save_to_memory sv_save_to_memory SV_FN_DECL2;
+SV_FN_DECL tsv_render_stems sv_render_stems SV_FN_DECL2;
+SV_FN_DECL tsv_export_stems sv_export_stems SV_FN_DECL2;
 SV_FN_DECL tsv_play sv_play SV_FN_DECL2;
 SV_FN_DECL tsv_play_from_beginning sv_play_from_beginning SV_FN_DECL2;
 SV_FN_DECL tsv_stop sv_stop SV_FN_DECL2;
@@ -770,7 +916,9 @@ SV_FN_DECL tsv_set_autostop sv_set_autostop SV_FN_DECL2;
 SV_FN_DECL tsv_get_autostop sv_get_autostop SV_FN_DECL2;
 SV_FN_DECL tsv_end_of_song sv_end_of_song SV_FN_DECL2;
 SV_FN_DECL tsv_rewind sv_rewind SV_FN_DECL2;
+SV_FN_DECL tsv_rewind_chase sv_rewind_chase SV_FN_DECL2;
 SV_FN_DECL tsv_volume sv_volume SV_FN_DECL2;
+SV_FN_DECL tsv_render_quantum sv_render_quantum SV_FN_DECL2;
 SV_FN_DECL tsv_set_event_t sv_set_event_t SV_FN_DECL2;
 SV_FN_DECL tsv_send_event sv_send_event SV_FN_DECL2;
 SV_FN_DECL tsv_get_current_line sv_get_current_line SV_FN_DECL2;
@@ -784,6 +932,8 @@ SV_FN_DECL tsv_get_song_tpl sv_get_song_tpl SV_FN_DECL2;
 SV_FN_DECL tsv_get_song_length_frames sv_get_song_length_frames SV_FN_DECL2;
 SV_FN_DECL tsv_get_song_length_lines sv_get_song_length_lines SV_FN_DECL2;
 SV_FN_DECL tsv_get_time_map sv_get_time_map SV_FN_DECL2;
+SV_FN_DECL tsv_line_to_frame sv_line_to_frame SV_FN_DECL2;
+SV_FN_DECL tsv_frame_to_line sv_frame_to_line SV_FN_DECL2;
 SV_FN_DECL tsv_new_module sv_new_module SV_FN_DECL2;
 SV_FN_DECL tsv_remove_module sv_remove_module SV_FN_DECL2;
 SV_FN_DECL tsv_connect_module sv_connect_module SV_FN_DECL2;
@@ -823,6 +973,10 @@ SV_FN_DECL tsv_get_module_ctl_max sv_get_module_ctl_max SV_FN_DECL2;
 SV_FN_DECL tsv_get_module_ctl_offset sv_get_module_ctl_offset SV_FN_DECL2;
 SV_FN_DECL tsv_get_module_ctl_type sv_get_module_ctl_type SV_FN_DECL2;
 SV_FN_DECL tsv_get_module_ctl_group sv_get_module_ctl_group SV_FN_DECL2;
+SV_FN_DECL tsv_get_module_ctls sv_get_module_ctls SV_FN_DECL2;
+SV_FN_DECL tsv_set_module_ctls sv_set_module_ctls SV_FN_DECL2;
+SV_FN_DECL tsv_ctls_snapshot sv_ctls_snapshot SV_FN_DECL2;
+SV_FN_DECL tsv_ctls_restore sv_ctls_restore SV_FN_DECL2;
 SV_FN_DECL tsv_new_pattern sv_new_pattern SV_FN_DECL2;
 SV_FN_DECL tsv_remove_pattern sv_remove_pattern SV_FN_DECL2;
 SV_FN_DECL tsv_get_number_of_patterns sv_get_number_of_patterns SV_FN_DECL2;
@@ -836,6 +990,9 @@ SV_FN_DECL tsv_set_pattern_size sv_set_pattern_size SV_FN_DECL2;
 SV_FN_DECL tsv_get_pattern_name sv_get_pattern_name SV_FN_DECL2;
 SV_FN_DECL tsv_set_pattern_name sv_set_pattern_name SV_FN_DECL2;
 SV_FN_DECL tsv_get_pattern_data sv_get_pattern_data SV_FN_DECL2;
+SV_FN_DECL tsv_set_pattern_data sv_set_pattern_data SV_FN_DECL2;
+SV_FN_DECL tsv_set_pattern_region sv_set_pattern_region SV_FN_DECL2;
+SV_FN_DECL tsv_get_pattern_region sv_get_pattern_region SV_FN_DECL2;
 SV_FN_DECL tsv_set_pattern_event sv_set_pattern_event SV_FN_DECL2;
 SV_FN_DECL tsv_get_pattern_event sv_get_pattern_event SV_FN_DECL2;
 SV_FN_DECL tsv_pattern_mute sv_pattern_mute SV_FN_DECL2;
@@ -895,6 +1052,7 @@ int sv_load_dll2( LIBNAME_STR_TYPE filename )
     {
 	IMPORT( g_sv_dll, tsv_audio_callback, "sv_audio_callback", sv_audio_callback );
 	IMPORT( g_sv_dll, tsv_audio_callback2, "sv_audio_callback2", sv_audio_callback2 );
+	IMPORT( g_sv_dll, tsv_audio_callback_planar, "sv_audio_callback_planar", sv_audio_callback_planar );
 	IMPORT( g_sv_dll, tsv_open_slot, "sv_open_slot", sv_open_slot );
 	IMPORT( g_sv_dll, tsv_close_slot, "sv_close_slot", sv_close_slot );
 	IMPORT( g_sv_dll, tsv_lock_slot, "sv_lock_slot", sv_lock_slot );
@@ -907,6 +1065,8 @@ int sv_load_dll2( LIBNAME_STR_TYPE filename )
 	IMPORT( g_sv_dll, tsv_load_from_memory, "sv_load_from_memory", sv_load_from_memory );
 	IMPORT( g_sv_dll, tsv_save, "sv_save", sv_save );
 	IMPORT( g_sv_dll, tsv_save_to_memory, "sv_save_to_memory", sv_save_to_memory );
+	IMPORT( g_sv_dll, tsv_render_stems, "sv_render_stems", sv_render_stems );
+	IMPORT( g_sv_dll, tsv_export_stems, "sv_export_stems", sv_export_stems );
 	IMPORT( g_sv_dll, tsv_play, "sv_play", sv_play );
 	IMPORT( g_sv_dll, tsv_play_from_beginning, "sv_play_from_beginning", sv_play_from_beginning );
 	IMPORT( g_sv_dll, tsv_stop, "sv_stop", sv_stop );
@@ -917,7 +1077,9 @@ int sv_load_dll2( LIBNAME_STR_TYPE filename )
 	IMPORT( g_sv_dll, tsv_get_autostop, "sv_get_autostop", sv_get_autostop );
 	IMPORT( g_sv_dll, tsv_end_of_song, "sv_end_of_song", sv_end_of_song );
 	IMPORT( g_sv_dll, tsv_rewind, "sv_rewind", sv_rewind );
+	IMPORT( g_sv_dll, tsv_rewind_chase, "sv_rewind_chase", sv_rewind_chase );
 	IMPORT( g_sv_dll, tsv_volume, "sv_volume", sv_volume );
+	IMPORT( g_sv_dll, tsv_render_quantum, "sv_render_quantum", sv_render_quantum );
 	IMPORT( g_sv_dll, tsv_set_event_t, "sv_set_event_t", sv_set_event_t );
 	IMPORT( g_sv_dll, tsv_send_event, "sv_send_event", sv_send_event );
 	IMPORT( g_sv_dll, tsv_get_current_line, "sv_get_current_line", sv_get_current_line );
@@ -931,6 +1093,8 @@ int sv_load_dll2( LIBNAME_STR_TYPE filename )
 	IMPORT( g_sv_dll, tsv_get_song_length_frames, "sv_get_song_length_frames", sv_get_song_length_frames );
 	IMPORT( g_sv_dll, tsv_get_song_length_lines, "sv_get_song_length_lines", sv_get_song_length_lines );
 	IMPORT( g_sv_dll, tsv_get_time_map, "sv_get_time_map", sv_get_time_map );
+	IMPORT( g_sv_dll, tsv_line_to_frame, "sv_line_to_frame", sv_line_to_frame );
+	IMPORT( g_sv_dll, tsv_frame_to_line, "sv_frame_to_line", sv_frame_to_line );
 	IMPORT( g_sv_dll, tsv_new_module, "sv_new_module", sv_new_module );
 	IMPORT( g_sv_dll, tsv_remove_module, "sv_remove_module", sv_remove_module );
 	IMPORT( g_sv_dll, tsv_connect_module, "sv_connect_module", sv_connect_module );
@@ -970,6 +1134,10 @@ int sv_load_dll2( LIBNAME_STR_TYPE filename )
 	IMPORT( g_sv_dll, tsv_get_module_ctl_offset, "sv_get_module_ctl_offset", sv_get_module_ctl_offset );
 	IMPORT( g_sv_dll, tsv_get_module_ctl_type, "sv_get_module_ctl_type", sv_get_module_ctl_type );
 	IMPORT( g_sv_dll, tsv_get_module_ctl_group, "sv_get_module_ctl_group", sv_get_module_ctl_group );
+	IMPORT( g_sv_dll, tsv_get_module_ctls, "sv_get_module_ctls", sv_get_module_ctls );
+	IMPORT( g_sv_dll, tsv_set_module_ctls, "sv_set_module_ctls", sv_set_module_ctls );
+	IMPORT( g_sv_dll, tsv_ctls_snapshot, "sv_ctls_snapshot", sv_ctls_snapshot );
+	IMPORT( g_sv_dll, tsv_ctls_restore, "sv_ctls_restore", sv_ctls_restore );
 	IMPORT( g_sv_dll, tsv_new_pattern, "sv_new_pattern", sv_new_pattern );
 	IMPORT( g_sv_dll, tsv_remove_pattern, "sv_remove_pattern", sv_remove_pattern );
 	IMPORT( g_sv_dll, tsv_get_number_of_patterns, "sv_get_number_of_patterns", sv_get_number_of_patterns );
@@ -983,6 +1151,9 @@ int sv_load_dll2( LIBNAME_STR_TYPE filename )
 	IMPORT( g_sv_dll, tsv_get_pattern_name, "sv_get_pattern_name", sv_get_pattern_name );
 	IMPORT( g_sv_dll, tsv_set_pattern_name, "sv_set_pattern_name", sv_set_pattern_name );
 	IMPORT( g_sv_dll, tsv_get_pattern_data, "sv_get_pattern_data", sv_get_pattern_data );
+	IMPORT( g_sv_dll, tsv_set_pattern_data, "sv_set_pattern_data", sv_set_pattern_data );
+	IMPORT( g_sv_dll, tsv_set_pattern_region, "sv_set_pattern_region", sv_set_pattern_region );
+	IMPORT( g_sv_dll, tsv_get_pattern_region, "sv_get_pattern_region", sv_get_pattern_region );
 	IMPORT( g_sv_dll, tsv_set_pattern_event, "sv_set_pattern_event", sv_set_pattern_event );
 	IMPORT( g_sv_dll, tsv_get_pattern_event, "sv_get_pattern_event", sv_get_pattern_event );
 	IMPORT( g_sv_dll, tsv_pattern_mute, "sv_pattern_mute", sv_pattern_mute );
@@ -51,6 +51,7 @@ static bool g_sv_initialized;
 #define SV_INIT_FLAG_AUDIO_INT16 		( 1 << 2 )
 #define SV_INIT_FLAG_AUDIO_FLOAT32 		( 1 << 3 )
 #define SV_INIT_FLAG_ONE_THREAD 		( 1 << 4 )
+#define SV_INIT_FLAG_MAP_FILES 		( 1 << 5 )
 
 #define SV_TIME_MAP_SPEED       0
 #define SV_TIME_MAP_FRAMECNT    1
@@ -360,6 +361,7 @@ SUNVOX_EXPORT int sv_open_slot( int slot )
     }
     uint flags = 0;
     if( g_sv_flags & SV_INIT_FLAG_ONE_THREAD ) flags |= SUNVOX_FLAG_ONE_THREAD;
+    if( g_sv_flags & SV_INIT_FLAG_MAP_FILES ) flags |= SUNVOX_FLAG_MAP_FILES;
     g_sv[ slot ] = SMEM_ALLOC2( sunvox_engine, 1 );
     g_sv_locked[ slot ] = 0;
     sunvox_engine_init( 
@@ -410,7 +412,18 @@ SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_lock_1s
 SUNVOX_EXPORT int sv_unlock_slot( int slot )
 {
     if( check_slot( slot ) ) return -1;
-    SUNVOX_SOUND_STREAM_CONTROL( g_sv[ slot ], SUNVOX_STREAM_UNLOCK );
+    sunvox_engine* s = g_sv[ slot ];
+    for( int p = 0; p < s->pats_num; p++ )
+    {
+	//Pattern buffers obtained with sv_get_pattern_data() - rebuild the event index:
+	sunvox_pattern* pat = s->pats[ p ];
+	if( pat && pat->evt_index_user )
+	{
+	    SUNVOX_PATTERN_CHANGED( pat, s );
+	    pat->evt_index_user = false;
+	}
+    }
+    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_UNLOCK );
     return 0;
 }
 #ifdef OS_ANDROID
@@ -521,6 +534,211 @@ SUNVOX_EXPORT JNIEXPORT jbyteArray JNICALL Java_nightradio_sunvoxlib_SunVoxLib_s
 }
 #endif
 
+SUNVOX_EXPORT int sv_audio_callback_planar( int slot, float** bufs, int channels, int frames, int latency, stime_ticks_t out_time )
+{
+    if( check_slot( slot ) ) return -1;
+    if( !bufs || channels <= 0 || frames <= 0 ) return -1;
+    if( !( g_sound->flags & SUNDOG_SOUND_FLAG_USER_CONTROLLED ) ) return -1;
+    for( int ch = 0; ch < channels; ch++ ) if( !bufs[ ch ] ) return -1;
+    sunvox_engine* s = g_sv[ slot ];
+    bool lock = !( g_sv_flags & SV_INIT_FLAG_ONE_THREAD );
+    if( lock ) sundog_sound_lock( g_sound );
+    int rv = 0;
+    if( !sundog_sound_is_slot_suspended( g_sound, slot ) )
+    {
+	sunvox_render_data rdata;
+	SMEM_CLEAR_STRUCT( rdata );
+	rdata.buffer_type = sound_buffer_float32;
+	rdata.planar_buffer = bufs;
+	rdata.frames = frames;
+	rdata.channels = channels;
+	rdata.out_latency = latency;
+	rdata.out_latency2 = latency;
+	rdata.out_time = out_time;
+	if( sunvox_render_piece_of_sound( &rdata, s ) )
+	{
+	    rv = 2;
+	    if( !rdata.silence ) rv = 1;
+	}
+    }
+    if( lock ) sundog_sound_unlock( g_sound );
+    if( rv == 0 )
+	for( int ch = 0; ch < channels; ch++ ) smem_clear( bufs[ ch ], frames * sizeof( float ) );
+    return rv == 1;
+}
+#ifdef OS_ANDROID
+SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_audio_1callback_1planar( JNIEnv* je, jclass jc, jint slot, jfloatArray buf_l, jfloatArray buf_r, jint frames, jint latency, jint out_time )
+{
+    int rv;
+    float* bufs[ 2 ];
+    bufs[ 0 ] = je->GetFloatArrayElements( buf_l, NULL );
+    bufs[ 1 ] = je->GetFloatArrayElements( buf_r, NULL );
+    rv = sv_audio_callback_planar( slot, bufs, 2, frames, latency, out_time );
+    je->ReleaseFloatArrayElements( buf_l, bufs[ 0 ], 0 );
+    je->ReleaseFloatArrayElements( buf_r, bufs[ 1 ], 0 );
+    return rv;
+}
+#endif
+
+//Single pass render with the module outputs (stems) in separate buffers and/or WAV files:
+#define SV_STEMS_CHUNK 1024
+static int sv_render_stems_to( int slot, int frames, const int* mods, int mods_num, void* buf, void** stem_bufs, sfs_sound_encoder_data* encs )
+{
+    if( frames <= 0 || mods_num < 0 || ( mods_num && !mods ) ) return -1;
+    sunvox_engine* s = g_sv[ slot ];
+    sound_buffer_type type = g_sound->out_type;
+    int channels = g_sound->out_channels;
+    size_t frame_size = g_sample_size[ type ] * channels;
+    int rv = -1;
+    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_LOCK );
+    int tab_size = s->net->mods_num;
+    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_UNLOCK );
+    void** mod_bufs = SMEM_ZALLOC2( void*, tab_size );
+    sfs_sound_encoder_data** mod_encs = NULL;
+    if( encs ) mod_encs = SMEM_ZALLOC2( sfs_sound_encoder_data*, tab_size );
+    int8_t* tmp = SMEM_ZALLOC2( int8_t, SV_STEMS_CHUNK * frame_size * ( 1 + mods_num ) ); //master + stems (if there are no user buffers)
+    while( mod_bufs && tmp && ( mod_encs || !encs ) )
+    {
+	bool err = false;
+	for( int i = 0; i < mods_num; i++ )
+	{
+	    int m = mods[ i ];
+	    if( (unsigned)m >= (unsigned)tab_size || ( m > 0 && mod_bufs[ m ] ) ) { err = true; break; } //wrong or duplicate module
+	    if( m > 0 ) mod_bufs[ m ] = tmp; //not NULL = selected
+	}
+	if( err ) break;
+	for( int ptr = 0; ptr < frames; )
+	{
+	    int size = frames - ptr;
+	    if( size > SV_STEMS_CHUNK ) size = SV_STEMS_CHUNK;
+	    void* master = tmp;
+	    if( buf ) master = (int8_t*)buf + ptr * frame_size;
+	    for( int i = 0; i < mods_num; i++ )
+	    {
+		int m = mods[ i ];
+		if( encs ) mod_encs[ m ] = &encs[ i ];
+		if( m == 0 ) continue;
+		if( stem_bufs )
+		    mod_bufs[ m ] = (int8_t*)stem_bufs[ i ] + ptr * frame_size;
+		else
+		    mod_bufs[ m ] = tmp + ( i + 1 ) * SV_STEMS_CHUNK * frame_size;
+	    }
+	    sunvox_render_data rdata;
+	    SMEM_CLEAR_STRUCT( rdata );
+	    rdata.buffer_type = type;
+	    rdata.buffer = master;
+	    rdata.frames = size;
+	    rdata.channels = channels;
+	    rdata.out_time = stime_ticks();
+	    rdata.out_file_encoders = mod_encs;
+	    rdata.out_mod_buffers = mod_bufs;
+	    rdata.out_mods_num = tab_size;
+	    //Lock per chunk (not for the whole render), so the other slots and the API calls are not blocked:
+	    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_LOCK );
+	    sunvox_render_piece_of_sound( &rdata, s );
+	    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_UNLOCK );
+	    if( stem_bufs )
+	    {
+		//Output (master) stems:
+		for( int i = 0; i < mods_num; i++ )
+		    if( mods[ i ] == 0 ) smem_copy( (int8_t*)stem_bufs[ i ] + ptr * frame_size, master, size * frame_size );
+	    }
+	    ptr += size;
+	}
+	rv = 0;
+	break;
+    }
+    smem_free( mod_bufs );
+    smem_free( mod_encs );
+    smem_free( tmp );
+    return rv;
+}
+
+SUNVOX_EXPORT int sv_render_stems( int slot, int frames, const int* mods, int mods_num, void* buf, void** stem_bufs )
+{
+    if( check_slot( slot ) ) return -1;
+    if( !stem_bufs ) return -1;
+    for( int i = 0; i < mods_num; i++ ) if( !stem_bufs[ i ] ) return -1;
+    return sv_render_stems_to( slot, frames, mods, mods_num, buf, stem_bufs, NULL );
+}
+#ifdef OS_ANDROID
+//stems: mods_num buffers (frames * frame size each) one after the other:
+SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_render_1stems( JNIEnv* je, jclass jc, jint slot, jint frames, jintArray mods, jbyteArray buf, jbyteArray stems )
+{
+    int rv = -1;
+    int mods_num = (int)je->GetArrayLength( mods );
+    jint* c_mods = je->GetIntArrayElements( mods, NULL );
+    jbyte* c_buf = NULL;
+    if( buf ) c_buf = je->GetByteArrayElements( buf, NULL );
+    jbyte* c_stems = je->GetByteArrayElements( stems, NULL );
+    void** stem_bufs = SMEM_ALLOC2( void*, mods_num + 1 );
+    if( stem_bufs && mods_num > 0 )
+    {
+	size_t stem_size = (size_t)je->GetArrayLength( stems ) / mods_num;
+	for( int i = 0; i < mods_num; i++ ) stem_bufs[ i ] = c_stems + i * stem_size;
+	rv = sv_render_stems( slot, frames, (const int*)c_mods, mods_num, c_buf, stem_bufs );
+    }
+    smem_free( stem_bufs );
+    je->ReleaseByteArrayElements( stems, c_stems, 0 );
+    if( buf ) je->ReleaseByteArrayElements( buf, c_buf, 0 );
+    je->ReleaseIntArrayElements( mods, c_mods, JNI_ABORT );
+    return rv;
+}
+#endif
+
+SUNVOX_EXPORT int sv_export_stems( int slot, int frames, const int* mods, int mods_num, const char* const* filenames )
+{
+    if( check_slot( slot ) ) return -1;
+    if( !filenames || mods_num <= 0 ) return -1;
+    sfs_sample_format fmt = SFMT_INT16;
+    if( g_sound->out_type == sound_buffer_float32 ) fmt = SFMT_FLOAT32;
+    sfs_sound_encoder_data* encs = SMEM_ZALLOC2( sfs_sound_encoder_data, mods_num );
+    if( !encs ) return -1;
+    int rv = 0;
+    for( int i = 0; i < mods_num; i++ )
+    {
+	if( !filenames[ i ] ||
+	    sfs_sound_encoder_init( 0, filenames[ i ], 0, SFS_FILE_FMT_WAVE, fmt, g_sound->freq, g_sound->out_channels, frames, 0, &encs[ i ] ) )
+	{
+	    slog( "sv_export_stems(): can't open %s\n", filenames[ i ] ? filenames[ i ] : "NULL" );
+	    rv = -1;
+	    break;
+	}
+    }
+    if( rv == 0 )
+	rv = sv_render_stems_to( slot, frames, mods, mods_num, NULL, NULL, encs );
+    for( int i = 0; i < mods_num; i++ ) sfs_sound_encoder_deinit( &encs[ i ] );
+    smem_free( encs );
+    return rv;
+}
+#ifdef OS_ANDROID
+SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_export_1stems( JNIEnv* je, jclass jc, jint slot, jint frames, jintArray mods, jobjectArray filenames )
+{
+    int rv = -1;
+    int mods_num = (int)je->GetArrayLength( mods );
+    if( (int)je->GetArrayLength( filenames ) < mods_num ) return -1;
+    jint* c_mods = je->GetIntArrayElements( mods, NULL );
+    const char** c_names = SMEM_ZALLOC2( const char*, mods_num + 1 );
+    if( c_names )
+    {
+	for( int i = 0; i < mods_num; i++ )
+	{
+	    jstring name = (jstring)je->GetObjectArrayElement( filenames, i );
+	    if( name ) c_names[ i ] = je->GetStringUTFChars( name, 0 );
+	}
+	rv = sv_export_stems( slot, frames, (const int*)c_mods, mods_num, c_names );
+	for( int i = 0; i < mods_num; i++ )
+	{
+	    jstring name = (jstring)je->GetObjectArrayElement( filenames, i );
+	    if( name ) je->ReleaseStringUTFChars( name, c_names[ i ] );
+	}
+	smem_free( c_names );
+    }
+    je->ReleaseIntArrayElements( mods, c_mods, JNI_ABORT );
+    return rv;
+}
+#endif
+
 SUNVOX_EXPORT int sv_play( int slot )
 {
     if( check_slot( slot ) ) return -1;
@@ -652,6 +870,30 @@ SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_rewind(
 }
 #endif
 
+SUNVOX_EXPORT int sv_rewind_chase( int slot, int chase )
+{
+    if( check_slot( slot ) ) return -1;
+    sunvox_engine* s = g_sv[ slot ];
+    int prev = s->chase;
+    if( chase >= 0 )
+    {
+	SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_LOCK );
+	s->chase = chase != 0;
+	if( s->chase )
+	    sunvox_chase_save_base( s ); //initial state for the chase to the lines before the first event
+	else
+	    sunvox_chase_cancel( s );
+	SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_UNLOCK );
+    }
+    return prev;
+}
+#ifdef OS_ANDROID
+SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_rewind_1chase( JNIEnv* je, jclass jc, jint slot, jint chase )
+{
+    return sv_rewind_chase( slot, chase );
+}
+#endif
+
 SUNVOX_EXPORT int sv_volume( int slot, int vol )
 {
     if( check_slot( slot ) ) return -1;
@@ -666,6 +908,21 @@ SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_volume(
 }
 #endif
 
+SUNVOX_EXPORT int sv_render_quantum( int slot, int frames )
+{
+    if( check_slot( slot ) ) return -1;
+    psynth_net* net = g_sv[ slot ]->net;
+    int prev_quantum = net->quantum;
+    if( frames > 0 ) psynth_set_quantum( frames, net );
+    return prev_quantum;
+}
+#ifdef OS_ANDROID
+SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_render_1quantum( JNIEnv* je, jclass jc, jint slot, jint frames )
+{
+    return sv_render_quantum( slot, frames );
+}
+#endif
+
 SUNVOX_EXPORT int sv_set_event_t( int slot, int set, int t )
 {
     if( check_slot( slot ) ) return -1;
@@ -812,7 +1069,9 @@ SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_get_1so
 SUNVOX_EXPORT uint sv_get_song_length_frames( int slot )
 {
     if( check_slot( slot ) ) return 0;
-    return sunvox_get_proj_frames( 0, 0, g_sv[ slot ] );
+    uint64_t len = sunvox_get_proj_frames( 0, 0, g_sv[ slot ] );
+    if( len > 0xFFFFFFFF ) len = 0xFFFFFFFF; //use sv_line_to_frame() for the 64-bit length
+    return (uint)len;
 }
 #ifdef OS_ANDROID
 SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_get_1song_1length_1frames( JNIEnv* je, jclass jc, jint slot )
@@ -863,6 +1122,30 @@ SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_get_1ti
 }
 #endif
 
+SUNVOX_EXPORT int64_t sv_line_to_frame( int slot, int line )
+{
+    if( check_slot( slot ) ) return -1;
+    return sunvox_line_to_frame( line, g_sv[ slot ] );
+}
+#ifdef OS_ANDROID
+SUNVOX_EXPORT JNIEXPORT jlong JNICALL Java_nightradio_sunvoxlib_SunVoxLib_line_1to_1frame( JNIEnv* je, jclass jc, jint slot, jint line )
+{
+    return sv_line_to_frame( slot, line );
+}
+#endif
+
+SUNVOX_EXPORT int sv_frame_to_line( int slot, int64_t frame )
+{
+    if( check_slot( slot ) ) return -1;
+    return sunvox_frame_to_line( frame, g_sv[ slot ] );
+}
+#ifdef OS_ANDROID
+SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_frame_1to_1line( JNIEnv* je, jclass jc, jint slot, jlong frame )
+{
+    return sv_frame_to_line( slot, frame );
+}
+#endif
+
 SUNVOX_EXPORT int sv_new_module( int slot, const char* type, const char* name, int x, int y, int z )
 {
     if( check_slot( slot ) ) return -1;
@@ -1641,6 +1924,167 @@ SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_get_1mo
 }
 #endif
 
+static stime_ticks_t sv_get_evt_t( int slot )
+{
+    if( g_sv_evt_t_set[ slot ] )
+	return g_sv_evt_t[ slot ];
+    return stime_ticks();
+}
+
+SUNVOX_EXPORT int sv_get_module_ctls( int slot, int mod_num, int first_ctl, int num, int* vals, int scaled )
+{
+    if( check_slot( slot ) ) return -1;
+    if( !vals || first_ctl < 0 || num < 0 ) return -1;
+    sunvox_engine* s = g_sv[ slot ];
+    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_LOCK );
+    int rv = -1;
+    psynth_module* m = psynth_get_module( mod_num, s->net );
+    if( m )
+    {
+	rv = 0;
+	for( ; rv < num && first_ctl + rv < (int)m->ctls_num; rv++ )
+	    vals[ rv ] = svh_get_module_ctl_value( s, mod_num, first_ctl + rv, scaled );
+    }
+    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_UNLOCK );
+    return rv;
+}
+#ifdef OS_ANDROID
+SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_get_1module_1ctls( JNIEnv* je, jclass jc, jint slot, jint mod_num, jint first_ctl, jintArray vals, jint scaled )
+{
+    int rv;
+    int num = (int)je->GetArrayLength( vals );
+    jint* c_vals = je->GetIntArrayElements( vals, NULL );
+    rv = sv_get_module_ctls( slot, mod_num, first_ctl, num, (int*)c_vals, scaled );
+    je->ReleaseIntArrayElements( vals, c_vals, 0 );
+    return rv;
+}
+#endif
+
+SUNVOX_EXPORT int sv_set_module_ctls( int slot, int mod_num, int first_ctl, int num, const int* vals, int scaled )
+{
+    if( check_slot( slot ) ) return -1;
+    if( !vals || first_ctl < 0 || num <= 0 ) return -1;
+    sunvox_engine* s = g_sv[ slot ];
+    int rv = -1;
+    sunvox_ctl_value* cv = SMEM_ALLOC2( sunvox_ctl_value, num );
+    if( !cv ) return -1;
+    uint cnt = 0;
+    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_LOCK );
+    psynth_module* m = psynth_get_module( mod_num, s->net );
+    if( m )
+    {
+	for( int i = 0; i < num && first_ctl + i < (int)m->ctls_num; i++ )
+	{
+	    psynth_ctl* c = &m->ctls[ first_ctl + i ];
+	    cv[ cnt ].mod = mod_num;
+	    cv[ cnt ].ctl = first_ctl + i;
+	    cv[ cnt ].val = svh_ctl_value_to_xxyy( c, vals[ i ], scaled, false ); //same conversion as in sv_set_module_ctl_value()
+	    cnt++;
+	}
+	rv = 0;
+    }
+    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_UNLOCK );
+    if( rv == 0 && cnt )
+	rv = sunvox_send_user_ctls( sv_get_evt_t( slot ), cv, cnt, s );
+    smem_free( cv );
+    return rv;
+}
+#ifdef OS_ANDROID
+SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_set_1module_1ctls( JNIEnv* je, jclass jc, jint slot, jint mod_num, jint first_ctl, jintArray vals, jint scaled )
+{
+    int rv;
+    int num = (int)je->GetArrayLength( vals );
+    jint* c_vals = je->GetIntArrayElements( vals, NULL );
+    rv = sv_set_module_ctls( slot, mod_num, first_ctl, num, (const int*)c_vals, scaled );
+    je->ReleaseIntArrayElements( vals, c_vals, JNI_ABORT );
+    return rv;
+}
+#endif
+
+//Controller snapshot: "SVCS" + uint32_t num + sunvox_ctl_value * num
+#define SV_CTLS_SNAPSHOT_HDR ( 4 + sizeof( uint32_t ) )
+
+SUNVOX_EXPORT void* sv_ctls_snapshot( int slot, size_t* size )
+{
+    if( size ) *size = 0;
+    if( check_slot( slot ) ) return NULL;
+    sunvox_engine* s = g_sv[ slot ];
+    psynth_net* net = s->net;
+    void* out = NULL;
+    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_LOCK );
+    uint32_t num = 0;
+    for( uint i = 0; i < net->mods_num; i++ )
+    {
+	psynth_module* m = &net->mods[ i ];
+	if( m->flags & PSYNTH_FLAG_EXISTS ) num += m->ctls_num;
+    }
+    size_t out_size = SV_CTLS_SNAPSHOT_HDR + num * sizeof( sunvox_ctl_value );
+    out = malloc( out_size );
+    if( out )
+    {
+	uint8_t* p = (uint8_t*)out;
+	smem_copy( p, "SVCS", 4 );
+	smem_copy( p + 4, &num, sizeof( num ) );
+	sunvox_ctl_value* cv = (sunvox_ctl_value*)( p + SV_CTLS_SNAPSHOT_HDR );
+	for( uint i = 0; i < net->mods_num; i++ )
+	{
+	    psynth_module* m = &net->mods[ i ];
+	    if( !( m->flags & PSYNTH_FLAG_EXISTS ) ) continue;
+	    for( uint c = 0; c < m->ctls_num; c++ )
+	    {
+		cv->mod = i;
+		cv->ctl = c;
+		cv->val = svh_ctl_value_to_xxyy( &m->ctls[ c ], m->ctls[ c ].val[ 0 ], 0, true ); //exact: the restored value must be the same
+		cv++;
+	    }
+	}
+	if( size ) *size = out_size;
+    }
+    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_UNLOCK );
+    return out;
+}
+#ifdef OS_ANDROID
+SUNVOX_EXPORT JNIEXPORT jbyteArray JNICALL Java_nightradio_sunvoxlib_SunVoxLib_ctls_1snapshot( JNIEnv* je, jclass jc, jint slot )
+{
+    size_t size;
+    void* out = sv_ctls_snapshot( slot, &size );
+    if( !out ) return NULL;
+    jbyteArray rv = je->NewByteArray( size );
+    je->SetByteArrayRegion( rv, 0, size, (const jbyte*)out );
+    free( out );
+    return rv;
+}
+#endif
+
+SUNVOX_EXPORT int sv_ctls_restore( int slot, const void* data, size_t size )
+{
+    if( check_slot( slot ) ) return -1;
+    if( !data || size < SV_CTLS_SNAPSHOT_HDR ) return -1;
+    const uint8_t* p = (const uint8_t*)data;
+    if( smem_cmp( (const char*)p, "SVCS", 4 ) ) return -1;
+    uint32_t num;
+    smem_copy( &num, p + 4, sizeof( num ) );
+    if( num > ( size - SV_CTLS_SNAPSHOT_HDR ) / sizeof( sunvox_ctl_value ) ) return -1;
+    if( num == 0 ) return 0;
+    sunvox_ctl_value* cv = SMEM_ALLOC2( sunvox_ctl_value, num ); //aligned copy
+    if( !cv ) return -1;
+    smem_copy( cv, p + SV_CTLS_SNAPSHOT_HDR, num * sizeof( sunvox_ctl_value ) );
+    int rv = sunvox_send_user_ctls( sv_get_evt_t( slot ), cv, num, g_sv[ slot ] );
+    smem_free( cv );
+    return rv;
+}
+#ifdef OS_ANDROID
+SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_ctls_1restore( JNIEnv* je, jclass jc, jint slot, jbyteArray data )
+{
+    jint rv = 0;
+    size_t data_size = (size_t)je->GetArrayLength( data );
+    jbyte* c_data = je->GetByteArrayElements( data, NULL );
+    rv = sv_ctls_restore( slot, c_data, data_size );
+    je->ReleaseByteArrayElements( data, c_data, JNI_ABORT );
+    return rv;
+}
+#endif
+
 SUNVOX_EXPORT int sv_new_pattern( int slot, int clone, int x, int y, int tracks, int lines, int icon_seed, const char* name )
 {
     if( check_slot( slot ) ) return -1;
@@ -1699,6 +2143,7 @@ SUNVOX_EXPORT int sv_find_pattern( int slot, const char* name )
 {
     if( check_slot( slot ) ) return -1;
     if( !name ) return -1;
+    sunvox_update_pattern_names_index( g_sv[ slot ] );
     return sunvox_get_pattern_num_by_name( name, g_sv[ slot ] );
 }
 #ifdef OS_ANDROID
@@ -1752,6 +2197,7 @@ SUNVOX_EXPORT int sv_set_pattern_xy( int slot, int pat_num, int x, int y )
     if( !is_sv_locked( slot, __FUNCTION__ ) ) return -1;
     s->pats_info[ pat_num ].x = x;
     s->pats_info[ pat_num ].y = y;
+    sunvox_reserve_pattern_state( pat_num, s );
     return 0;
 }
 #ifdef OS_ANDROID
@@ -1846,13 +2292,116 @@ SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_set_1pa
 }
 #endif
 
+//Copy a block of notes between the pattern and the user buffer (with a single lock);
+//dir: 0 - read (pattern -> data); 1 - write (data -> pattern);
+static int sv_pattern_region( int slot, int pat_num, int track, int line, int tracks, int lines, sunvox_note* data, int data_tracks, int dir )
+{
+    if( check_slot( slot ) ) return -1;
+    if( !data ) return -1;
+    sunvox_engine* s = g_sv[ slot ];
+    if( data_tracks <= 0 ) data_tracks = tracks;
+    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_LOCK );
+    int rv = 0;
+    while( 1 )
+    {
+	sunvox_pattern* pat = sunvox_get_pattern( pat_num, s );
+	if( !pat ) { rv = -2; break; }
+	if( (unsigned)track >= (unsigned)pat->channels ) { rv = -3; break; }
+	if( (unsigned)line >= (unsigned)pat->lines ) { rv = -4; break; }
+	if( track + tracks > pat->channels ) tracks = pat->channels - track;
+	if( line + lines > pat->lines ) lines = pat->lines - line;
+	if( tracks <= 0 || lines <= 0 ) break;
+	for( int y = 0; y < lines; y++ )
+	{
+	    sunvox_note* p = &pat->data[ ( line + y ) * pat->data_xsize + track ];
+	    sunvox_note* d = &data[ y * data_tracks ];
+	    if( dir )
+		smem_copy( p, d, tracks * sizeof( sunvox_note ) );
+	    else
+		smem_copy( d, p, tracks * sizeof( sunvox_note ) );
+	}
+	if( dir ) SUNVOX_PATTERN_CHANGED( pat, s ); //the event index and the time map will be updated once (on demand)
+	break;
+    }
+    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_UNLOCK );
+    return rv;
+}
+
+SUNVOX_EXPORT int sv_set_pattern_region( int slot, int pat_num, int track, int line, int tracks, int lines, const sunvox_note* data, int data_tracks )
+{
+    return sv_pattern_region( slot, pat_num, track, line, tracks, lines, (sunvox_note*)data, data_tracks, 1 );
+}
+SUNVOX_EXPORT int sv_get_pattern_region( int slot, int pat_num, int track, int line, int tracks, int lines, sunvox_note* data, int data_tracks )
+{
+    return sv_pattern_region( slot, pat_num, track, line, tracks, lines, data, data_tracks, 0 );
+}
+#ifdef OS_ANDROID
+SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_set_1pattern_1region( JNIEnv* je, jclass jc, jint slot, jint pat_num, jint track, jint line, jint tracks, jint lines, jbyteArray data, jint data_tracks )
+{
+    if( tracks <= 0 || lines <= 0 ) return -1;
+    if( data_tracks <= 0 ) data_tracks = tracks;
+    size_t data_size = je->GetArrayLength( data );
+    if( data_size < ( (size_t)( lines - 1 ) * data_tracks + tracks ) * sizeof( sunvox_note ) ) return -1;
+    jint rv = -1;
+    jbyte* c_data = je->GetByteArrayElements( data, NULL );
+    if( c_data )
+    {
+	rv = sv_set_pattern_region( slot, pat_num, track, line, tracks, lines, (const sunvox_note*)c_data, data_tracks );
+	je->ReleaseByteArrayElements( data, c_data, JNI_ABORT );
+    }
+    return rv;
+}
+SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_get_1pattern_1region( JNIEnv* je, jclass jc, jint slot, jint pat_num, jint track, jint line, jint tracks, jint lines, jbyteArray data, jint data_tracks )
+{
+    if( tracks <= 0 || lines <= 0 ) return -1;
+    if( data_tracks <= 0 ) data_tracks = tracks;
+    size_t data_size = je->GetArrayLength( data );
+    if( data_size < ( (size_t)( lines - 1 ) * data_tracks + tracks ) * sizeof( sunvox_note ) ) return -1;
+    jint rv = -1;
+    jbyte* c_data = je->GetByteArrayElements( data, NULL );
+    if( c_data )
+    {
+	rv = sv_get_pattern_region( slot, pat_num, track, line, tracks, lines, (sunvox_note*)c_data, data_tracks );
+	je->ReleaseByteArrayElements( data, c_data, 0 );
+    }
+    return rv;
+}
+#endif
+
+SUNVOX_EXPORT int sv_set_pattern_data( int slot, int pat_num, const sunvox_note* data, uint32_t data_size )
+{
+    if( check_slot( slot ) ) return -1;
+    sunvox_engine* s = g_sv[ slot ];
+    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_LOCK );
+    int rv = -2;
+    sunvox_pattern* pat = sunvox_get_pattern( pat_num, s );
+    if( pat )
+    {
+	//Same layout as in sv_get_pattern_data(): data_xsize events per line
+	int lines = data_size / ( pat->data_xsize * sizeof( sunvox_note ) );
+	if( lines > pat->lines ) lines = pat->lines;
+	rv = -1;
+	if( data && lines > 0 )
+	{
+	    smem_copy( pat->data, data, lines * pat->data_xsize * sizeof( sunvox_note ) );
+	    SUNVOX_PATTERN_CHANGED( pat, s );
+	    rv = 0;
+	}
+    }
+    SUNVOX_SOUND_STREAM_CONTROL( s, SUNVOX_STREAM_UNLOCK );
+    return rv;
+}
+
 SUNVOX_EXPORT sunvox_note* sv_get_pattern_data( int slot, int pat_num )
 {
     if( check_slot( slot ) ) return NULL;
     sunvox_engine* s = g_sv[ slot ];
     if( (unsigned)pat_num >= (unsigned)s->pats_num ) return NULL;
     if( !s->pats[ pat_num ] ) return NULL;
-    return s->pats[ pat_num ]->data;
+    sunvox_pattern* pat = s->pats[ pat_num ];
+    SUNVOX_PATTERN_CHANGED( pat, s ); //the buffer may have been changed since the previous call
+    pat->evt_index_user = true; //and it may be changed until sv_unlock_slot()
+    return pat->data;
 }
 #ifdef OS_ANDROID
 SUNVOX_EXPORT JNIEXPORT jbyteArray JNICALL Java_nightradio_sunvoxlib_SunVoxLib_get_1pattern_1data( JNIEnv* je, jclass jc, jint slot, jint pat_num )
@@ -1869,29 +2418,23 @@ SUNVOX_EXPORT JNIEXPORT jbyteArray JNICALL Java_nightradio_sunvoxlib_SunVoxLib_g
 }
 SUNVOX_EXPORT JNIEXPORT jint JNICALL Java_nightradio_sunvoxlib_SunVoxLib_set_1pattern_1data( JNIEnv* je, jclass jc, jint slot, jint pat_num, jbyteArray pat_data )
 {
-    if( check_slot( slot ) ) return -1;
-    sunvox_engine* s = g_sv[ slot ];
-    if( !s ) return -1;
-    if( (unsigned)pat_num >= (unsigned)s->pats_num ) return -1;
-    if( !s->pats[ pat_num ] ) return -1;
-    size_t size = s->pats[ pat_num ]->data_xsize * s->pats[ pat_num ]->data_ysize * sizeof( sunvox_note );
+    jint rv = -1;
     size_t data_size = je->GetArrayLength( pat_data );
     jbyte* c_data = je->GetByteArrayElements( pat_data, NULL );
     if( c_data )
     {
-        if( data_size > size ) data_size = size;
-	smem_copy( s->pats[ pat_num ]->data, c_data, data_size );
-        je->ReleaseByteArrayElements( pat_data, c_data, 0 );
-        return 0;
+	rv = sv_set_pattern_data( slot, pat_num, (const sunvox_note*)c_data, data_size );
+        je->ReleaseByteArrayElements( pat_data, c_data, JNI_ABORT );
     }
-    return -1;
+    return rv;
 }
 #endif
 
 SUNVOX_EXPORT int sv_set_pattern_event( int slot, int pat_num, int track, int line, int nn, int vv, int mm, int ccee, int xxyy )
 {
     if( check_slot( slot ) ) return -1;
-    sunvox_pattern* pat = sunvox_get_pattern( pat_num, g_sv[ slot ] );
+    sunvox_engine* s = g_sv[ slot ];
+    sunvox_pattern* pat = sunvox_get_pattern( pat_num, s );
     if( !pat ) return -2;
     if( (unsigned)track >= (unsigned)pat->channels ) return -3;
     if( (unsigned)line >= (unsigned)pat->lines ) return -4;
@@ -1901,6 +2444,7 @@ SUNVOX_EXPORT int sv_set_pattern_event( int slot, int pat_num, int track, int li
     if( mm >= 0 ) p->mod = mm;
     if( ccee >= 0 ) p->ctl = ccee;
     if( xxyy >= 0 ) p->ctl_val = xxyy;
+    sunvox_pattern_evt_changed( pat, line, s );
     return 0;
 }
 #ifdef OS_ANDROID
@@ -1947,6 +2491,7 @@ SUNVOX_EXPORT int sv_pattern_mute( int slot, int pat_num, int mute )
     if( s->pats_info[ pat_num ].flags & SUNVOX_PATTERN_INFO_FLAG_MUTE ) prev_val = 1;
     if( mute == 1 ) s->pats_info[ pat_num ].flags |= SUNVOX_PATTERN_INFO_FLAG_MUTE;
     if( mute == 0 ) s->pats_info[ pat_num ].flags &= ~SUNVOX_PATTERN_INFO_FLAG_MUTE;
+    s->pats_changes++;
     return prev_val;
 }
 #ifdef OS_ANDROID
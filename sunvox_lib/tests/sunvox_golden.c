@@ -0,0 +1,893 @@
+//
+// sunvox_golden - golden output regression test for the render path
+//
+// Renders the synthetic projects (bench_projects.h + the projects below) in the fixed random seed mode
+// and compares the output with the stored hashes (golden_<PS_STYPE>.txt; one file per PS_STYPE build).
+// Bit-exact check by default; with the reference renders (-r) the mismatch is measured in dBFS,
+// so that the intentional changes (SIMD, new interpolation, etc.) can be accepted within the tolerance (-e).
+// Each project covers one module type (or one interpolation mode), so a failed project points to the module.
+// The api_* checks (g_golden_checks[]) test the player API with the self-checking scenarios (no golden hash).
+//
+// Usage: sunvox_golden [-g golden_file] [-w (write golden file)] [-r ref_dir] [-e max_error_dBFS]
+//                      [-t seconds] [-f name_filter] [-d resources_dir] [-l (list)]
+//   check:  sunvox_golden
+//   update: sunvox_golden -w
+//   tolerance check against the old build: old build: sunvox_golden -w -r /tmp/ref; new build: sunvox_golden -r /tmp/ref -e -90
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <unistd.h>
+
+#define SUNVOX_STATIC_LIB
+#include "../headers/sunvox.h"
+#include "../bench/bench_projects.h"
+
+#if defined(PS_STYPE_INT16)
+    #define GOLDEN_STYPE "PS_STYPE_INT16"
+#else
+    #define GOLDEN_STYPE "PS_STYPE_FLOAT32"
+#endif
+
+#define GOLDEN_SEED 12345
+#define GOLDEN_BUF 1000 //not a power of 2: the render quantum splitting is tested too
+#define GOLDEN_MAX_PROJECTS 128
+#define GOLDEN_NAME_LEN 64
+
+static const char* g_res_dir = "../resources";
+
+//Controller module: Analog generator -> Filter -> Output; module -> Filter (OUT controller = Filter freq);
+//par = OUT controller number of the module; tracks 0..3: notes for the generator; tracks 4..7: notes for the module
+static int golden_build_ctl( int slot, const char* mod_type, int par )
+{
+    sv_lock_slot( slot );
+    int src = sv_new_module( slot, "Analog generator", "src", 128, 0, 0 );
+    int flt = sv_new_module( slot, "Filter", "flt", 256, 0, 0 );
+    int mod = sv_new_module( slot, mod_type, mod_type, 256, 128, 0 );
+    if( src < 0 || flt < 0 || mod < 0 ) { sv_unlock_slot( slot ); return -1; }
+    sv_connect_module( slot, src, flt );
+    sv_connect_module( slot, flt, 0 );
+    sv_connect_module( slot, mod, flt );
+    if( strcmp( mod_type, "Sound2Ctl" ) == 0 ) sv_connect_module( slot, src, mod );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 8, 64, 0, "notes" );
+    sv_unlock_slot( slot );
+    if( par >= 0 ) sv_set_module_ctl_value( slot, mod, par, 2, 0 ); //Filter ctl 1 (freq)
+    bench_fill_notes( slot, pat, 4, 64, 4, src );
+    for( int l = 0; l < 64; l += 2 )
+    {
+        int t = 4 + ( ( l / 2 ) & 3 );
+        if( strcmp( mod_type, "MultiCtl" ) == 0 )
+            sv_set_pattern_event( slot, pat, t, l, 0, 0, mod + 1, 0x0100, ( l * 512 ) & 0x7FFF ); //Value
+        else
+            sv_set_pattern_event( slot, pat, t, l, 30 + l, 1 + ( l * 4 ) % 128, mod + 1, 0, 0 );
+    }
+    return 0;
+}
+
+//Note processor: module -> Analog generator -> Output; notes for the module;
+//par = 1: Ctl2Note (State = on; Pitch controller sweep instead of the notes)
+static int golden_build_note_fx( int slot, const char* mod_type, int par )
+{
+    sv_lock_slot( slot );
+    int gen = sv_new_module( slot, "Analog generator", "gen", 256, 0, 0 );
+    int mod = sv_new_module( slot, mod_type, mod_type, 128, 0, 0 );
+    if( gen < 0 || mod < 0 ) { sv_unlock_slot( slot ); return -1; }
+    sv_connect_module( slot, mod, gen );
+    sv_connect_module( slot, gen, 0 );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 8, 64, 0, "notes" );
+    sv_unlock_slot( slot );
+    if( par )
+    {
+        sv_set_module_ctl_value( slot, mod, 6, 1, 0 ); //State = on
+        for( int l = 0; l < 64; l++ )
+            sv_set_pattern_event( slot, pat, 0, l, 0, 0, mod + 1, 0x0100, ( ( l * 1237 ) & 0x7FFF ) ); //Pitch
+    }
+    else
+    {
+        bench_fill_notes( slot, pat, 8, 64, 8, mod );
+    }
+    return 0;
+}
+
+//Sampler interpolation; par = interpolation type (0 - off; 1 - linear; 2 - spline)
+static int golden_build_sampler_interp( int slot, const char* mod_type, int par )
+{
+    if( bench_build_sampler_poly( slot, mod_type, 8 ) ) return -1;
+    int mod = sv_find_module( slot, "sampler" );
+    if( mod < 0 ) return -1;
+    sv_set_module_ctl_value( slot, mod, 2, par, 0 );
+    return 0;
+}
+
+//Vorbis player (resources/drums.ogg) interpolation; par = interpolation (0 - off; 1 - on)
+static int golden_build_vplayer( int slot, const char* mod_type, int par )
+{
+    char path[ 1024 ];
+    snprintf( path, sizeof( path ), "%s/drums.ogg", g_res_dir );
+    sv_lock_slot( slot );
+    int mod = sv_new_module( slot, "Vorbis player", "vplayer", 256, 0, 0 );
+    if( mod < 0 ) { sv_unlock_slot( slot ); return -1; }
+    sv_connect_module( slot, mod, 0 );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 4, 64, 0, "notes" );
+    sv_unlock_slot( slot );
+    if( sv_vplayer_load( slot, mod, path ) ) return -1;
+    sv_set_module_ctl_value( slot, mod, 1, 0, 0 ); //Original speed = off: the pitch depends on the note
+    sv_set_module_ctl_value( slot, mod, 4, par, 0 );
+    bench_fill_notes( slot, pat, 4, 64, 16, mod );
+    return 0;
+}
+
+//Feedback loop: Analog generator -> Delay -> Output; Delay -> Feedback -> Delay
+static int golden_build_feedback( int slot, const char* mod_type, int par )
+{
+    sv_lock_slot( slot );
+    int src = sv_new_module( slot, "Analog generator", "src", 128, 0, 0 );
+    int dly = sv_new_module( slot, "Delay", "dly", 256, 0, 0 );
+    int mod = sv_new_module( slot, mod_type, mod_type, 256, 128, 0 );
+    if( src < 0 || dly < 0 || mod < 0 ) { sv_unlock_slot( slot ); return -1; }
+    sv_connect_module( slot, src, dly );
+    sv_connect_module( slot, dly, 0 );
+    sv_connect_module( slot, dly, mod );
+    sv_connect_module( slot, mod, dly );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 4, 64, 0, "notes" );
+    sv_unlock_slot( slot );
+    bench_fill_notes( slot, pat, 4, 64, 16, src );
+    return 0;
+}
+
+//The effects in bench_projects.h are created with the default controller values (often a clean pass-through);
+//set all the controllers (except the volume) to some fixed non-default values:
+static void golden_tweak_ctls( int slot, const char* mod_name )
+{
+    int mod = sv_find_module( slot, mod_name );
+    if( mod < 0 ) return;
+    int ctls = sv_get_number_of_module_ctls( slot, mod );
+    for( int c = 1; c < ctls; c++ )
+        sv_set_module_ctl_value( slot, mod, c, ( c * 0x2F13 + 0x1000 ) & 0x7FFF, 1 );
+}
+
+//Effect with the non-default controller values
+static int golden_build_effect( int slot, const char* mod_type, int par )
+{
+    if( bench_build_effect( slot, mod_type, par ) ) return -1;
+    golden_tweak_ctls( slot, mod_type );
+    return 0;
+}
+
+static const bench_project g_golden_projects[] =
+{
+    { "gen_adsr", bench_build_generator, "ADSR", 0 },
+    { "fx_lfo", golden_build_effect, "LFO", 0 },
+    { "fx_smooth", golden_build_effect, "Smooth", 0 },
+    { "fx_feedback", golden_build_feedback, "Feedback", 0 },
+    { "fx_fft", bench_build_effect, "FFT", 0 }, //default controllers (the tweaked ones make silence)
+    { "ctl_pitch2ctl", golden_build_ctl, "Pitch2Ctl", 6 },
+    { "ctl_velocity2ctl", golden_build_ctl, "Velocity2Ctl", 4 },
+    { "ctl_sound2ctl", golden_build_ctl, "Sound2Ctl", 8 },
+    { "ctl_multictl", golden_build_ctl, "MultiCtl", -1 },
+    { "note_multisynth", golden_build_note_fx, "MultiSynth", 0 },
+    { "note_glide", golden_build_note_fx, "Glide", 0 },
+    { "note_ctl2note", golden_build_note_fx, "Ctl2Note", 1 },
+    { "sampler_interp0", golden_build_sampler_interp, NULL, 0 },
+    { "sampler_interp1", golden_build_sampler_interp, NULL, 1 },
+    { "sampler_interp2", golden_build_sampler_interp, NULL, 2 },
+    { "vplayer_interp0", golden_build_vplayer, NULL, 0 },
+    { "vplayer_interp1", golden_build_vplayer, NULL, 1 },
+};
+#define GOLDEN_PROJECTS_NUM ( (int)( sizeof( g_golden_projects ) / sizeof( bench_project ) ) )
+
+static const bench_project* golden_get_project( int n )
+{
+    if( n < BENCH_PROJECTS_NUM ) return &g_bench_projects[ n ];
+    return &g_golden_projects[ n - BENCH_PROJECTS_NUM ];
+}
+
+//API checks: deterministic self-checks of the player API (no golden hash); retval: NULL (ok) or the error description
+
+//Render n frames in the slot; retval: sum of the absolute sample values
+static double golden_play( int slot, int frames )
+{
+    float buf[ GOLDEN_BUF * 2 ];
+    double sum = 0;
+    for( int p = 0; p < frames; p += GOLDEN_BUF )
+    {
+        int n = frames - p;
+        if( n > GOLDEN_BUF ) n = GOLDEN_BUF;
+        sv_audio_callback( buf, n, 0, 0 );
+        for( int i = 0; i < n * 2; i++ ) sum += fabs( buf[ i ] );
+    }
+    return sum;
+}
+
+//Pattern resized after sorting: it must be found when the player jumps (same path as the restart_pos loop)
+static const char* golden_check_pattern_resize( int slot )
+{
+    sv_lock_slot( slot );
+    int gen = sv_new_module( slot, "Generator", "gen", 128, 0, 0 );
+    sv_connect_module( slot, gen, 0 );
+    int pat_long = sv_new_pattern( slot, -1, 0, 0, 1, 64, 0, "long" );
+    int pat = sv_new_pattern( slot, -1, 0, 32, 1, 16, 0, "short" );
+    sv_unlock_slot( slot );
+    sv_set_autostop( slot, 0 );
+    sv_play_from_beginning( slot ); //patterns are sorted here
+    golden_play( slot, GOLDEN_BUF );
+    sv_lock_slot( slot );
+    sv_set_pattern_size( slot, pat, -1, 64 );
+    sv_set_pattern_event( slot, pat, 0, 24, 60, 129, gen + 1, 0, 0 );
+    sv_set_pattern_event( slot, pat_long, 0, 8, 0, 0, 0, 0x0031, 20 ); //jump to line 20
+    sv_unlock_slot( slot );
+    double sum = golden_play( slot, BENCH_SR * 2 );
+    sv_stop( slot );
+    if( sum == 0 ) return "the resized pattern is skipped after the jump";
+    return NULL;
+}
+
+//Seek with chase: tempo and controller events before the new position; initial state before the first event
+static const char* golden_check_chase( int slot )
+{
+    sv_lock_slot( slot );
+    int gen = sv_new_module( slot, "Generator", "gen", 128, 0, 0 );
+    sv_connect_module( slot, gen, 0 );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 2, 64, 0, "chase" );
+    sv_set_pattern_event( slot, pat, 0, 16, 0, 0, 0, 0x000F, 200 ); //BPM 200
+    sv_set_pattern_event( slot, pat, 1, 16, 0, 0, gen + 1, 0x0100, 0x2000 ); //volume 64
+    sv_unlock_slot( slot );
+    int bpm = sv_get_song_bpm( slot );
+    int vol = sv_get_module_ctl_value( slot, gen, 0, 0 );
+    sv_rewind_chase( slot, 1 );
+    sv_set_autostop( slot, 0 );
+    sv_play_from_beginning( slot );
+    golden_play( slot, BENCH_SR * 2 ); //after line 16
+    if( sv_get_song_bpm( slot ) != 200 || sv_get_module_ctl_value( slot, gen, 0, 0 ) != 64 ) return "the events are not played";
+    sv_rewind( slot, 0 );
+    golden_play( slot, GOLDEN_BUF );
+    if( sv_get_song_bpm( slot ) != bpm ) return "the tempo is not restored by the chase to line 0";
+    if( sv_get_module_ctl_value( slot, gen, 0, 0 ) != vol ) return "the controller is not restored by the chase to line 0";
+    sv_stop( slot );
+    sv_rewind( slot, 32 );
+    sv_play( slot );
+    golden_play( slot, GOLDEN_BUF );
+    if( sv_get_song_bpm( slot ) != 200 ) return "the tempo is not chased to line 32";
+    if( sv_get_module_ctl_value( slot, gen, 0, 0 ) != 64 ) return "the controller is not chased to line 32";
+    sv_stop( slot );
+    return NULL;
+}
+
+//Time map and song length after a tempo effect: they must match the playback
+static const char* golden_check_time_map( int slot )
+{
+    sv_lock_slot( slot );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 1, 64, 0, "tempo" );
+    sv_set_pattern_event( slot, pat, 0, 32, 0, 0, 0, 0x000F, 250 ); //BPM 250
+    sv_unlock_slot( slot );
+    for( int pass = 0; pass < 2; pass++ )
+    {
+        //pass 0: initial tempo; pass 1: the tempo has been changed by the effect
+        uint32_t len = sv_get_song_length_frames( slot );
+        if( sv_line_to_frame( slot, sv_get_song_length_lines( slot ) ) != len ) return "sv_line_to_frame() != sv_get_song_length_frames()";
+        if( sv_frame_to_line( slot, len - 1 ) != 63 ) return "sv_frame_to_line() != last line";
+        uint32_t map[ 64 ];
+        sv_get_time_map( slot, 0, 1, map, SV_TIME_MAP_SPEED );
+        if( (int)( map[ 0 ] & 0xFFFF ) != sv_get_song_bpm( slot ) ) return "time map tempo != sv_get_song_bpm()";
+        sv_get_time_map( slot, 0, 64, map, SV_TIME_MAP_FRAMECNT );
+        if( map[ 33 ] != sv_line_to_frame( slot, 33 ) || map[ 63 ] != sv_line_to_frame( slot, 63 ) ) return "time map != sv_line_to_frame()";
+        sv_set_autostop( slot, 1 );
+        sv_play_from_beginning( slot );
+        uint32_t played = 0;
+        while( !sv_end_of_song( slot ) && played < len * 2 )
+        {
+            golden_play( slot, GOLDEN_BUF );
+            played += GOLDEN_BUF;
+        }
+        if( played < len || played > len + GOLDEN_BUF ) return "sv_get_song_length_frames() != playback length";
+    }
+    return NULL;
+}
+
+//Is the file mapped into the process (Linux); retval: -1 - unknown
+static int golden_file_mapped( const char* fname )
+{
+#ifdef __linux__
+    FILE* f = fopen( "/proc/self/maps", "rb" );
+    if( !f ) return -1;
+    char line[ 4096 ];
+    int rv = 0;
+    while( fgets( line, sizeof( line ), f ) ) if( strstr( line, fname ) ) rv = 1;
+    fclose( f );
+    return rv;
+#else
+    return -1;
+#endif
+}
+
+//Sample chunks mapped from the project file (SV_INIT_FLAG_MAP_FILES): the file can be overwritten while mapped; unmapped on close
+static const char* golden_check_map_files( int slot )
+{
+    char fname[ 256 ];
+    snprintf( fname, sizeof( fname ), "/tmp/sunvox_golden_map_%d.sunvox", (int)getpid() );
+    if( bench_build_sampler_poly( slot, "Sampler", 8 ) ) return "can't build the project";
+    if( sv_save( slot, fname ) ) return "can't save the project";
+    if( sv_load( slot, fname ) ) { remove( fname ); return "can't load the project"; }
+    const char* err = NULL;
+    int mapped = golden_file_mapped( fname );
+    sv_play_from_beginning( slot );
+    double sum = golden_play( slot, BENCH_SR );
+    sv_stop( slot );
+    if( mapped == 0 ) err = "the sample is not mapped";
+    else if( sum == 0 ) err = "silence";
+    else
+    {
+        //Rewrite the file in place (truncation): the mapped pages must be copied before that (SIGBUS otherwise)
+        if( sv_save( slot, fname ) ) err = "can't overwrite the project";
+        sv_play_from_beginning( slot );
+        if( golden_play( slot, BENCH_SR ) == 0 ) err = "silence after the file is overwritten";
+        sv_stop( slot );
+        if( !err && sv_load( slot, fname ) ) err = "can't load the overwritten project";
+        sv_play_from_beginning( slot );
+        double sum2 = golden_play( slot, BENCH_SR );
+        sv_stop( slot );
+        if( !err && sum2 != sum ) err = "the overwritten project sounds different";
+    }
+    sv_close_slot( slot );
+    if( !err && golden_file_mapped( fname ) == 1 ) err = "the mapping is not released";
+    sv_open_slot( slot );
+    remove( fname );
+    return err;
+}
+
+//Pattern region write/read (one lock for the block): round trip with the data stride, clipping by the pattern size, sv_set_pattern_data()
+static const char* golden_check_pattern_region( int slot )
+{
+    sv_lock_slot( slot );
+    int gen = sv_new_module( slot, "Generator", "gen", 128, 0, 0 );
+    sv_connect_module( slot, gen, 0 );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 8, 32, 0, "region" );
+    sv_unlock_slot( slot );
+    int xsize = sv_get_pattern_tracks( slot, pat );
+    if( xsize < 8 ) return "sv_get_pattern_tracks() < 8";
+    sunvox_note* expected = (sunvox_note*)calloc( xsize * 32, sizeof( sunvox_note ) );
+    sunvox_note src[ 6 * 4 ]; //4 lines x 5 tracks; 6 events per line
+    sunvox_note dst[ 6 * 4 ];
+    const char* err = NULL;
+    memset( src, 0, sizeof( src ) );
+    for( int l = 0; l < 4; l++ )
+    {
+        for( int t = 0; t < 5; t++ )
+        {
+            sunvox_note* n = &src[ l * 6 + t ];
+            n->note = 40 + l * 5 + t;
+            n->vel = 100 + t;
+            n->module = gen + 1;
+            n->ctl = 0x0100 + t;
+            n->ctl_val = l * 256 + t;
+        }
+    }
+    //Block inside the pattern (tracks 2...6, lines 3...6) and the block clipped by the bottom right corner (tracks 6, 7; lines 30, 31):
+    if( sv_set_pattern_region( slot, pat, 2, 3, 5, 4, src, 6 ) ) err = "sv_set_pattern_region() error";
+    if( !err && sv_set_pattern_region( slot, pat, 6, 30, 5, 4, src, 6 ) ) err = "sv_set_pattern_region() error (clipped block)";
+    for( int l = 0; l < 4; l++ )
+    {
+        for( int t = 0; t < 5; t++ )
+        {
+            expected[ ( 3 + l ) * xsize + 2 + t ] = src[ l * 6 + t ];
+            if( 6 + t < 8 && 30 + l < 32 ) expected[ ( 30 + l ) * xsize + 6 + t ] = src[ l * 6 + t ];
+        }
+    }
+    if( !err )
+    {
+        memset( dst, 0xFF, sizeof( dst ) );
+        if( sv_get_pattern_region( slot, pat, 2, 3, 5, 4, dst, 6 ) ) err = "sv_get_pattern_region() error";
+        for( int l = 0; l < 4 && !err; l++ )
+        {
+            if( memcmp( &dst[ l * 6 ], &src[ l * 6 ], 5 * sizeof( sunvox_note ) ) ) err = "sv_get_pattern_region() != sv_set_pattern_region()";
+            if( dst[ l * 6 + 5 ].note != 0xFF ) err = "sv_get_pattern_region() writes outside the block (data_tracks)";
+        }
+    }
+    if( !err && memcmp( sv_get_pattern_data( slot, pat ), expected, xsize * 32 * sizeof( sunvox_note ) ) ) 
+        err = "pattern data != written blocks (wrong position, stride or clipping)";
+    if( !err )
+    {
+        sv_set_autostop( slot, 0 );
+        sv_play_from_beginning( slot );
+        if( golden_play( slot, BENCH_SR * 2 ) == 0 ) err = "the written events are not played";
+        sv_stop( slot );
+    }
+    //Whole pattern: sv_set_pattern_data() -> sv_get_pattern_region():
+    if( !err )
+    {
+        expected[ 0 ].note = 60;
+        expected[ 0 ].module = gen + 1;
+        expected[ 31 * xsize + 7 ].note = 128;
+        if( sv_set_pattern_data( slot, pat, expected, xsize * 32 * sizeof( sunvox_note ) ) ) err = "sv_set_pattern_data() error";
+    }
+    if( !err )
+    {
+        sunvox_note* all = (sunvox_note*)calloc( xsize * 32, sizeof( sunvox_note ) );
+        if( sv_get_pattern_region( slot, pat, 0, 0, xsize, 32, all, xsize ) ) err = "sv_get_pattern_region() error (whole pattern)";
+        else if( memcmp( all, expected, xsize * 32 * sizeof( sunvox_note ) ) ) err = "sv_get_pattern_region() != sv_set_pattern_data()";
+        free( all );
+    }
+    free( expected );
+    return err;
+}
+
+//Controller block write/read and the snapshot/restore round trip (all controllers of all modules)
+static int golden_get_all_ctls( int slot, int* vals, int max )
+{
+    int n = 0;
+    for( int m = 0; m < sv_get_number_of_modules( slot ); m++ )
+    {
+        if( !( sv_get_module_flags( slot, m ) & SV_MODULE_FLAG_EXISTS ) ) continue;
+        int ctls = sv_get_number_of_module_ctls( slot, m );
+        if( n + ctls > max ) break;
+        if( ctls > 0 && sv_get_module_ctls( slot, m, 0, ctls, vals + n, 0 ) != ctls ) return -1;
+        n += ctls;
+    }
+    return n;
+}
+
+static const char* golden_check_ctls_snapshot( int slot )
+{
+    sv_lock_slot( slot );
+    int gen = sv_new_module( slot, "Generator", "gen", 128, 0, 0 );
+    int flt = sv_new_module( slot, "Filter", "flt", 256, 0, 0 );
+    int flt2 = sv_new_module( slot, "Filter", "flt2", 256, 128, 0 ); //reference: the same values from sv_set_module_ctl_value()
+    sv_connect_module( slot, gen, flt );
+    sv_connect_module( slot, flt, 0 );
+    sv_connect_module( slot, gen, flt2 );
+    sv_connect_module( slot, flt2, 0 );
+    sv_unlock_slot( slot );
+    int ctls = sv_get_number_of_module_ctls( slot, flt );
+    if( ctls < 4 || ctls > 32 ) return "unexpected number of Filter controllers";
+    int vals[ 32 ];
+    int vals2[ 32 ];
+    int all[ 256 ];
+    int all2[ 256 ];
+    const char* err = NULL;
+    sv_set_event_t( slot, 1, 0 ); //the callback time is not the system time here: process the events in the next buffer
+    sv_set_autostop( slot, 0 );
+    sv_play_from_beginning( slot );
+    sv_send_event( slot, 0, 60, 129, gen + 1, 0, 0 );
+    //Block write (real values) -> block read; the conversion must be the same as in sv_set_module_ctl_value():
+    for( int c = 0; c < ctls; c++ )
+    {
+        int min = sv_get_module_ctl_min( slot, flt, c, 0 );
+        int max = sv_get_module_ctl_max( slot, flt, c, 0 );
+        vals[ c ] = min + ( max - min ) / 3;
+        sv_set_module_ctl_value( slot, flt2, c, vals[ c ], 0 );
+    }
+    if( sv_set_module_ctls( slot, flt, 0, ctls, vals, 0 ) ) err = "sv_set_module_ctls() error";
+    golden_play( slot, GOLDEN_BUF );
+    if( !err && sv_get_module_ctls( slot, flt, 0, ctls + 8, vals2, 0 ) != ctls ) err = "sv_get_module_ctls() retval != number of controllers";
+    for( int c = 0; c < ctls && !err; c++ )
+    {
+        if( vals2[ c ] != sv_get_module_ctl_value( slot, flt2, c, 0 ) ) err = "sv_set_module_ctls() != sv_set_module_ctl_value()";
+        if( vals2[ c ] != sv_get_module_ctl_value( slot, flt, c, 0 ) ) err = "sv_get_module_ctls() != sv_get_module_ctl_value()";
+    }
+    if( !err && vals2[ 0 ] != vals[ 0 ] ) err = "sv_set_module_ctls() is not applied";
+    //Snapshot -> other values -> restore:
+    int all_num = golden_get_all_ctls( slot, all, 256 );
+    if( !err && all_num < ctls ) err = "sv_get_module_ctls() error (all modules)";
+    size_t size = 0;
+    void* snap = NULL;
+    if( !err )
+    {
+        snap = sv_ctls_snapshot( slot, &size );
+        if( !snap || size == 0 ) err = "sv_ctls_snapshot() error";
+    }
+    if( !err )
+    {
+        for( int c = 0; c < ctls; c++ ) vals2[ c ] = sv_get_module_ctl_max( slot, flt, c, 0 ) - ( vals[ c ] - sv_get_module_ctl_min( slot, flt, c, 0 ) ) / 2;
+        sv_set_module_ctls( slot, flt, 0, ctls, vals2, 0 );
+        sv_set_module_ctls( slot, gen, 0, 1, vals2, 0 );
+        golden_play( slot, GOLDEN_BUF );
+        if( golden_get_all_ctls( slot, all2, 256 ) != all_num || memcmp( all, all2, all_num * sizeof( int ) ) == 0 ) err = "the controllers are not changed";
+    }
+    if( !err )
+    {
+        char bad[ 16 ];
+        memset( bad, 0, sizeof( bad ) );
+        if( sv_ctls_restore( slot, bad, sizeof( bad ) ) == 0 ) err = "sv_ctls_restore() accepts the invalid data";
+        else if( sv_ctls_restore( slot, snap, size / 2 ) == 0 ) err = "sv_ctls_restore() accepts the truncated data";
+    }
+    if( !err )
+    {
+        if( sv_ctls_restore( slot, snap, size ) ) err = "sv_ctls_restore() error";
+        golden_play( slot, GOLDEN_BUF );
+        if( !err && ( golden_get_all_ctls( slot, all2, 256 ) != all_num || memcmp( all, all2, all_num * sizeof( int ) ) ) ) err = "the restored controllers != snapshot";
+        if( !err && golden_play( slot, GOLDEN_BUF ) == 0 ) err = "silence after sv_ctls_restore()";
+    }
+    sv_stop( slot );
+    sv_set_event_t( slot, 0, 0 );
+    free( snap );
+    return err;
+}
+
+//Stems of the modules connected to the Output: their sum (link volumes and the Output volume = 100%) must be the master output
+static const char* golden_check_stems( int slot )
+{
+    sv_lock_slot( slot );
+    int gen = sv_new_module( slot, "Generator", "gen", 128, 0, 0 );
+    int gen2 = sv_new_module( slot, "Generator", "gen2", 128, 128, 0 );
+    sv_connect_module( slot, gen, 0 );
+    sv_connect_module( slot, gen2, 0 );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 2, 32, 0, "stems" );
+    sv_set_pattern_event( slot, pat, 0, 0, 60, 129, gen + 1, 0, 0 );
+    sv_set_pattern_event( slot, pat, 1, 4, 67, 129, gen2 + 1, 0, 0 );
+    sv_unlock_slot( slot );
+    int* inputs = sv_get_module_inputs( slot, 0 );
+    int inputs_num = ( sv_get_module_flags( slot, 0 ) & SV_MODULE_INPUTS_MASK ) >> SV_MODULE_INPUTS_OFF;
+    int mods[ 3 ] = { -1, -1, 0 };
+    int mods_num = 0;
+    for( int i = 0; i < inputs_num && inputs; i++ )
+        if( inputs[ i ] >= 0 && mods_num < 2 ) mods[ mods_num++ ] = inputs[ i ];
+    if( mods_num != 2 ) return "sv_get_module_inputs( slot, 0 ) != the modules connected to the Output";
+    mods[ mods_num++ ] = 0; //master
+    int frames = BENCH_SR; //several internal pieces (1024 frames)
+    float* master = (float*)calloc( frames * 2, sizeof( float ) );
+    float* stems = (float*)calloc( frames * 2 * 3, sizeof( float ) );
+    void* stem_bufs[ 3 ] = { stems, stems + frames * 2, stems + frames * 4 };
+    const char* err = NULL;
+    sv_volume( slot, 256 );
+    sv_set_autostop( slot, 0 );
+    sv_play_from_beginning( slot );
+    for( int p = 0; p < frames && !err; p += GOLDEN_BUF ) //the long project is rendered in pieces
+    {
+        int n = frames - p;
+        if( n > GOLDEN_BUF ) n = GOLDEN_BUF;
+        void* bufs[ 3 ];
+        for( int i = 0; i < 3; i++ ) bufs[ i ] = (float*)stem_bufs[ i ] + p * 2;
+        if( sv_render_stems( slot, n, mods, mods_num, master + p * 2, bufs ) ) err = "sv_render_stems() error";
+    }
+    sv_stop( slot );
+    double sum[ 3 ] = { 0, 0, 0 };
+    double diff = 0;
+    double master_sum = 0;
+    for( int i = 0; i < frames * 2 && !err; i++ )
+    {
+        float* s0 = (float*)stem_bufs[ 0 ];
+        float* s1 = (float*)stem_bufs[ 1 ];
+        float* s2 = (float*)stem_bufs[ 2 ];
+        sum[ 0 ] += fabs( s0[ i ] );
+        sum[ 1 ] += fabs( s1[ i ] );
+        sum[ 2 ] += fabs( s2[ i ] - master[ i ] );
+        master_sum += fabs( master[ i ] );
+        double d = fabs( s0[ i ] + s1[ i ] - master[ i ] );
+        if( d > diff ) diff = d;
+    }
+    if( !err && ( sum[ 0 ] == 0 || sum[ 1 ] == 0 ) ) err = "silent stem";
+    if( !err && master_sum == 0 ) err = "silent master output";
+    if( !err && sum[ 2 ] != 0 ) err = "Output stem (module 0) != master output";
+    if( !err && memcmp( stem_bufs[ 0 ], stem_bufs[ 1 ], frames * 2 * sizeof( float ) ) == 0 ) err = "the stems are the same";
+    if( !err && diff > 0.00003 ) err = "sum of the stems != master output"; //-90 dBFS
+    int bad_mods[ 2 ] = { gen, gen };
+    if( !err && sv_render_stems( slot, 16, bad_mods, 2, NULL, stem_bufs ) == 0 ) err = "sv_render_stems() accepts the duplicate modules";
+    free( master );
+    free( stems );
+    return err;
+}
+
+//Planar output of the slot (sv_audio_callback_planar()) must be the same as the interleaved output (sv_audio_callback())
+static void golden_build_planar( int slot )
+{
+    sv_lock_slot( slot );
+    int gen = sv_new_module( slot, "Generator", "gen", 128, 0, 0 );
+    int flt = sv_new_module( slot, "Filter", "flt", 256, 0, 0 );
+    sv_connect_module( slot, gen, flt );
+    sv_connect_module( slot, flt, 0 );
+    int pat = sv_new_pattern( slot, -1, 0, 0, 3, 32, 0, "planar" );
+    sv_set_pattern_event( slot, pat, 2, 0, 0, 0, gen + 1, 0x0700, 0 ); //stereo mode
+    sv_set_pattern_event( slot, pat, 0, 0, 60, 129, gen + 1, 0x0300, 0x1000 ); //panning: the channels are different
+    sv_set_pattern_event( slot, pat, 1, 4, 67, 129, gen + 1, 0, 0 );
+    sv_set_pattern_event( slot, pat, 0, 8, 0, 0, flt + 1, 0x0200, 0x1000 ); //filter freq
+    sv_unlock_slot( slot );
+    sv_set_autostop( slot, 0 );
+}
+
+static const char* golden_check_planar( int slot )
+{
+    int frames = BENCH_SR;
+    float* inter = (float*)calloc( frames * 2, sizeof( float ) );
+    float* planar = (float*)calloc( frames * 2, sizeof( float ) );
+    const char* err = NULL;
+    golden_build_planar( slot );
+    sv_play_from_beginning( slot );
+    for( int p = 0; p < frames; p += GOLDEN_BUF )
+    {
+        int n = frames - p;
+        if( n > GOLDEN_BUF ) n = GOLDEN_BUF;
+        sv_audio_callback( inter + p * 2, n, 0, 0 );
+    }
+    //Same project in the new slot (the same initial state), rendered to the planar buffers:
+    sv_close_slot( slot );
+    sv_open_slot( slot );
+    golden_build_planar( slot );
+    sv_play_from_beginning( slot );
+    int filled = 0;
+    for( int p = 0; p < frames && !err; p += GOLDEN_BUF )
+    {
+        int n = frames - p;
+        if( n > GOLDEN_BUF ) n = GOLDEN_BUF;
+        float* bufs[ 2 ] = { planar + p, planar + frames + p };
+        int rv = sv_audio_callback_planar( slot, bufs, 2, n, 0, 0 );
+        if( rv < 0 ) err = "sv_audio_callback_planar() error";
+        filled += rv;
+    }
+    if( !err && filled == 0 ) err = "sv_audio_callback_planar() retval: silence";
+    double sum = 0;
+    double sum_lr = 0;
+    double diff = 0;
+    for( int i = 0; i < frames && !err; i++ )
+    {
+        for( int ch = 0; ch < 2; ch++ )
+        {
+            double d = fabs( inter[ i * 2 + ch ] - planar[ ch * frames + i ] );
+            if( d > diff ) diff = d;
+            sum += fabs( planar[ ch * frames + i ] );
+        }
+        sum_lr += fabs( planar[ i ] - planar[ frames + i ] );
+    }
+    if( !err && sum == 0 ) err = "silent planar output";
+    if( !err && sum_lr == 0 ) err = "planar output: the channels are the same";
+    if( !err && diff > 0.00003 ) err = "planar output != interleaved output"; //-90 dBFS
+    sv_stop( slot );
+    free( inter );
+    free( planar );
+    return err;
+}
+
+typedef struct
+{
+    const char* name;
+    const char* (*check)( int slot );
+} golden_api_check;
+
+static const golden_api_check g_golden_checks[] =
+{
+    { "api_pattern_resize", golden_check_pattern_resize },
+    { "api_chase", golden_check_chase },
+    { "api_time_map", golden_check_time_map },
+    { "api_map_files", golden_check_map_files },
+    { "api_pattern_region", golden_check_pattern_region },
+    { "api_ctls_snapshot", golden_check_ctls_snapshot },
+    { "api_stems", golden_check_stems },
+    { "api_planar", golden_check_planar },
+};
+#define GOLDEN_CHECKS_NUM ( (int)( sizeof( g_golden_checks ) / sizeof( golden_api_check ) ) )
+
+//Golden file: one line per project: name hash
+static char g_golden_names[ GOLDEN_MAX_PROJECTS ][ GOLDEN_NAME_LEN ];
+static uint64_t g_golden_hashes[ GOLDEN_MAX_PROJECTS ];
+static int g_golden_num = 0;
+
+static int golden_load( const char* fname )
+{
+    FILE* f = fopen( fname, "rb" );
+    if( !f ) return -1;
+    char line[ 256 ];
+    while( fgets( line, sizeof( line ), f ) && g_golden_num < GOLDEN_MAX_PROJECTS )
+    {
+        if( line[ 0 ] == '#' ) continue;
+        char name[ GOLDEN_NAME_LEN ];
+        unsigned long long h;
+        if( sscanf( line, "%63s %llx", name, &h ) != 2 ) continue;
+        strcpy( g_golden_names[ g_golden_num ], name );
+        g_golden_hashes[ g_golden_num ] = h;
+        g_golden_num++;
+    }
+    fclose( f );
+    return 0;
+}
+
+static int golden_find( const char* name )
+{
+    for( int i = 0; i < g_golden_num; i++ )
+        if( strcmp( g_golden_names[ i ], name ) == 0 ) return i;
+    return -1;
+}
+
+static double golden_db( double v )
+{
+    if( v <= 1e-15 ) return -300;
+    return 20 * log10( v );
+}
+
+//Render the project in the slot; retval: number of frames; *out = float stereo output (free() it)
+static int golden_render( int slot, int seconds, float** out, uint64_t* hash, double* rms )
+{
+    int frames = BENCH_SR * seconds;
+    float* buf = (float*)malloc( frames * 2 * sizeof( float ) );
+    if( !buf ) return -1;
+    sv_set_autostop( slot, 0 );
+    sv_play_from_beginning( slot );
+    for( int p = 0; p < frames; p += GOLDEN_BUF )
+    {
+        int n = frames - p;
+        if( n > GOLDEN_BUF ) n = GOLDEN_BUF;
+        sv_audio_callback( buf + p * 2, n, 0, 0 );
+    }
+    sv_stop( slot );
+    uint64_t h = 14695981039346656037ULL; //FNV-1a
+    const unsigned char* b = (const unsigned char*)buf;
+    for( size_t i = 0; i < (size_t)frames * 2 * sizeof( float ); i++ ) { h ^= b[ i ]; h *= 1099511628211ULL; }
+    double sum = 0;
+    for( int i = 0; i < frames * 2; i++ ) sum += (double)buf[ i ] * buf[ i ];
+    *hash = h;
+    *rms = sqrt( sum / ( frames * 2 ) );
+    *out = buf;
+    return frames;
+}
+
+int main( int argc, char* argv[] )
+{
+    const char* golden_file = "../tests/golden_" GOLDEN_STYPE ".txt";
+    const char* ref_dir = NULL;
+    const char* filter = NULL;
+    double max_err = -90; //dBFS
+    int seconds = 4;
+    int write = 0;
+    int list = 0;
+    for( int i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[ i ], "-g" ) == 0 && i + 1 < argc ) golden_file = argv[ ++i ];
+        else if( strcmp( argv[ i ], "-r" ) == 0 && i + 1 < argc ) ref_dir = argv[ ++i ];
+        else if( strcmp( argv[ i ], "-e" ) == 0 && i + 1 < argc ) max_err = atof( argv[ ++i ] );
+        else if( strcmp( argv[ i ], "-t" ) == 0 && i + 1 < argc ) seconds = atoi( argv[ ++i ] );
+        else if( strcmp( argv[ i ], "-f" ) == 0 && i + 1 < argc ) filter = argv[ ++i ];
+        else if( strcmp( argv[ i ], "-d" ) == 0 && i + 1 < argc ) g_res_dir = argv[ ++i ];
+        else if( strcmp( argv[ i ], "-w" ) == 0 ) write = 1;
+        else if( strcmp( argv[ i ], "-l" ) == 0 ) list = 1;
+        else
+        {
+            fprintf( stderr, "Usage: %s [-g golden_file] [-w] [-r ref_dir] [-e max_error_dBFS] [-t seconds] [-f name_filter] [-d resources_dir] [-l]\n", argv[ 0 ] );
+            return 1;
+        }
+    }
+    int projects_num = BENCH_PROJECTS_NUM + GOLDEN_PROJECTS_NUM;
+    if( list )
+    {
+        for( int i = 0; i < projects_num; i++ ) printf( "%s\n", golden_get_project( i )->name );
+        for( int i = 0; i < GOLDEN_CHECKS_NUM; i++ ) printf( "%s\n", g_golden_checks[ i ].name );
+        return 0;
+    }
+    if( seconds < 1 ) seconds = 1;
+    if( !write && golden_load( golden_file ) )
+    {
+        fprintf( stderr, "Can't open %s (use -w to create it)\n", golden_file );
+        return 1;
+    }
+    FILE* gf = NULL;
+    if( write )
+    {
+        gf = fopen( golden_file, "wb" );
+        if( !gf )
+        {
+            fprintf( stderr, "Can't create %s\n", golden_file );
+            return 1;
+        }
+        fprintf( gf, "# sunvox_golden: %s; seed %d; %d Hz; %d s; buffer %d\n", GOLDEN_STYPE, GOLDEN_SEED, BENCH_SR, seconds, GOLDEN_BUF );
+    }
+
+    char config[ 64 ];
+    snprintf( config, sizeof( config ), "seed=%d", GOLDEN_SEED );
+    int flags = SV_INIT_FLAG_USER_AUDIO_CALLBACK | SV_INIT_FLAG_AUDIO_FLOAT32 | SV_INIT_FLAG_ONE_THREAD | SV_INIT_FLAG_NO_DEBUG_OUTPUT | SV_INIT_FLAG_MAP_FILES;
+    if( sv_init( config, BENCH_SR, 2, flags ) < 0 )
+    {
+        fprintf( stderr, "sv_init() error\n" );
+        if( gf ) fclose( gf );
+        return 1;
+    }
+    int failed = 0;
+    int checked = 0;
+    for( int i = 0; i < projects_num; i++ )
+    {
+        const bench_project* p = golden_get_project( i );
+        if( filter && !strstr( p->name, filter ) ) continue;
+        const char* mod_type = p->mod_type ? p->mod_type : "-";
+        sv_open_slot( 0 );
+        float* out = NULL;
+        uint64_t hash = 0;
+        double rms = 0;
+        int frames = -1;
+        if( p->build( 0, p->mod_type, p->par ) == 0 )
+        {
+            if( i < BENCH_PROJECTS_NUM && p->build == bench_build_effect ) golden_tweak_ctls( 0, p->mod_type );
+            frames = golden_render( 0, seconds, &out, &hash, &rms );
+        }
+        sv_close_slot( 0 );
+        if( frames < 0 )
+        {
+            printf( "FAIL  %-24s %-16s can't build the project\n", p->name, mod_type );
+            failed++;
+            continue;
+        }
+        checked++;
+        char ref_name[ 1024 ];
+        if( ref_dir ) snprintf( ref_name, sizeof( ref_name ), "%s/%s.f32", ref_dir, p->name );
+        if( write )
+        {
+            fprintf( gf, "%s %016llx\n", p->name, (unsigned long long)hash );
+            if( ref_dir )
+            {
+                FILE* f = fopen( ref_name, "wb" );
+                if( f ) { fwrite( out, sizeof( float ), frames * 2, f ); fclose( f ); }
+                else fprintf( stderr, "Can't create %s\n", ref_name );
+            }
+            printf( "WRITE %-24s %-16s %016llx; rms %.1f dBFS%s\n", p->name, mod_type, (unsigned long long)hash, golden_db( rms ), rms > 0 ? "" : " (silence!)" );
+        }
+        else
+        {
+            int g = golden_find( p->name );
+            int exact = g >= 0 && g_golden_hashes[ g ] == hash;
+            //Measure the difference with the reference render:
+            double err = 0;
+            double ref_rms = 0;
+            int ref_ok = 0;
+            if( ref_dir && !exact )
+            {
+                FILE* f = fopen( ref_name, "rb" );
+                if( f )
+                {
+                    float* ref = (float*)malloc( frames * 2 * sizeof( float ) );
+                    if( ref && fread( ref, sizeof( float ), frames * 2, f ) == (size_t)frames * 2 )
+                    {
+                        for( int s = 0; s < frames * 2; s++ )
+                        {
+                            double d = fabs( (double)out[ s ] - ref[ s ] );
+                            if( d > err ) err = d;
+                            ref_rms += (double)ref[ s ] * ref[ s ];
+                        }
+                        ref_rms = sqrt( ref_rms / ( frames * 2 ) );
+                        ref_ok = 1;
+                    }
+                    free( ref );
+                    fclose( f );
+                }
+            }
+            if( exact )
+                printf( "OK    %-24s %-16s %016llx\n", p->name, mod_type, (unsigned long long)hash );
+            else if( ref_ok && golden_db( err ) <= max_err )
+                printf( "OK~   %-24s %-16s %016llx; max error %.1f dBFS (limit %.1f)\n", p->name, mod_type, (unsigned long long)hash, golden_db( err ), max_err );
+            else
+            {
+                failed++;
+                if( g < 0 )
+                    printf( "FAIL  %-24s %-16s %016llx; no golden hash\n", p->name, mod_type, (unsigned long long)hash );
+                else if( ref_ok )
+                    printf( "FAIL  %-24s %-16s %016llx != %016llx; max error %.1f dBFS (limit %.1f); reference rms %.1f dBFS\n",
+                        p->name, mod_type, (unsigned long long)hash, (unsigned long long)g_golden_hashes[ g ], golden_db( err ), max_err, golden_db( ref_rms ) );
+                else
+                    printf( "FAIL  %-24s %-16s %016llx != %016llx\n", p->name, mod_type, (unsigned long long)hash, (unsigned long long)g_golden_hashes[ g ] );
+            }
+        }
+        fflush( stdout );
+        free( out );
+    }
+    if( !write )
+    {
+        for( int i = 0; i < GOLDEN_CHECKS_NUM; i++ )
+        {
+            const golden_api_check* c = &g_golden_checks[ i ];
+            if( filter && !strstr( c->name, filter ) ) continue;
+            sv_open_slot( 0 );
+            const char* err = c->check( 0 );
+            sv_close_slot( 0 );
+            checked++;
+            if( err )
+            {
+                printf( "FAIL  %-24s %-16s %s\n", c->name, "-", err );
+                failed++;
+            }
+            else
+                printf( "OK    %-24s %-16s\n", c->name, "-" );
+            fflush( stdout );
+        }
+    }
+    sv_deinit();
+    if( gf ) fclose( gf );
+    if( !write ) printf( "%d of %d projects failed (%s)\n", failed, checked, GOLDEN_STYPE );
+    return failed ? 1 : 0;
+}